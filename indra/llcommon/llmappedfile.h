@@ -0,0 +1,61 @@
+/**
+ * @file llmappedfile.h
+ * @brief Read only memory mapping of a whole file.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLMAPPEDFILE_H
+#define LL_LLMAPPEDFILE_H
+
+#include <string>
+
+// Maps a whole file read only, so a cache can be read in place without
+// copying it into a buffer first. Pages are only loaded by the OS when
+// they are touched.
+class LL_COMMON_API LLMappedFile
+{
+public:
+    LLMappedFile();
+    ~LLMappedFile();
+
+    LLMappedFile(const LLMappedFile&) = delete;
+    LLMappedFile& operator=(const LLMappedFile&) = delete;
+
+    // Fails for missing and empty files. On Windows the file cannot be
+    // replaced while it is mapped, so keep mappings short lived.
+    bool open(const std::string& filename);
+    void close();
+
+    bool isOpen() const     { return mData != nullptr; }
+    const U8* getData() const   { return mData; }
+    size_t getSize() const      { return mSize; }
+
+private:
+    const U8* mData;
+    size_t mSize;
+#if LL_WINDOWS
+    void* mMapping;
+#endif
+};
+
+#endif // LL_LLMAPPEDFILE_H
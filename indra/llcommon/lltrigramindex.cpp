@@ -0,0 +1,209 @@
+/**
+ * @file lltrigramindex.cpp
+ * @brief Substring search over many short texts through their trigrams.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "lltrigramindex.h"
+
+#include <algorithm>
+
+namespace
+{
+    // Dead texts are only compacted away past this many, and once they
+    // outnumber the live ones.
+    const size_t MIN_DEAD_TEXTS_TO_COMPACT = 1024;
+
+    // The distinct trigrams of text, sorted
+    void get_trigrams(const std::string& text, std::vector<U32>& trigrams)
+    {
+        trigrams.clear();
+        if (text.size() < LLTrigramIndex::MIN_QUERY_LENGTH)
+        {
+            return;
+        }
+        trigrams.reserve(text.size() - 2);
+        U32 trigram = ((U32)(U8)text[0] << 8) | (U32)(U8)text[1];
+        for (size_t i = 2; i < text.size(); ++i)
+        {
+            trigram = ((trigram << 8) | (U32)(U8)text[i]) & 0xffffff;
+            trigrams.push_back(trigram);
+        }
+        std::sort(trigrams.begin(), trigrams.end());
+        trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+    }
+}
+
+LLTrigramIndex::LLTrigramIndex()
+:   mDeadTexts(0)
+{
+}
+
+void LLTrigramIndex::set(const LLUUID& id, const std::string& text)
+{
+    auto found = mTextNumbers.find(id);
+    if (found != mTextNumbers.end())
+    {
+        Text& old_text = mTexts[found->second];
+        if (old_text.mText == text)
+        {
+            return;
+        }
+        old_text.mLive = false;
+        old_text.mText.clear();
+        ++mDeadTexts;
+    }
+
+    const U32 number = (U32)mTexts.size();
+    mTexts.push_back(Text{ id, text, true });
+    mTextNumbers[id] = number;
+    addPostings(number);
+
+    if (mDeadTexts >= MIN_DEAD_TEXTS_TO_COMPACT && mDeadTexts > mTextNumbers.size())
+    {
+        compact();
+    }
+}
+
+void LLTrigramIndex::remove(const LLUUID& id)
+{
+    auto found = mTextNumbers.find(id);
+    if (found == mTextNumbers.end())
+    {
+        return;
+    }
+    Text& text = mTexts[found->second];
+    text.mLive = false;
+    text.mText.clear();
+    mTextNumbers.erase(found);
+    ++mDeadTexts;
+
+    if (mDeadTexts >= MIN_DEAD_TEXTS_TO_COMPACT && mDeadTexts > mTextNumbers.size())
+    {
+        compact();
+    }
+}
+
+void LLTrigramIndex::clear()
+{
+    mTexts.clear();
+    mTextNumbers.clear();
+    mPostings.clear();
+    mDeadTexts = 0;
+}
+
+bool LLTrigramIndex::find(const std::string& substring, id_set_t& matches) const
+{
+    if (substring.size() < MIN_QUERY_LENGTH)
+    {
+        return false;
+    }
+
+    std::vector<U32> trigrams;
+    get_trigrams(substring, trigrams);
+    std::vector<const std::vector<U32>*> postings;
+    postings.reserve(trigrams.size());
+    for (U32 trigram : trigrams)
+    {
+        auto found = mPostings.find(trigram);
+        if (found == mPostings.end())
+        {
+            // Nothing has this trigram
+            return true;
+        }
+        postings.push_back(&found->second);
+    }
+
+    // Walk the shortest list, moving a cursor along each of the others
+    std::sort(postings.begin(), postings.end(),
+              [](const std::vector<U32>* a, const std::vector<U32>* b) { return a->size() < b->size(); });
+    std::vector<std::vector<U32>::const_iterator> cursors;
+    cursors.reserve(postings.size());
+    for (const std::vector<U32>* posting : postings)
+    {
+        cursors.push_back(posting->begin());
+    }
+
+    for (U32 number : *postings[0])
+    {
+        const Text& text = mTexts[number];
+        if (!text.mLive)
+        {
+            continue;
+        }
+        bool in_all = true;
+        for (size_t i = 1; i < postings.size(); ++i)
+        {
+            cursors[i] = std::lower_bound(cursors[i], postings[i]->end(), number);
+            if (cursors[i] == postings[i]->end())
+            {
+                return true;
+            }
+            if (*cursors[i] != number)
+            {
+                in_all = false;
+                break;
+            }
+        }
+        // Having the trigrams does not mean having them in a row
+        if (in_all && text.mText.find(substring) != std::string::npos)
+        {
+            matches.insert(text.mID);
+        }
+    }
+    return true;
+}
+
+void LLTrigramIndex::addPostings(U32 number)
+{
+    std::vector<U32> trigrams;
+    get_trigrams(mTexts[number].mText, trigrams);
+    for (U32 trigram : trigrams)
+    {
+        mPostings[trigram].push_back(number);
+    }
+}
+
+void LLTrigramIndex::compact()
+{
+    std::vector<Text> texts;
+    texts.reserve(mTextNumbers.size());
+    for (Text& text : mTexts)
+    {
+        if (text.mLive)
+        {
+            mTextNumbers[text.mID] = (U32)texts.size();
+            texts.push_back(std::move(text));
+        }
+    }
+    mTexts.swap(texts);
+    mDeadTexts = 0;
+
+    mPostings.clear();
+    for (U32 number = 0; number < (U32)mTexts.size(); ++number)
+    {
+        addPostings(number);
+    }
+}
@@ -0,0 +1,88 @@
+/**
+ * @file lltrigramindex.h
+ * @brief Substring search over many short texts through their trigrams.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLTRIGRAMINDEX_H
+#define LL_LLTRIGRAMINDEX_H
+
+#include <string>
+#include <vector>
+#include <boost/unordered/unordered_flat_map.hpp>
+#include <boost/unordered/unordered_flat_set.hpp>
+
+#include "lluuid.h"
+
+// One text per UUID, found by any substring of three bytes or more. Every
+// run of three bytes of a text is filed under the number of the text, so
+// a lookup only verifies the texts that have all the trigrams of the
+// substring. Matching is byte wise: fold the case of texts and
+// substrings before passing them in.
+//
+// Replacing or removing a text leaves its number behind until enough of
+// them have piled up, then the postings are rebuilt.
+class LL_COMMON_API LLTrigramIndex
+{
+public:
+    typedef boost::unordered_flat_set<LLUUID> id_set_t;
+
+    // Shorter substrings can not be looked up
+    static constexpr size_t MIN_QUERY_LENGTH = 3;
+
+    LLTrigramIndex();
+
+    // Adds the text of id, or replaces it.
+    void set(const LLUUID& id, const std::string& text);
+    void remove(const LLUUID& id);
+    void clear();
+
+    bool contains(const LLUUID& id) const { return mTextNumbers.contains(id); }
+    size_t size() const { return mTextNumbers.size(); }
+
+    // Adds every id whose text contains substring to matches. Returns
+    // false, adding nothing, when substring is shorter than
+    // MIN_QUERY_LENGTH.
+    bool find(const std::string& substring, id_set_t& matches) const;
+
+private:
+    struct Text
+    {
+        LLUUID mID;
+        std::string mText;
+        bool mLive;
+    };
+
+    void addPostings(U32 number);
+    void compact();
+
+    // By number, in the order they were set
+    std::vector<Text> mTexts;
+    // Live text of each id
+    boost::unordered_flat_map<LLUUID, U32> mTextNumbers;
+    // Ascending text numbers by trigram
+    boost::unordered_flat_map<U32, std::vector<U32> > mPostings;
+    size_t mDeadTexts;
+};
+
+#endif // LL_LLTRIGRAMINDEX_H
@@ -0,0 +1,93 @@
+/**
+ * @file   parallelfor.cpp
+ * @date   2026-10-19
+ * @brief  Implementation for parallelfor.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "parallelfor.h"
+// STL headers
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+// std headers
+// external library headers
+// other Linden headers
+#include "workqueue.h"
+
+namespace
+{
+    // Shared by the calling thread and the helpers, a helper can outlive
+    // parallel_for()
+    struct ParallelFor
+    {
+        std::function<bool(size_t)> mFn;
+        size_t mCount = 0;
+        std::atomic<size_t> mNext { 0 };
+        std::atomic<size_t> mDone { 0 };
+        std::atomic<bool> mFailed { false };
+        std::mutex mMutex;
+        std::condition_variable mFinished;
+
+        void run()
+        {
+            for (size_t i = mNext++; i < mCount; i = mNext++)
+            {
+                if (!mFailed && !mFn(i))
+                {
+                    mFailed = true;
+                }
+
+                if (++mDone == mCount)
+                {
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    mFinished.notify_all();
+                }
+            }
+        }
+    };
+} // anonymous namespace
+
+bool LL::parallel_for(const std::string& queue_name, size_t count,
+                      const std::function<bool(size_t)>& fn, size_t max_helpers)
+{
+    if (count == 0)
+    {
+        return true;
+    }
+
+    auto state = std::make_shared<ParallelFor>();
+    state->mFn = fn;
+    state->mCount = count;
+
+    WorkQueue::ptr_t queue;
+    if (count > 1 && max_helpers > 0)
+    {
+        queue = WorkQueue::getInstance(queue_name);
+    }
+    if (queue)
+    {
+        const size_t helpers = llmin(count - 1, max_helpers);
+        for (size_t i = 0; i < helpers; ++i)
+        {
+            if (!queue->post([state]() { state->run(); }))
+            {
+                // closed, shutting down
+                break;
+            }
+        }
+    }
+
+    state->run();
+
+    std::unique_lock<std::mutex> lock(state->mMutex);
+    state->mFinished.wait(lock, [&state]() { return state->mDone == state->mCount; });
+    return !state->mFailed;
+}
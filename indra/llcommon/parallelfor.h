@@ -0,0 +1,40 @@
+/**
+ * @file   parallelfor.h
+ * @date   2026-10-19
+ * @brief  parallel_for() splits independent work between the calling thread
+ *         and a WorkQueue.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#if ! defined(LL_PARALLELFOR_H)
+#define LL_PARALLELFOR_H
+
+#include <functional>
+#include <string>
+
+namespace LL
+{
+    /**
+     * Calls fn(i) for every i in [0, count), on the calling thread and on up
+     * to max_helpers tasks posted to the WorkQueue named queue_name, and
+     * returns once every call is done. Indices are claimed in order from a
+     * shared counter, so put the biggest pieces of work first.
+     *
+     * The calling thread takes part, so this never waits on a queue that is
+     * busy, closed or missing: it then simply does all the work itself.
+     * Helpers that start late find nothing left and never touch fn's data
+     * after parallel_for() returns.
+     *
+     * fn must be safe to call concurrently for different indices. Once a
+     * call returns false the remaining indices are skipped and
+     * parallel_for() returns false.
+     */
+    LL_COMMON_API bool parallel_for(const std::string& queue_name, size_t count,
+                                    const std::function<bool(size_t)>& fn,
+                                    size_t max_helpers = 8);
+} // namespace LL
+
+#endif /* ! defined(LL_PARALLELFOR_H) */
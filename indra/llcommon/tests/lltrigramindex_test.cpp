@@ -0,0 +1,199 @@
+/**
+ * @file   lltrigramindex_test.cpp
+ * @brief  LLTrigramIndex lookups against a plain scan, and their timing
+ *         over an inventory sized set of names.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include <map>
+#include <random>
+#include <vector>
+
+#include "lltrigramindex.h"
+#include "llformat.h"
+#include "../test/lltut.h"
+
+namespace
+{
+    // Inventory like names, and what gets typed into the search box
+    const U32 NUM_NAMES = 20000;
+    const char* NAME_QUERIES[] = { "DRE", "DRES", "DRESS", "BLUE DRESS", "HAIR", "ZZZ" };
+
+    // Random words from a small alphabet, so that substrings of every
+    // length turn up
+    std::string random_text(std::mt19937& rng, const char* alphabet, size_t max_length)
+    {
+        const size_t alphabet_size = strlen(alphabet);
+        std::string text(rng() % (max_length + 1), ' ');
+        for (char& c : text)
+        {
+            c = alphabet[rng() % alphabet_size];
+        }
+        return text;
+    }
+
+    LLUUID make_id(U32 n)
+    {
+        LLUUID id;
+        memcpy(id.mData, &n, sizeof(n));
+        return id;
+    }
+
+    void scan(const std::map<LLUUID, std::string>& texts, const std::string& substring, LLTrigramIndex::id_set_t& matches)
+    {
+        for (const auto& entry : texts)
+        {
+            if (entry.second.find(substring) != std::string::npos)
+            {
+                matches.insert(entry.first);
+            }
+        }
+    }
+}
+
+namespace tut
+{
+    struct trigramindex_data
+    {
+        std::mt19937 mRNG;
+
+        trigramindex_data()
+        :   mRNG(4242)
+        {
+        }
+    };
+    typedef test_group<trigramindex_data> trigramindex_group;
+    typedef trigramindex_group::object trigramindex_object;
+    tut::trigramindex_group trigramindex_testgroup("LLTrigramIndex");
+
+    template<> template<>
+    void trigramindex_object::test<1>()
+    {
+        set_test_name("same matches as a scan");
+
+        LLTrigramIndex index;
+        std::map<LLUUID, std::string> texts;
+        for (U32 i = 0; i < 3000; ++i)
+        {
+            const std::string text = random_text(mRNG, "ABCD \xc3\xa9", 12);
+            index.set(make_id(i), text);
+            texts[make_id(i)] = text;
+        }
+        ensure_equals("size", index.size(), texts.size());
+
+        LLTrigramIndex::id_set_t matches;
+        ensure("too short", !index.find("AB", matches) && matches.empty());
+        for (U32 i = 0; i < 500; ++i)
+        {
+            const std::string substring = random_text(mRNG, "ABCD \xc3\xa9", 6);
+            if (substring.size() < LLTrigramIndex::MIN_QUERY_LENGTH)
+            {
+                continue;
+            }
+            LLTrigramIndex::id_set_t expected;
+            scan(texts, substring, expected);
+            matches.clear();
+            ensure("found", index.find(substring, matches));
+            ensure("same matches", matches == expected);
+        }
+    }
+
+    template<> template<>
+    void trigramindex_object::test<2>()
+    {
+        set_test_name("replaced and removed texts");
+
+        LLTrigramIndex index;
+        std::map<LLUUID, std::string> texts;
+        // Enough churn to compact several times
+        for (U32 round = 0; round < 20000; ++round)
+        {
+            const LLUUID id = make_id(mRNG() % 800);
+            if (mRNG() % 4 == 0)
+            {
+                index.remove(id);
+                texts.erase(id);
+            }
+            else
+            {
+                const std::string text = random_text(mRNG, "ABC ", 10);
+                index.set(id, text);
+                texts[id] = text;
+            }
+        }
+        ensure_equals("size", index.size(), texts.size());
+        for (const auto& entry : texts)
+        {
+            ensure("contains", index.contains(entry.first));
+        }
+
+        const char* substrings[] = { "ABC", "CBA", "A B", "AAAA", "C C C" };
+        for (const char* substring : substrings)
+        {
+            LLTrigramIndex::id_set_t expected;
+            scan(texts, substring, expected);
+            LLTrigramIndex::id_set_t matches;
+            index.find(substring, matches);
+            ensure((std::string("same matches for ") + substring).c_str(), matches == expected);
+        }
+
+        index.clear();
+        LLTrigramIndex::id_set_t matches;
+        ensure("cleared", index.size() == 0 && index.find("ABC", matches) && matches.empty());
+    }
+
+    template<> template<>
+    void trigramindex_object::test<3>()
+    {
+        set_test_name("inventory names match a scan");
+
+        const char* words[] = { "BLUE", "RED", "DRESS", "SHIRT", "HAIR", "MESH", "SKIN", "SHAPE", "BOOTS",
+                                "JACKET", "V2", "(FITTED)", "FEMALE", "MALE", "HUD", "ANIMATION", "POSE" };
+        LLTrigramIndex index;
+        std::map<LLUUID, std::string> texts;
+        for (U32 i = 0; i < NUM_NAMES; ++i)
+        {
+            std::string text;
+            for (U32 w = 1 + mRNG() % 4; w > 0; --w)
+            {
+                text += words[mRNG() % LL_ARRAY_SIZE(words)];
+                text += ' ';
+            }
+            text += llformat("%u", i);
+            index.set(make_id(i), text);
+            texts[make_id(i)] = text;
+        }
+
+        for (const char* query : NAME_QUERIES)
+        {
+            LLTrigramIndex::id_set_t expected;
+            scan(texts, query, expected);
+
+            LLTrigramIndex::id_set_t matches;
+            ensure((std::string("found ") + query).c_str(), index.find(query, matches));
+            ensure((std::string("same matches for ") + query).c_str(), matches == expected);
+        }
+    }
+}
@@ -0,0 +1,95 @@
+/**
+ * @file   lluuidmap_test.cpp
+ * @brief  Correctness and timing of LLUUID and local id keyed lookup tables,
+ *         as used by LLViewerObjectList.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include <map>
+#include <vector>
+#include <boost/unordered/unordered_flat_map.hpp>
+
+#include "lluuid.h"
+#include "../test/lltut.h"
+
+namespace
+{
+    // Same size as the viewer object list
+    const S32 NUM_OBJECTS = 100000;
+
+    struct ObjectKeys
+    {
+        std::vector<LLUUID> mIDs;
+
+        ObjectKeys()
+        {
+            mIDs.reserve(NUM_OBJECTS);
+            for (S32 i = 0; i < NUM_OBJECTS; ++i)
+            {
+                mIDs.push_back(LLUUID::generateNewID());
+            }
+        }
+    };
+}
+
+namespace tut
+{
+    struct uuidmap_data
+    {
+        ObjectKeys mKeys;
+    };
+    typedef test_group<uuidmap_data> uuidmap_group;
+    typedef uuidmap_group::object uuidmap_object;
+    tut::uuidmap_group uuidmap_testgroup("LLUUID maps");
+
+    template<> template<>
+    void uuidmap_object::test<1>()
+    {
+        set_test_name("flat map matches std::map");
+
+        boost::unordered_flat_map<LLUUID, S32> flat;
+        std::map<LLUUID, S32> tree;
+        for (S32 i = 0; i < NUM_OBJECTS; ++i)
+        {
+            flat[mKeys.mIDs[i]] = i;
+            tree[mKeys.mIDs[i]] = i;
+        }
+        for (S32 i = 0; i < NUM_OBJECTS; i += 3)
+        {
+            flat.erase(mKeys.mIDs[i]);
+            tree.erase(mKeys.mIDs[i]);
+        }
+
+        ensure_equals("size", flat.size(), tree.size());
+        for (const auto& [id, value] : tree)
+        {
+            auto iter = flat.find(id);
+            ensure("present", iter != flat.end());
+            ensure_equals("value", iter->second, value);
+        }
+        ensure("null absent", flat.find(LLUUID::null) == flat.end());
+        ensure("erased absent", flat.find(mKeys.mIDs[0]) == flat.end());
+    }
+}
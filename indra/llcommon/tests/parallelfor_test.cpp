@@ -0,0 +1,101 @@
+/**
+ * @file   parallelfor_test.cpp
+ * @date   2026-10-19
+ * @brief  Test for parallelfor.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "parallelfor.h"
+// STL headers
+#include <atomic>
+#include <vector>
+// std headers
+// external library headers
+// other Linden headers
+#include "../test/lltut.h"
+#include "threadpool.h"
+
+using namespace LL;
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct parallelfor_data
+    {
+        static constexpr size_t COUNT = 1000;
+
+        std::vector<std::atomic<U32> > mCalls;
+
+        parallelfor_data():
+            mCalls(COUNT)
+        {}
+
+        bool calledOnce() const
+        {
+            for (const std::atomic<U32>& calls : mCalls)
+            {
+                if (calls != 1)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+    typedef test_group<parallelfor_data> parallelfor_group;
+    typedef parallelfor_group::object object;
+    parallelfor_group parallelforgrp("parallelfor");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("no queue");
+        ensure("done", parallel_for("ParallelForNoSuchQueue", COUNT,
+                                    [this](size_t i) { ++mCalls[i]; return true; }));
+        ensure("every index once", calledOnce());
+        ensure("nothing to do", parallel_for("ParallelForNoSuchQueue", 0,
+                                             [](size_t) { return false; }));
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("thread pool");
+        ThreadPool pool("ParallelForTest", 2);
+        pool.start();
+        ensure("done", parallel_for("ParallelForTest", COUNT,
+                                    [this](size_t i) { ++mCalls[i]; return true; }));
+        ensure("every index once", calledOnce());
+        pool.close();
+
+        // Closed, the calling thread does it all
+        for (std::atomic<U32>& calls : mCalls)
+        {
+            calls = 0;
+        }
+        ensure("done when closed", parallel_for("ParallelForTest", COUNT,
+                                                [this](size_t i) { ++mCalls[i]; return true; }));
+        ensure("every index once when closed", calledOnce());
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("failure");
+        ThreadPool pool("ParallelForTest", 2);
+        pool.start();
+        std::atomic<U32> calls(0);
+        ensure("failed", !parallel_for("ParallelForTest", COUNT,
+                                       [&calls](size_t i) { ++calls; return i != 10; }));
+        ensure("stopped early", calls < COUNT);
+        pool.close();
+    }
+} // namespace tut
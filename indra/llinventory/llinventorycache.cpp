@@ -0,0 +1,481 @@
+/**
+ * @file llinventorycache.cpp
+ * @brief Binary on disk format of the inventory cache.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "llinventorycache.h"
+
+#include "llfile.h"
+#include "llmappedfile.h"
+#include "parallelfor.h"
+
+#ifdef LL_USESYSTEMLIBS
+# include <zlib.h>
+#else
+# include "zlib-ng/zlib.h"
+#endif
+
+namespace
+{
+    const char FILE_MAGIC[4] = { 'L', 'L', 'I', 'C' };
+
+    const U32 CATEGORIES_PER_BLOCK = 1024;
+    const U32 ITEMS_PER_BLOCK = 4096;
+
+    // Keeps a corrupt block table from asking for huge buffers
+    const U32 MAX_RAW_BLOCK_SIZE = 64 * 1024 * 1024;
+
+    enum EBlockKind
+    {
+        BLOCK_CATEGORIES = 1,
+        BLOCK_ITEMS = 2
+    };
+
+    struct FileHeader
+    {
+        char mMagic[4];
+        U32 mFormatVersion;
+        S32 mCacheVersion;
+        U32 mNumCategories;
+        U32 mNumItems;
+        U32 mNumBlocks;
+    };
+
+    struct BlockHeader
+    {
+        U64 mOffset;        // from the start of the file
+        U32 mPackedSize;
+        U32 mRawSize;
+        U32 mKind;
+        U32 mCount;
+    };
+
+    // Into the string table following the records of a block
+    struct StringRef
+    {
+        U32 mOffset;
+        U32 mLength;
+    };
+
+    struct CategoryRecord
+    {
+        U8 mUUID[UUID_BYTES];
+        U8 mParentUUID[UUID_BYTES];
+        U8 mThumbnailUUID[UUID_BYTES];
+        U8 mOwnerID[UUID_BYTES];
+        S32 mVersion;
+        S32 mPreferredType;
+        StringRef mName;
+    };
+
+    struct ItemRecord
+    {
+        U8 mUUID[UUID_BYTES];
+        U8 mParentUUID[UUID_BYTES];
+        U8 mAssetUUID[UUID_BYTES];
+        U8 mThumbnailUUID[UUID_BYTES];
+        U8 mCreator[UUID_BYTES];
+        U8 mOwner[UUID_BYTES];
+        U8 mLastOwner[UUID_BYTES];
+        U8 mGroup[UUID_BYTES];
+        U32 mMaskBase;
+        U32 mMaskOwner;
+        U32 mMaskGroup;
+        U32 mMaskEveryone;
+        U32 mMaskNext;
+        U32 mFlags;
+        S64 mCreationDate;
+        S32 mSalePrice;
+        S8 mType;
+        S8 mInventoryType;
+        S8 mSaleType;
+        S8 mPad;
+        StringRef mName;
+        StringRef mDescription;
+    };
+
+    static_assert(sizeof(FileHeader) == 24, "FileHeader is written as is");
+    static_assert(sizeof(BlockHeader) == 24, "BlockHeader is written as is");
+    static_assert(sizeof(CategoryRecord) == 80, "CategoryRecord is written as is");
+    static_assert(sizeof(ItemRecord) == 184, "ItemRecord is written as is");
+
+    StringRef add_string(std::vector<U8>& strings, const std::string& str)
+    {
+        StringRef ref;
+        ref.mOffset = static_cast<U32>(strings.size());
+        ref.mLength = static_cast<U32>(str.size());
+        strings.insert(strings.end(), str.begin(), str.end());
+        return ref;
+    }
+
+    bool get_string(const U8* strings, U32 strings_size, const StringRef& ref, std::string& str)
+    {
+        if (ref.mOffset > strings_size || ref.mLength > strings_size - ref.mOffset)
+        {
+            return false;
+        }
+        str.assign(reinterpret_cast<const char*>(strings) + ref.mOffset, ref.mLength);
+        return true;
+    }
+
+    void encode(const LLInventoryCacheFile::Category& cat, std::vector<U8>& strings, CategoryRecord& record)
+    {
+        memcpy(record.mUUID, cat.mUUID.mData, UUID_BYTES);
+        memcpy(record.mParentUUID, cat.mParentUUID.mData, UUID_BYTES);
+        memcpy(record.mThumbnailUUID, cat.mThumbnailUUID.mData, UUID_BYTES);
+        memcpy(record.mOwnerID, cat.mOwnerID.mData, UUID_BYTES);
+        record.mVersion = cat.mVersion;
+        record.mPreferredType = cat.mPreferredType;
+        record.mName = add_string(strings, cat.mName);
+    }
+
+    void encode(const LLInventoryCacheFile::Item& item, std::vector<U8>& strings, ItemRecord& record)
+    {
+        const LLPermissions& perm = item.mPermissions;
+        memcpy(record.mUUID, item.mUUID.mData, UUID_BYTES);
+        memcpy(record.mParentUUID, item.mParentUUID.mData, UUID_BYTES);
+        memcpy(record.mAssetUUID, item.mAssetUUID.mData, UUID_BYTES);
+        memcpy(record.mThumbnailUUID, item.mThumbnailUUID.mData, UUID_BYTES);
+        memcpy(record.mCreator, perm.getCreator().mData, UUID_BYTES);
+        memcpy(record.mOwner, perm.getOwner().mData, UUID_BYTES);
+        memcpy(record.mLastOwner, perm.getLastOwner().mData, UUID_BYTES);
+        memcpy(record.mGroup, perm.getGroup().mData, UUID_BYTES);
+        record.mMaskBase = perm.getMaskBase();
+        record.mMaskOwner = perm.getMaskOwner();
+        record.mMaskGroup = perm.getMaskGroup();
+        record.mMaskEveryone = perm.getMaskEveryone();
+        record.mMaskNext = perm.getMaskNextOwner();
+        record.mFlags = item.mFlags;
+        record.mCreationDate = static_cast<S64>(item.mCreationDate);
+        record.mSalePrice = item.mSaleInfo.getSalePrice();
+        record.mType = static_cast<S8>(item.mType);
+        record.mInventoryType = static_cast<S8>(item.mInventoryType);
+        record.mSaleType = static_cast<S8>(item.mSaleInfo.getSaleType());
+        record.mPad = 0;
+        record.mName = add_string(strings, item.mName);
+        record.mDescription = add_string(strings, item.mDescription);
+    }
+
+    bool decode(const CategoryRecord& record, const U8* strings, U32 strings_size, LLInventoryCacheFile::Category& cat)
+    {
+        memcpy(cat.mUUID.mData, record.mUUID, UUID_BYTES);
+        memcpy(cat.mParentUUID.mData, record.mParentUUID, UUID_BYTES);
+        memcpy(cat.mThumbnailUUID.mData, record.mThumbnailUUID, UUID_BYTES);
+        memcpy(cat.mOwnerID.mData, record.mOwnerID, UUID_BYTES);
+        cat.mVersion = record.mVersion;
+        cat.mPreferredType = static_cast<LLFolderType::EType>(record.mPreferredType);
+        return get_string(strings, strings_size, record.mName, cat.mName);
+    }
+
+    bool decode(const ItemRecord& record, const U8* strings, U32 strings_size, LLInventoryCacheFile::Item& item)
+    {
+        LLUUID creator, owner, last_owner, group;
+        memcpy(item.mUUID.mData, record.mUUID, UUID_BYTES);
+        memcpy(item.mParentUUID.mData, record.mParentUUID, UUID_BYTES);
+        memcpy(item.mAssetUUID.mData, record.mAssetUUID, UUID_BYTES);
+        memcpy(item.mThumbnailUUID.mData, record.mThumbnailUUID, UUID_BYTES);
+        memcpy(creator.mData, record.mCreator, UUID_BYTES);
+        memcpy(owner.mData, record.mOwner, UUID_BYTES);
+        memcpy(last_owner.mData, record.mLastOwner, UUID_BYTES);
+        memcpy(group.mData, record.mGroup, UUID_BYTES);
+
+        // As ll_permissions_from_sd() rebuilds them
+        LLPermissions& perm = item.mPermissions;
+        perm.init(creator, owner, last_owner, group);
+        perm.setMaskBase(record.mMaskBase);
+        perm.setMaskOwner(record.mMaskOwner);
+        perm.setMaskEveryone(record.mMaskEveryone);
+        perm.setMaskGroup(record.mMaskGroup);
+        perm.setMaskNext(record.mMaskNext);
+        perm.fix();
+
+        item.mSaleInfo = LLSaleInfo(static_cast<LLSaleInfo::EForSale>(record.mSaleType), record.mSalePrice);
+        item.mFlags = record.mFlags;
+        item.mCreationDate = static_cast<time_t>(record.mCreationDate);
+        item.mType = static_cast<LLAssetType::EType>(record.mType);
+        item.mInventoryType = static_cast<LLInventoryType::EType>(record.mInventoryType);
+        return get_string(strings, strings_size, record.mName, item.mName)
+            && get_string(strings, strings_size, record.mDescription, item.mDescription);
+    }
+
+    // Records of block first..first + count of in, then their strings
+    template <typename RECORD, typename T>
+    void encode_block(const std::vector<T>& in, U32 first, U32 count, std::vector<U8>& raw)
+    {
+        std::vector<U8> strings;
+        std::vector<RECORD> records(count);
+        for (U32 i = 0; i < count; ++i)
+        {
+            encode(in[first + i], strings, records[i]);
+        }
+
+        raw.resize(count * sizeof(RECORD) + strings.size());
+        memcpy(raw.data(), records.data(), count * sizeof(RECORD));
+        if (!strings.empty())
+        {
+            memcpy(raw.data() + count * sizeof(RECORD), strings.data(), strings.size());
+        }
+    }
+
+    template <typename RECORD, typename T>
+    bool decode_block(const U8* raw, U32 raw_size, U32 count, std::vector<T>& out, U32 first)
+    {
+        if (raw_size < count * sizeof(RECORD))
+        {
+            return false;
+        }
+        const U8* strings = raw + count * sizeof(RECORD);
+        const U32 strings_size = raw_size - count * static_cast<U32>(sizeof(RECORD));
+
+        RECORD record;
+        for (U32 i = 0; i < count; ++i)
+        {
+            memcpy(&record, raw + i * sizeof(RECORD), sizeof(RECORD));
+            if (!decode(record, strings, strings_size, out[first + i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+LLInventoryCacheFile::Category::Category()
+:   mVersion(0),
+    mPreferredType(LLFolderType::FT_NONE)
+{
+}
+
+LLInventoryCacheFile::Item::Item()
+:   mFlags(0),
+    mCreationDate(0),
+    mType(LLAssetType::AT_NONE),
+    mInventoryType(LLInventoryType::IT_NONE)
+{
+}
+
+//static
+bool LLInventoryCacheFile::write(const std::string& filename, S32 cache_version,
+                                 const std::vector<Category>& categories,
+                                 const std::vector<Item>& items)
+{
+    LL_PROFILE_ZONE_SCOPED;
+
+    const U32 num_categories = static_cast<U32>(categories.size());
+    const U32 num_items = static_cast<U32>(items.size());
+    const U32 num_category_blocks = (num_categories + CATEGORIES_PER_BLOCK - 1) / CATEGORIES_PER_BLOCK;
+    const U32 num_item_blocks = (num_items + ITEMS_PER_BLOCK - 1) / ITEMS_PER_BLOCK;
+    const U32 num_blocks = num_category_blocks + num_item_blocks;
+
+    std::vector<BlockHeader> blocks(num_blocks);
+    std::vector<std::vector<U8> > packed(num_blocks);
+    bool ok = LL::parallel_for("General", num_blocks, [&](size_t b)
+        {
+            BlockHeader& block = blocks[b];
+            std::vector<U8> raw;
+            if (b < num_category_blocks)
+            {
+                const U32 first = static_cast<U32>(b) * CATEGORIES_PER_BLOCK;
+                block.mKind = BLOCK_CATEGORIES;
+                block.mCount = llmin(CATEGORIES_PER_BLOCK, num_categories - first);
+                encode_block<CategoryRecord>(categories, first, block.mCount, raw);
+            }
+            else
+            {
+                const U32 first = static_cast<U32>(b - num_category_blocks) * ITEMS_PER_BLOCK;
+                block.mKind = BLOCK_ITEMS;
+                block.mCount = llmin(ITEMS_PER_BLOCK, num_items - first);
+                encode_block<ItemRecord>(items, first, block.mCount, raw);
+            }
+            if (raw.size() > MAX_RAW_BLOCK_SIZE)
+            {
+                return false;
+            }
+
+            uLongf packed_size = compressBound(static_cast<uLong>(raw.size()));
+            packed[b].resize(packed_size);
+            if (compress2(packed[b].data(), &packed_size, raw.data(), static_cast<uLong>(raw.size()), Z_BEST_SPEED) != Z_OK)
+            {
+                return false;
+            }
+            packed[b].resize(packed_size);
+            block.mRawSize = static_cast<U32>(raw.size());
+            block.mPackedSize = static_cast<U32>(packed_size);
+            return true;
+        });
+    if (!ok)
+    {
+        LL_WARNS("Inventory") << "Failed to compress inventory cache " << filename << LL_ENDL;
+        return false;
+    }
+
+    FileHeader header;
+    memcpy(header.mMagic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header.mFormatVersion = FORMAT_VERSION;
+    header.mCacheVersion = cache_version;
+    header.mNumCategories = num_categories;
+    header.mNumItems = num_items;
+    header.mNumBlocks = num_blocks;
+
+    U64 offset = sizeof(FileHeader) + num_blocks * sizeof(BlockHeader);
+    for (BlockHeader& block : blocks)
+    {
+        block.mOffset = offset;
+        offset += block.mPackedSize;
+    }
+
+    // Written aside and renamed into place, so a second instance never maps
+    // a partial file. Instances logging out together each write their own.
+    const std::string temp_filename = filename + "." + LLUUID::generateNewID().asString() + ".tmp";
+    LLFILE* fp = LLFile::fopen(temp_filename, "wb");
+    if (!fp)
+    {
+        LL_WARNS("Inventory") << "Unable to open " << temp_filename << " for writing" << LL_ENDL;
+        return false;
+    }
+    bool written = fwrite(&header, sizeof(header), 1, fp) == 1;
+    written = written && (num_blocks == 0 || fwrite(blocks.data(), sizeof(BlockHeader), num_blocks, fp) == num_blocks);
+    for (U32 b = 0; written && b < num_blocks; ++b)
+    {
+        written = fwrite(packed[b].data(), 1, packed[b].size(), fp) == packed[b].size();
+    }
+    LLFile::close(fp);
+
+#if LL_WINDOWS
+    // rename() does not replace an existing file there
+    LLFile::remove(filename, ENOENT);
+#endif
+    if (!written || LLFile::rename(temp_filename, filename) != 0)
+    {
+        LL_WARNS("Inventory") << "Failed to write inventory cache " << filename << LL_ENDL;
+        LLFile::remove(temp_filename);
+        return false;
+    }
+    return true;
+}
+
+//static
+LLInventoryCacheFile::EResult LLInventoryCacheFile::read(const std::string& filename, S32 cache_version,
+                                                         std::vector<Category>& categories,
+                                                         std::vector<Item>& items)
+{
+    LL_PROFILE_ZONE_SCOPED;
+
+    LLMappedFile file;
+    if (!file.open(filename))
+    {
+        return RESULT_MISSING;
+    }
+    const U8* data = file.getData();
+    const size_t size = file.getSize();
+
+    FileHeader header;
+    if (size < sizeof(header))
+    {
+        return RESULT_CORRUPT;
+    }
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.mMagic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0)
+    {
+        return RESULT_CORRUPT;
+    }
+    if (header.mFormatVersion != FORMAT_VERSION || header.mCacheVersion != cache_version)
+    {
+        return RESULT_OBSOLETE;
+    }
+    if (header.mNumBlocks > (size - sizeof(header)) / sizeof(BlockHeader))
+    {
+        return RESULT_CORRUPT;
+    }
+
+    // Where the records of every block go, so blocks decode independently
+    std::vector<BlockHeader> blocks(header.mNumBlocks);
+    std::vector<U32> firsts(header.mNumBlocks);
+    U64 total_categories = 0;
+    U64 total_items = 0;
+    if (header.mNumBlocks)
+    {
+        memcpy(blocks.data(), data + sizeof(header), header.mNumBlocks * sizeof(BlockHeader));
+    }
+    for (U32 b = 0; b < header.mNumBlocks; ++b)
+    {
+        const BlockHeader& block = blocks[b];
+        if (block.mOffset > size || block.mPackedSize > size - block.mOffset
+            || block.mRawSize > MAX_RAW_BLOCK_SIZE)
+        {
+            return RESULT_CORRUPT;
+        }
+
+        // A block holds at least its records, so counts are bounded before
+        // anything is allocated for them
+        if (block.mKind == BLOCK_CATEGORIES && (U64)block.mCount * sizeof(CategoryRecord) <= block.mRawSize)
+        {
+            firsts[b] = static_cast<U32>(total_categories);
+            total_categories += block.mCount;
+        }
+        else if (block.mKind == BLOCK_ITEMS && (U64)block.mCount * sizeof(ItemRecord) <= block.mRawSize)
+        {
+            firsts[b] = static_cast<U32>(total_items);
+            total_items += block.mCount;
+        }
+        else
+        {
+            return RESULT_CORRUPT;
+        }
+    }
+    if (total_categories != header.mNumCategories || total_items != header.mNumItems)
+    {
+        return RESULT_CORRUPT;
+    }
+
+    std::vector<Category> read_categories(header.mNumCategories);
+    std::vector<Item> read_items(header.mNumItems);
+    bool ok = LL::parallel_for("General", header.mNumBlocks, [&](size_t b)
+        {
+            const BlockHeader& block = blocks[b];
+            std::vector<U8> raw(block.mRawSize);
+            uLongf raw_size = block.mRawSize;
+            if (uncompress(raw.data(), &raw_size, data + block.mOffset, block.mPackedSize) != Z_OK
+                || raw_size != block.mRawSize)
+            {
+                return false;
+            }
+
+            if (block.mKind == BLOCK_CATEGORIES)
+            {
+                return decode_block<CategoryRecord>(raw.data(), block.mRawSize, block.mCount, read_categories, firsts[b]);
+            }
+            return decode_block<ItemRecord>(raw.data(), block.mRawSize, block.mCount, read_items, firsts[b]);
+        });
+    if (!ok)
+    {
+        return RESULT_CORRUPT;
+    }
+
+    categories.swap(read_categories);
+    items.swap(read_items);
+    return RESULT_OK;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file llinventorycache.h
+ * @brief Binary on disk format of the inventory cache.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLINVENTORYCACHE_H
+#define LL_LLINVENTORYCACHE_H
+
+#include <string>
+#include <vector>
+
+#include "llassettype.h"
+#include "llfoldertype.h"
+#include "llinventorytype.h"
+#include "llpermissions.h"
+#include "llsaleinfo.h"
+#include "lluuid.h"
+
+// The inventory cache as fixed size records, with the names and
+// descriptions in a string table. Records are stored in blocks of a few
+// thousand, each compressed on its own, behind a table giving the offset
+// of every block. A file is read through a mapping and its blocks are
+// decoded in parallel on the General work queue, with the calling thread
+// taking part.
+//
+// Files are written in the byte order of the machine, every platform the
+// viewer runs on is little endian.
+class LLInventoryCacheFile
+{
+public:
+    // Bump when the layout of the records or blocks changes
+    static constexpr U32 FORMAT_VERSION = 1;
+
+    struct Category
+    {
+        Category();
+
+        LLUUID mUUID;
+        LLUUID mParentUUID;
+        LLUUID mThumbnailUUID;
+        LLUUID mOwnerID;
+        std::string mName;
+        S32 mVersion;
+        LLFolderType::EType mPreferredType;
+    };
+
+    struct Item
+    {
+        Item();
+
+        LLUUID mUUID;
+        LLUUID mParentUUID;
+        LLUUID mAssetUUID;
+        LLUUID mThumbnailUUID;
+        LLPermissions mPermissions;
+        LLSaleInfo mSaleInfo;
+        std::string mName;
+        std::string mDescription;
+        U32 mFlags;
+        time_t mCreationDate;
+        LLAssetType::EType mType;
+        LLInventoryType::EType mInventoryType;
+    };
+
+    enum EResult
+    {
+        RESULT_OK,
+        RESULT_MISSING,
+        // Written by another format or cache version
+        RESULT_OBSOLETE,
+        RESULT_CORRUPT
+    };
+
+    // Writes aside and renames into place, so a second viewer instance
+    // never maps a partial file. cache_version is the version of the
+    // inventory data the caller expects back in read().
+    static bool write(const std::string& filename, S32 cache_version,
+                      const std::vector<Category>& categories,
+                      const std::vector<Item>& items);
+
+    // Categories and items come back in the order they were written.
+    // Nothing is returned unless the result is RESULT_OK.
+    static EResult read(const std::string& filename, S32 cache_version,
+                        std::vector<Category>& categories,
+                        std::vector<Item>& items);
+};
+
+#endif // LL_LLINVENTORYCACHE_H
@@ -0,0 +1,222 @@
+/**
+ * @file llinventorystore.h
+ * @brief UUID keyed storage of inventory objects with stable handles.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLINVENTORYSTORE_H
+#define LL_LLINVENTORYSTORE_H
+
+#include <vector>
+#include <boost/unordered/unordered_flat_map.hpp>
+
+#include "llpointer.h"
+#include "lluuid.h"
+
+// Refers to an object in an LLInventoryStore. A handle stays valid while
+// other objects are added and removed, and keeps referring to whatever is
+// stored under the same UUID when the object is replaced. Once the UUID is
+// removed the handle goes stale for good: its slot may be reused, but with
+// another generation.
+class LLInventoryHandle
+{
+public:
+    LLInventoryHandle()
+    :   mSlot(0),
+        mGeneration(0)
+    {
+    }
+
+    bool isNull() const { return mGeneration == 0; }
+
+    bool operator==(const LLInventoryHandle& rhs) const
+    {
+        return mSlot == rhs.mSlot && mGeneration == rhs.mGeneration;
+    }
+    bool operator!=(const LLInventoryHandle& rhs) const { return !(*this == rhs); }
+
+private:
+    template<typename T> friend class LLInventoryStore;
+
+    LLInventoryHandle(U32 slot, U32 generation)
+    :   mSlot(slot),
+        mGeneration(generation)
+    {
+    }
+
+    U32 mSlot;
+    U32 mGeneration;
+};
+
+// Inventory objects by UUID. The UUIDs are indexed in an open addressing
+// hash map, the objects themselves are kept in one dense array, so walking
+// every object touches contiguous memory. Removing an object moves the
+// last one into its place: iteration order is not stable, handles are.
+template<typename T>
+class LLInventoryStore
+{
+public:
+    typedef LLPointer<T> pointer_t;
+    typedef typename std::vector<pointer_t>::const_iterator const_iterator;
+
+    // Returns NULL when there is no object with this UUID.
+    T* find(const LLUUID& id) const
+    {
+        typename index_t::const_iterator found = mIndex.find(id);
+        return found == mIndex.end() ? NULL : mObjects[mSlots[found->second].mDense].get();
+    }
+
+    bool contains(const LLUUID& id) const { return mIndex.contains(id); }
+
+    // Returns a null handle when there is no object with this UUID.
+    LLInventoryHandle getHandle(const LLUUID& id) const
+    {
+        typename index_t::const_iterator found = mIndex.find(id);
+        if (found == mIndex.end())
+        {
+            return LLInventoryHandle();
+        }
+        return LLInventoryHandle(found->second, mSlots[found->second].mGeneration);
+    }
+
+    // Returns NULL for null and stale handles.
+    T* get(const LLInventoryHandle& handle) const
+    {
+        if (handle.mSlot >= mSlots.size())
+        {
+            return NULL;
+        }
+        const Slot& slot = mSlots[handle.mSlot];
+        return slot.mGeneration == handle.mGeneration ? mObjects[slot.mDense].get() : NULL;
+    }
+
+    // Adds the object, or replaces the one already stored under id, in
+    // which case handles to it now refer to the new object.
+    LLInventoryHandle insert(const LLUUID& id, T* object)
+    {
+        std::pair<typename index_t::iterator, bool> inserted = mIndex.try_emplace(id, 0);
+        if (!inserted.second)
+        {
+            const U32 index = inserted.first->second;
+            mObjects[mSlots[index].mDense] = object;
+            return LLInventoryHandle(index, mSlots[index].mGeneration);
+        }
+
+        U32 index;
+        if (mFreeSlots.empty())
+        {
+            index = (U32)mSlots.size();
+            mSlots.push_back(Slot{ 0, 1 });
+        }
+        else
+        {
+            index = mFreeSlots.back();
+            mFreeSlots.pop_back();
+        }
+        inserted.first->second = index;
+        mSlots[index].mDense = (U32)mObjects.size();
+        mObjects.push_back(object);
+        mObjectSlots.push_back(index);
+        return LLInventoryHandle(index, mSlots[index].mGeneration);
+    }
+
+    // Returns false when there was no object with this UUID.
+    bool erase(const LLUUID& id)
+    {
+        typename index_t::iterator found = mIndex.find(id);
+        if (found == mIndex.end())
+        {
+            return false;
+        }
+        const U32 index = found->second;
+        mIndex.erase(found);
+
+        // Fill the hole with the last object
+        Slot& slot = mSlots[index];
+        const U32 last = (U32)mObjects.size() - 1;
+        if (slot.mDense != last)
+        {
+            mObjects[slot.mDense] = std::move(mObjects[last]);
+            mObjectSlots[slot.mDense] = mObjectSlots[last];
+            mSlots[mObjectSlots[last]].mDense = slot.mDense;
+        }
+        mObjects.pop_back();
+        mObjectSlots.pop_back();
+
+        // Generation 0 is reserved for null handles
+        if (++slot.mGeneration == 0)
+        {
+            slot.mGeneration = 1;
+        }
+        mFreeSlots.push_back(index);
+        return true;
+    }
+
+    void clear()
+    {
+        mIndex.clear();
+        mObjects.clear();
+        mObjectSlots.clear();
+        // Keep the generations so that older handles stay stale
+        mFreeSlots.clear();
+        for (U32 index = (U32)mSlots.size(); index-- > 0; )
+        {
+            Slot& slot = mSlots[index];
+            if (++slot.mGeneration == 0)
+            {
+                slot.mGeneration = 1;
+            }
+            mFreeSlots.push_back(index);
+        }
+    }
+
+    void reserve(size_t count)
+    {
+        mIndex.reserve(count);
+        mObjects.reserve(count);
+        mObjectSlots.reserve(count);
+    }
+
+    size_t size() const { return mObjects.size(); }
+    bool empty() const { return mObjects.empty(); }
+
+    const_iterator begin() const { return mObjects.begin(); }
+    const_iterator end() const { return mObjects.end(); }
+
+private:
+    struct Slot
+    {
+        U32 mDense;         // Index in mObjects while in use
+        U32 mGeneration;
+    };
+
+    typedef boost::unordered_flat_map<LLUUID, U32> index_t;
+
+    index_t mIndex;                     // UUID to slot
+    std::vector<Slot> mSlots;
+    std::vector<U32> mFreeSlots;
+    std::vector<pointer_t> mObjects;
+    std::vector<U32> mObjectSlots;      // Slot of each object in mObjects
+};
+
+#endif // LL_LLINVENTORYSTORE_H
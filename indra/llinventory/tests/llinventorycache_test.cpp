@@ -0,0 +1,271 @@
+/**
+ * @file   llinventorycache_test.cpp
+ * @brief  Binary inventory cache round trips, rejection of stale and
+ *         damaged files.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include <random>
+#include <vector>
+
+#include "../llinventory.h"
+#include "../llinventorycache.h"
+#include "llfile.h"
+#include "../test/lltut.h"
+
+namespace
+{
+    const S32 CACHE_VERSION = 3;
+
+    LLUUID random_id(std::mt19937& rng)
+    {
+        LLUUID id;
+        for (U32 i = 0; i < UUID_BYTES; ++i)
+        {
+            id.mData[i] = (U8)(rng() & 0xff);
+        }
+        return id;
+    }
+
+    void make_inventory(std::mt19937& rng, U32 num_categories, U32 num_items,
+                        std::vector<LLInventoryCacheFile::Category>& categories,
+                        std::vector<LLInventoryCacheFile::Item>& items)
+    {
+        const LLUUID owner_id = random_id(rng);
+        const LLUUID group_id = random_id(rng);
+        std::uniform_int_distribution<U32> pick(0, 9);
+
+        categories.resize(num_categories);
+        for (U32 i = 0; i < num_categories; ++i)
+        {
+            LLInventoryCacheFile::Category& cat = categories[i];
+            cat.mUUID = random_id(rng);
+            cat.mParentUUID = i ? categories[rng() % i].mUUID : LLUUID::null;
+            cat.mThumbnailUUID = pick(rng) == 0 ? random_id(rng) : LLUUID::null;
+            cat.mOwnerID = owner_id;
+            cat.mName = llformat("Folder %u", i);
+            cat.mVersion = (S32)(rng() % 500);
+            cat.mPreferredType = pick(rng) == 0 ? LLFolderType::FT_OUTFIT : LLFolderType::FT_NONE;
+        }
+
+        items.resize(num_items);
+        for (U32 i = 0; i < num_items; ++i)
+        {
+            LLInventoryCacheFile::Item& item = items[i];
+            item.mUUID = random_id(rng);
+            item.mParentUUID = categories[rng() % num_categories].mUUID;
+            item.mAssetUUID = random_id(rng);
+            item.mThumbnailUUID = pick(rng) == 0 ? random_id(rng) : LLUUID::null;
+
+            // Every tenth item deeded to a group
+            const bool group_owned = pick(rng) == 0;
+            item.mPermissions.init(random_id(rng), group_owned ? LLUUID::null : owner_id, random_id(rng), group_id);
+            item.mPermissions.initMasks(PERM_ALL, PERM_ALL, PERM_NONE, PERM_COPY, PERM_MOVE | PERM_TRANSFER);
+            item.mPermissions.fix();
+
+            item.mSaleInfo = LLSaleInfo(pick(rng) == 0 ? LLSaleInfo::FS_COPY : LLSaleInfo::FS_NOT, (S32)(rng() % 1000));
+            item.mName = llformat("Item %u", i);
+            item.mDescription = pick(rng) < 3 ? llformat("(No Description) %u", rng()) : std::string();
+            item.mFlags = rng();
+            item.mCreationDate = (time_t)(1200000000 + rng() % 500000000);
+            item.mType = pick(rng) < 5 ? LLAssetType::AT_OBJECT : LLAssetType::AT_CLOTHING;
+            item.mInventoryType = item.mType == LLAssetType::AT_OBJECT ? LLInventoryType::IT_OBJECT : LLInventoryType::IT_WEARABLE;
+        }
+    }
+
+    bool same_category(const LLInventoryCacheFile::Category& a, const LLInventoryCacheFile::Category& b)
+    {
+        return a.mUUID == b.mUUID && a.mParentUUID == b.mParentUUID && a.mThumbnailUUID == b.mThumbnailUUID
+            && a.mOwnerID == b.mOwnerID && a.mName == b.mName && a.mVersion == b.mVersion
+            && a.mPreferredType == b.mPreferredType;
+    }
+
+    bool same_item(const LLInventoryCacheFile::Item& a, const LLInventoryCacheFile::Item& b)
+    {
+        return a.mUUID == b.mUUID && a.mParentUUID == b.mParentUUID && a.mAssetUUID == b.mAssetUUID
+            && a.mThumbnailUUID == b.mThumbnailUUID && a.mPermissions == b.mPermissions
+            && a.mPermissions.isGroupOwned() == b.mPermissions.isGroupOwned()
+            && a.mSaleInfo == b.mSaleInfo && a.mName == b.mName && a.mDescription == b.mDescription
+            && a.mFlags == b.mFlags && a.mCreationDate == b.mCreationDate && a.mType == b.mType
+            && a.mInventoryType == b.mInventoryType;
+    }
+
+    std::vector<U8> read_file(const std::string& filename)
+    {
+        std::vector<U8> data;
+        LLFILE* fp = LLFile::fopen(filename, "rb");
+        if (fp)
+        {
+            U8 buffer[4096];
+            size_t count;
+            while ((count = fread(buffer, 1, sizeof(buffer), fp)) > 0)
+            {
+                data.insert(data.end(), buffer, buffer + count);
+            }
+            LLFile::close(fp);
+        }
+        return data;
+    }
+
+    void write_file(const std::string& filename, const std::vector<U8>& data)
+    {
+        LLFILE* fp = LLFile::fopen(filename, "wb");
+        if (fp)
+        {
+            fwrite(data.data(), 1, data.size(), fp);
+            LLFile::close(fp);
+        }
+    }
+}
+
+namespace tut
+{
+    struct inventorycache_data
+    {
+        std::string mFilename;
+        std::mt19937 mRNG;
+
+        inventorycache_data()
+        :   mRNG(1357)
+        {
+            mFilename = std::string(LLFile::tmpdir()) + "llinventorycache_test.inv.bin";
+            LLFile::remove(mFilename, ENOENT);
+        }
+
+        ~inventorycache_data()
+        {
+            LLFile::remove(mFilename, ENOENT);
+        }
+    };
+    typedef test_group<inventorycache_data> inventorycache_group;
+    typedef inventorycache_group::object inventorycache_object;
+    tut::inventorycache_group inventorycache_testgroup("LLInventoryCacheFile");
+
+    template<> template<>
+    void inventorycache_object::test<1>()
+    {
+        set_test_name("categories and items read back as written");
+
+        // Enough for several blocks of each
+        std::vector<LLInventoryCacheFile::Category> categories;
+        std::vector<LLInventoryCacheFile::Item> items;
+        make_inventory(mRNG, 3000, 10000, categories, items);
+        categories[5].mName.clear();
+        items[7].mName = "Sch\xc3\xb6ne Gr\xc3\xbc\xc3\x9f" "e";
+
+        ensure("written", LLInventoryCacheFile::write(mFilename, CACHE_VERSION, categories, items));
+
+        std::vector<LLInventoryCacheFile::Category> read_categories;
+        std::vector<LLInventoryCacheFile::Item> read_items;
+        ensure_equals("read", LLInventoryCacheFile::read(mFilename, CACHE_VERSION, read_categories, read_items),
+                      LLInventoryCacheFile::RESULT_OK);
+        ensure_equals("category count", read_categories.size(), categories.size());
+        ensure_equals("item count", read_items.size(), items.size());
+        for (size_t i = 0; i < categories.size(); ++i)
+        {
+            ensure("same category", same_category(categories[i], read_categories[i]));
+        }
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+            ensure("same item", same_item(items[i], read_items[i]));
+        }
+    }
+
+    template<> template<>
+    void inventorycache_object::test<2>()
+    {
+        set_test_name("empty inventory, missing and stale files");
+
+        std::vector<LLInventoryCacheFile::Category> categories;
+        std::vector<LLInventoryCacheFile::Item> items;
+        ensure_equals("missing", LLInventoryCacheFile::read(mFilename, CACHE_VERSION, categories, items),
+                      LLInventoryCacheFile::RESULT_MISSING);
+
+        ensure("written empty", LLInventoryCacheFile::write(mFilename, CACHE_VERSION, categories, items));
+        ensure_equals("read empty", LLInventoryCacheFile::read(mFilename, CACHE_VERSION, categories, items),
+                      LLInventoryCacheFile::RESULT_OK);
+        ensure("nothing read", categories.empty() && items.empty());
+
+        make_inventory(mRNG, 10, 100, categories, items);
+        ensure("written", LLInventoryCacheFile::write(mFilename, CACHE_VERSION, categories, items));
+
+        std::vector<LLInventoryCacheFile::Category> read_categories;
+        std::vector<LLInventoryCacheFile::Item> read_items;
+        ensure_equals("other cache version", LLInventoryCacheFile::read(mFilename, CACHE_VERSION + 1, read_categories, read_items),
+                      LLInventoryCacheFile::RESULT_OBSOLETE);
+        ensure("nothing read when stale", read_categories.empty() && read_items.empty());
+    }
+
+    template<> template<>
+    void inventorycache_object::test<3>()
+    {
+        set_test_name("damaged files are rejected");
+
+        std::vector<LLInventoryCacheFile::Category> categories;
+        std::vector<LLInventoryCacheFile::Item> items;
+        make_inventory(mRNG, 100, 5000, categories, items);
+        ensure("written", LLInventoryCacheFile::write(mFilename, CACHE_VERSION, categories, items));
+        const std::vector<U8> data = read_file(mFilename);
+        ensure("have data", data.size() > 1000);
+
+        std::vector<LLInventoryCacheFile::Category> read_categories;
+        std::vector<LLInventoryCacheFile::Item> read_items;
+
+        std::vector<U8> truncated(data.begin(), data.begin() + data.size() / 2);
+        write_file(mFilename, truncated);
+        ensure_equals("truncated", LLInventoryCacheFile::read(mFilename, CACHE_VERSION, read_categories, read_items),
+                      LLInventoryCacheFile::RESULT_CORRUPT);
+
+        std::vector<U8> bad_magic(data);
+        bad_magic[0] = 'X';
+        write_file(mFilename, bad_magic);
+        ensure_equals("bad magic", LLInventoryCacheFile::read(mFilename, CACHE_VERSION, read_categories, read_items),
+                      LLInventoryCacheFile::RESULT_CORRUPT);
+
+        // Counts in the header and the first block header
+        std::vector<U8> bad_count(data);
+        bad_count[16] ^= 0x5a;
+        write_file(mFilename, bad_count);
+        ensure_equals("bad item count", LLInventoryCacheFile::read(mFilename, CACHE_VERSION, read_categories, read_items),
+                      LLInventoryCacheFile::RESULT_CORRUPT);
+
+        std::vector<U8> bad_block(data);
+        bad_block[24 + 20] = 0xff;
+        bad_block[24 + 21] = 0xff;
+        write_file(mFilename, bad_block);
+        ensure_equals("bad block count", LLInventoryCacheFile::read(mFilename, CACHE_VERSION, read_categories, read_items),
+                      LLInventoryCacheFile::RESULT_CORRUPT);
+
+        std::vector<U8> bad_payload(data);
+        for (size_t i = data.size() - 64; i < data.size(); ++i)
+        {
+            bad_payload[i] ^= 0xa5;
+        }
+        write_file(mFilename, bad_payload);
+        ensure_equals("bad payload", LLInventoryCacheFile::read(mFilename, CACHE_VERSION, read_categories, read_items),
+                      LLInventoryCacheFile::RESULT_CORRUPT);
+        ensure("nothing read when damaged", read_categories.empty() && read_items.empty());
+    }
+}
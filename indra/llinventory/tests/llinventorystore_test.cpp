@@ -0,0 +1,483 @@
+/**
+ * @file   llinventorystore_test.cpp
+ * @brief  LLInventoryStore lookups and handles, and typical inventory
+ *         operations checked against the std::map storage it replaces.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include <map>
+#include <random>
+#include <vector>
+
+#include "../llinventory.h"
+#include "../llinventorystore.h"
+#include "llstl.h"
+#include "../test/lltut.h"
+
+namespace
+{
+    const U32 NUM_CATEGORIES = 200;
+    const U32 NUM_ITEMS = 5000;
+    // Links in the current outfit folder
+    const U32 NUM_COF_LINKS = 60;
+
+    typedef std::vector<LLPointer<LLInventoryCategory> > cat_array_t;
+    typedef std::vector<LLPointer<LLInventoryItem> > item_array_t;
+
+    LLUUID random_id(std::mt19937& rng)
+    {
+        LLUUID id;
+        for (U32 i = 0; i < UUID_BYTES; ++i)
+        {
+            id.mData[i] = (U8)(rng() & 0xff);
+        }
+        return id;
+    }
+
+    // Categories and items as LLInventoryModel used to keep them
+    struct MapInventory
+    {
+        std::map<LLUUID, LLPointer<LLInventoryCategory> > mCategories;
+        std::map<LLUUID, LLPointer<LLInventoryItem> > mItems;
+        std::map<LLUUID, cat_array_t*> mChildCategories;
+        std::map<LLUUID, item_array_t*> mChildItems;
+
+        ~MapInventory()
+        {
+            for (auto& entry : mChildCategories)
+            {
+                delete entry.second;
+            }
+            for (auto& entry : mChildItems)
+            {
+                delete entry.second;
+            }
+        }
+
+        void addCategory(LLInventoryCategory* cat)
+        {
+            mCategories[cat->getUUID()] = cat;
+            mChildCategories[cat->getUUID()] = new cat_array_t;
+            mChildItems[cat->getUUID()] = new item_array_t;
+            if (cat_array_t* siblings = get_ptr_in_map(mChildCategories, cat->getParentUUID()))
+            {
+                siblings->push_back(cat);
+            }
+        }
+
+        void addItem(LLInventoryItem* item)
+        {
+            mItems[item->getUUID()] = item;
+            if (item_array_t* siblings = get_ptr_in_map(mChildItems, item->getParentUUID()))
+            {
+                siblings->push_back(item);
+            }
+        }
+
+        LLInventoryItem* getItem(const LLUUID& id) const
+        {
+            auto found = mItems.find(id);
+            return found == mItems.end() ? NULL : found->second.get();
+        }
+
+        void getDirectDescendentsOf(const LLUUID& id, cat_array_t*& cats, item_array_t*& items) const
+        {
+            cats = get_ptr_in_map(mChildCategories, id);
+            items = get_ptr_in_map(mChildItems, id);
+        }
+    };
+
+    // And as it keeps them now
+    struct StoreInventory
+    {
+        struct ChildArrays
+        {
+            cat_array_t* mCategories = NULL;
+            item_array_t* mItems = NULL;
+        };
+
+        LLInventoryStore<LLInventoryCategory> mCategories;
+        LLInventoryStore<LLInventoryItem> mItems;
+        boost::unordered_flat_map<LLUUID, ChildArrays> mChildren;
+
+        ~StoreInventory()
+        {
+            for (auto& entry : mChildren)
+            {
+                delete entry.second.mCategories;
+                delete entry.second.mItems;
+            }
+        }
+
+        void addCategory(LLInventoryCategory* cat)
+        {
+            mCategories.insert(cat->getUUID(), cat);
+            ChildArrays& children = mChildren[cat->getUUID()];
+            children.mCategories = new cat_array_t;
+            children.mItems = new item_array_t;
+            auto parent = mChildren.find(cat->getParentUUID());
+            if (parent != mChildren.end())
+            {
+                parent->second.mCategories->push_back(cat);
+            }
+        }
+
+        void addItem(LLInventoryItem* item)
+        {
+            mItems.insert(item->getUUID(), item);
+            auto parent = mChildren.find(item->getParentUUID());
+            if (parent != mChildren.end())
+            {
+                parent->second.mItems->push_back(item);
+            }
+        }
+
+        LLInventoryItem* getItem(const LLUUID& id) const
+        {
+            return mItems.find(id);
+        }
+
+        void getDirectDescendentsOf(const LLUUID& id, cat_array_t*& cats, item_array_t*& items) const
+        {
+            auto found = mChildren.find(id);
+            cats = found == mChildren.end() ? NULL : found->second.mCategories;
+            items = found == mChildren.end() ? NULL : found->second.mItems;
+        }
+    };
+
+    // Every tenth item is a link to another one, the first folder is the
+    // root and the second one the current outfit folder.
+    template<typename INVENTORY>
+    void make_inventory(U32 seed, INVENTORY& inventory)
+    {
+        std::mt19937 rng(seed);
+        std::vector<LLUUID> cat_ids(NUM_CATEGORIES);
+        for (U32 i = 0; i < NUM_CATEGORIES; ++i)
+        {
+            cat_ids[i] = random_id(rng);
+            const LLUUID parent_id = i ? cat_ids[rng() % i] : LLUUID::null;
+            const LLFolderType::EType type = i == 1 ? LLFolderType::FT_CURRENT_OUTFIT : LLFolderType::FT_NONE;
+            inventory.addCategory(new LLInventoryCategory(cat_ids[i], parent_id, type, llformat("Folder %u", i)));
+        }
+
+        // Links never point at links, the first few live in the current
+        // outfit folder.
+        std::vector<LLUUID> item_ids(NUM_ITEMS);
+        std::vector<bool> is_link(NUM_ITEMS);
+        for (U32 i = 0; i < NUM_ITEMS; ++i)
+        {
+            item_ids[i] = random_id(rng);
+            is_link[i] = i < NUM_COF_LINKS || rng() % 10 == 0;
+        }
+
+        LLPermissions perm;
+        perm.init(random_id(rng), random_id(rng), LLUUID::null, LLUUID::null);
+        for (U32 i = 0; i < NUM_ITEMS; ++i)
+        {
+            const LLUUID parent_id = i < NUM_COF_LINKS ? cat_ids[1] : cat_ids[2 + rng() % (NUM_CATEGORIES - 2)];
+            LLUUID asset_id = random_id(rng);
+            LLAssetType::EType type = rng() % 2 ? LLAssetType::AT_OBJECT : LLAssetType::AT_CLOTHING;
+            if (is_link[i])
+            {
+                U32 target;
+                do
+                {
+                    target = rng() % NUM_ITEMS;
+                } while (is_link[target]);
+                asset_id = item_ids[target];
+                type = LLAssetType::AT_LINK;
+            }
+            inventory.addItem(new LLInventoryItem(item_ids[i], parent_id, perm, asset_id, type, LLInventoryType::IT_OBJECT,
+                                                  llformat("Item %u", i), std::string(), LLSaleInfo::DEFAULT, 0, 0));
+        }
+    }
+
+    // LLInventoryModel::collectDescendentsIf(), looking for clothing
+    template<typename INVENTORY>
+    void collect_clothing(const INVENTORY& inventory, const LLUUID& id, item_array_t& found)
+    {
+        cat_array_t* cats;
+        item_array_t* items;
+        inventory.getDirectDescendentsOf(id, cats, items);
+        if (items)
+        {
+            for (const LLPointer<LLInventoryItem>& item : *items)
+            {
+                if (item->getType() == LLAssetType::AT_CLOTHING)
+                {
+                    found.push_back(item);
+                }
+            }
+        }
+        if (cats)
+        {
+            for (const LLPointer<LLInventoryCategory>& cat : *cats)
+            {
+                collect_clothing(inventory, cat->getUUID(), found);
+            }
+        }
+    }
+
+    // LLViewerInventoryItem::getLinkedItem() on every link
+    template<typename INVENTORY>
+    U32 resolve_links(const INVENTORY& inventory, const item_array_t& links)
+    {
+        U32 resolved = 0;
+        for (const LLPointer<LLInventoryItem>& link : links)
+        {
+            if (inventory.getItem(link->getAssetUUID()))
+            {
+                ++resolved;
+            }
+        }
+        return resolved;
+    }
+
+    // What the appearance manager asks of the current outfit folder
+    template<typename INVENTORY>
+    U32 query_cof(const INVENTORY& inventory, const LLUUID& cof_id)
+    {
+        U32 worn = 0;
+        cat_array_t* cats;
+        item_array_t* items;
+        inventory.getDirectDescendentsOf(cof_id, cats, items);
+        for (const LLPointer<LLInventoryItem>& link : *items)
+        {
+            LLInventoryItem* item = inventory.getItem(link->getAssetUUID());
+            if (item && item->getType() != LLAssetType::AT_LINK)
+            {
+                ++worn;
+            }
+        }
+        return worn;
+    }
+
+    // Items of either storage while iterating
+    const LLPointer<LLInventoryItem>& entry_pointer(const std::pair<const LLUUID, LLPointer<LLInventoryItem> >& entry)
+    {
+        return entry.second;
+    }
+    const LLPointer<LLInventoryItem>& entry_pointer(const LLPointer<LLInventoryItem>& entry)
+    {
+        return entry;
+    }
+}
+
+namespace tut
+{
+    struct inventorystore_data
+    {
+        std::mt19937 mRNG;
+
+        inventorystore_data()
+        :   mRNG(2468)
+        {
+        }
+
+        LLPointer<LLInventoryItem> makeItem(const std::string& name)
+        {
+            LLPointer<LLInventoryItem> item = new LLInventoryItem;
+            item->setUUID(random_id(mRNG));
+            item->rename(name);
+            return item;
+        }
+    };
+    typedef test_group<inventorystore_data> inventorystore_group;
+    typedef inventorystore_group::object inventorystore_object;
+    tut::inventorystore_group inventorystore_testgroup("LLInventoryStore");
+
+    template<> template<>
+    void inventorystore_object::test<1>()
+    {
+        set_test_name("objects found by UUID");
+
+        LLInventoryStore<LLInventoryItem> store;
+        ensure("starts empty", store.empty());
+        std::vector<LLPointer<LLInventoryItem> > items;
+        for (U32 i = 0; i < 1000; ++i)
+        {
+            items.push_back(makeItem(llformat("Item %u", i)));
+            store.insert(items.back()->getUUID(), items.back());
+        }
+        ensure_equals("size", store.size(), items.size());
+        for (const LLPointer<LLInventoryItem>& item : items)
+        {
+            ensure("found", store.find(item->getUUID()) == item.get());
+            ensure("contained", store.contains(item->getUUID()));
+        }
+        ensure("unknown UUID", store.find(random_id(mRNG)) == NULL);
+        ensure("null UUID", store.find(LLUUID::null) == NULL);
+
+        // Replacing keeps the count
+        LLPointer<LLInventoryItem> replacement = new LLInventoryItem(items[10]);
+        store.insert(replacement->getUUID(), replacement);
+        ensure_equals("size after replace", store.size(), items.size());
+        ensure("replaced", store.find(items[10]->getUUID()) == replacement.get());
+
+        // Every other one removed, the rest still found
+        for (size_t i = 0; i < items.size(); i += 2)
+        {
+            ensure("erased", store.erase(items[i]->getUUID()));
+        }
+        ensure("erased twice", !store.erase(items[0]->getUUID()));
+        ensure_equals("size after erase", store.size(), items.size() / 2);
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+            ensure("found after erase", (store.find(items[i]->getUUID()) != NULL) == (i % 2 == 1));
+        }
+
+        // Iteration covers every object once
+        U32 count = 0;
+        for (const LLPointer<LLInventoryItem>& item : store)
+        {
+            ensure("iterated object found", store.find(item->getUUID()) == item.get());
+            ++count;
+        }
+        ensure_equals("iterated", (size_t)count, store.size());
+
+        store.clear();
+        ensure("cleared", store.empty() && store.find(items[1]->getUUID()) == NULL);
+    }
+
+    template<> template<>
+    void inventorystore_object::test<2>()
+    {
+        set_test_name("handles are stable and go stale");
+
+        LLInventoryStore<LLInventoryItem> store;
+        std::vector<LLPointer<LLInventoryItem> > items;
+        std::vector<LLInventoryHandle> handles;
+        for (U32 i = 0; i < 1000; ++i)
+        {
+            items.push_back(makeItem(llformat("Item %u", i)));
+            handles.push_back(store.insert(items.back()->getUUID(), items.back()));
+            ensure("handle", handles.back() == store.getHandle(items.back()->getUUID()));
+        }
+        ensure("null handle", store.get(LLInventoryHandle()) == NULL);
+        ensure("unknown UUID", store.getHandle(random_id(mRNG)).isNull());
+
+        // Remove a third, then add as many again: slots get reused
+        for (size_t i = 0; i < items.size(); i += 3)
+        {
+            store.erase(items[i]->getUUID());
+        }
+        std::vector<LLPointer<LLInventoryItem> > added;
+        for (U32 i = 0; i < 400; ++i)
+        {
+            added.push_back(makeItem(llformat("Added %u", i)));
+            store.insert(added.back()->getUUID(), added.back());
+        }
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+            if (i % 3 == 0)
+            {
+                ensure("stale", store.get(handles[i]) == NULL);
+            }
+            else
+            {
+                ensure("stable", store.get(handles[i]) == items[i].get());
+            }
+        }
+
+        // Replacing keeps the handle, adding back under the same UUID
+        // does not bring the old one back.
+        LLPointer<LLInventoryItem> replacement = new LLInventoryItem(items[1]);
+        ensure("same handle on replace", store.insert(replacement->getUUID(), replacement) == handles[1]);
+        ensure("handle follows replacement", store.get(handles[1]) == replacement.get());
+        LLInventoryHandle readded = store.insert(items[0]->getUUID(), items[0]);
+        ensure("new handle", readded != handles[0]);
+        ensure("old handle still stale", store.get(handles[0]) == NULL);
+        ensure("new handle valid", store.get(readded) == items[0].get());
+
+        store.clear();
+        ensure("stale after clear", store.get(handles[1]) == NULL && store.get(readded) == NULL);
+        LLInventoryHandle after_clear = store.insert(items[1]->getUUID(), items[1]);
+        ensure("no handle from before the clear", after_clear != handles[1] && after_clear != readded);
+    }
+
+    template<> template<>
+    void inventorystore_object::test<3>()
+    {
+        set_test_name("inventory operations match the std::map storage");
+
+        MapInventory map_inventory;
+        StoreInventory store_inventory;
+        make_inventory(1357, map_inventory);
+        make_inventory(1357, store_inventory);
+
+        const LLUUID root_id = (*store_inventory.mCategories.begin())->getUUID();
+        LLUUID cof_id;
+        for (const LLPointer<LLInventoryCategory>& cat : store_inventory.mCategories)
+        {
+            if (cat->getPreferredType() == LLFolderType::FT_CURRENT_OUTFIT)
+            {
+                cof_id = cat->getUUID();
+            }
+        }
+
+        item_array_t map_clothing;
+        item_array_t store_clothing;
+        collect_clothing(map_inventory, root_id, map_clothing);
+        collect_clothing(store_inventory, root_id, store_clothing);
+        ensure("clothing found", !store_clothing.empty());
+        ensure_equals("same items collected", store_clothing.size(), map_clothing.size());
+
+        item_array_t map_links;
+        item_array_t store_links;
+        for (const auto& entry : map_inventory.mItems)
+        {
+            if (entry_pointer(entry)->getType() == LLAssetType::AT_LINK)
+            {
+                map_links.push_back(entry_pointer(entry));
+            }
+        }
+        for (const auto& entry : store_inventory.mItems)
+        {
+            if (entry_pointer(entry)->getType() == LLAssetType::AT_LINK)
+            {
+                store_links.push_back(entry_pointer(entry));
+            }
+        }
+        const U32 resolved = resolve_links(store_inventory, store_links);
+        ensure_equals("every link resolved", (size_t)resolved, store_links.size());
+        ensure_equals("same links resolved", resolved, resolve_links(map_inventory, map_links));
+
+        // Resolving links through handles kept on the side, as
+        // LLViewerInventoryItem does
+        U32 handle_resolved = 0;
+        for (const LLPointer<LLInventoryItem>& link : store_links)
+        {
+            LLInventoryItem* item = store_inventory.mItems.get(store_inventory.mItems.getHandle(link->getAssetUUID()));
+            if (item && item == store_inventory.getItem(link->getAssetUUID()))
+            {
+                ++handle_resolved;
+            }
+        }
+        ensure_equals("every link resolved by handle", handle_resolved, resolved);
+
+        ensure_equals("every COF link worn", query_cof(store_inventory, cof_id), NUM_COF_LINKS);
+        ensure_equals("same COF", query_cof(map_inventory, cof_id), NUM_COF_LINKS);
+    }
+}
@@ -29,6 +29,10 @@
 #include "llmath.h"
 #include "llcamera.h"
 
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
 // ---------------- Constructors and destructors ----------------
 
 LLCamera::LLCamera() :
@@ -317,6 +321,179 @@ S32 LLCamera::AABBInRegionFrustumNoFarClip(const LLVector4a& center, const LLVec
     return AABBInFrustumNoFarClip(center, radius, mRegionPlanes);
 }
 
+namespace
+{
+    // A frustum plane splatted across the lanes of a batched box test. The
+    // per axis sign comes from sFrustumScaler so the arithmetic matches the
+    // single box tests.
+    struct BatchPlane
+    {
+        F32 mNormal[3];
+        F32 mScale[3];
+        F32 mNegD;
+    };
+
+    // Test 4 boxes, given as x, y and z lanes of their centers and radii,
+    // against planes. Returns the lanes that are outside any plane and the
+    // lanes that cross at least one plane as bit masks.
+    inline void test_boxes_sse(const LLQuad* c, const LLQuad* r, const BatchPlane* planes, U32 plane_count,
+                               U32& outside_bits, U32& partial_bits)
+    {
+        __m128 outside = _mm_setzero_ps();
+        __m128 partial = _mm_setzero_ps();
+        for (U32 i = 0; i < plane_count; ++i)
+        {
+            const BatchPlane& p = planes[i];
+            __m128 dmin = _mm_setzero_ps();
+            __m128 dmax = _mm_setzero_ps();
+            for (U32 axis = 0; axis < 3; ++axis)
+            {
+                const __m128 n = _mm_set1_ps(p.mNormal[axis]);
+                const __m128 rscale = _mm_mul_ps(r[axis], _mm_set1_ps(p.mScale[axis]));
+                dmin = _mm_add_ps(dmin, _mm_mul_ps(n, _mm_sub_ps(c[axis], rscale)));
+                dmax = _mm_add_ps(dmax, _mm_mul_ps(n, _mm_add_ps(c[axis], rscale)));
+            }
+            const __m128 neg_d = _mm_set1_ps(p.mNegD);
+            outside = _mm_or_ps(outside, _mm_cmpgt_ps(dmin, neg_d));
+            partial = _mm_or_ps(partial, _mm_cmpgt_ps(dmax, neg_d));
+        }
+        outside_bits = _mm_movemask_ps(outside);
+        partial_bits = _mm_movemask_ps(partial);
+    }
+
+#if defined(__AVX__)
+    // 8 lane version of test_boxes_sse()
+    inline void test_boxes_avx(const __m256* c, const __m256* r, const BatchPlane* planes, U32 plane_count,
+                               U32& outside_bits, U32& partial_bits)
+    {
+        __m256 outside = _mm256_setzero_ps();
+        __m256 partial = _mm256_setzero_ps();
+        for (U32 i = 0; i < plane_count; ++i)
+        {
+            const BatchPlane& p = planes[i];
+            __m256 dmin = _mm256_setzero_ps();
+            __m256 dmax = _mm256_setzero_ps();
+            for (U32 axis = 0; axis < 3; ++axis)
+            {
+                const __m256 n = _mm256_set1_ps(p.mNormal[axis]);
+                const __m256 rscale = _mm256_mul_ps(r[axis], _mm256_set1_ps(p.mScale[axis]));
+                dmin = _mm256_add_ps(dmin, _mm256_mul_ps(n, _mm256_sub_ps(c[axis], rscale)));
+                dmax = _mm256_add_ps(dmax, _mm256_mul_ps(n, _mm256_add_ps(c[axis], rscale)));
+            }
+            const __m256 neg_d = _mm256_set1_ps(p.mNegD);
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(dmin, neg_d, _CMP_GT_OQ));
+            partial = _mm256_or_ps(partial, _mm256_cmp_ps(dmax, neg_d, _CMP_GT_OQ));
+        }
+        outside_bits = _mm256_movemask_ps(outside);
+        partial_bits = _mm256_movemask_ps(partial);
+    }
+#endif
+
+    // Transpose up to 4 boxes starting at first into x, y and z lanes.
+    // Missing boxes are zero sized boxes at the origin, their results are
+    // never written.
+    inline void load_boxes(const LLVector4a* centers, const LLVector4a* radii, U32 first, U32 count,
+                           LLQuad* c, LLQuad* r)
+    {
+        LLQuad cq[4], rq[4];
+        for (U32 i = 0; i < 4; ++i)
+        {
+            const bool valid = first + i < count;
+            cq[i] = valid ? (LLQuad)centers[first + i] : _mm_setzero_ps();
+            rq[i] = valid ? (LLQuad)radii[first + i] : _mm_setzero_ps();
+        }
+        _MM_TRANSPOSE4_PS(cq[0], cq[1], cq[2], cq[3]);
+        _MM_TRANSPOSE4_PS(rq[0], rq[1], rq[2], rq[3]);
+        for (U32 axis = 0; axis < 3; ++axis)
+        {
+            c[axis] = cq[axis];
+            r[axis] = rq[axis];
+        }
+    }
+
+    inline void store_results(U32 outside_bits, U32 partial_bits, U32 first, U32 count, U32 lanes, S32* results)
+    {
+        const U32 end = llmin(first + lanes, count);
+        for (U32 i = first; i < end; ++i)
+        {
+            const U32 bit = 1 << (i - first);
+            results[i] = (outside_bits & bit) ? 0 : ((partial_bits & bit) ? 1 : 2);
+        }
+    }
+}
+
+void LLCamera::AABBsInPlanes(const LLVector4a* centers, const LLVector4a* radii, U32 count, S32* results,
+                             const LLPlane* planes, bool no_far_clip) const
+{
+    BatchPlane batch_planes[AGENT_PLANE_USER_CLIP_NUM];
+    U32 plane_count = 0;
+    U32 max_planes = llmin(mPlaneCount, (U32) AGENT_PLANE_USER_CLIP_NUM);
+    for (U32 i = 0; i < max_planes; i++)
+    {
+        const U8 mask = mPlaneMask[i];
+        if (mask < PLANE_MASK_NUM && !(no_far_clip && i == AGENT_PLANE_FAR))
+        {
+            BatchPlane& bp = batch_planes[plane_count++];
+            for (U32 axis = 0; axis < 3; ++axis)
+            {
+                bp.mNormal[axis] = planes[i][axis];
+                bp.mScale[axis] = sFrustumScaler[mask][axis];
+            }
+            bp.mNegD = -planes[i][3];
+        }
+    }
+
+    U32 first = 0;
+#if defined(__AVX__)
+    for (; first + 4 < count; first += 8)
+    {
+        LLQuad lo_c[3], lo_r[3], hi_c[3], hi_r[3];
+        load_boxes(centers, radii, first, count, lo_c, lo_r);
+        load_boxes(centers, radii, first + 4, count, hi_c, hi_r);
+
+        __m256 c[3], r[3];
+        for (U32 axis = 0; axis < 3; ++axis)
+        {
+            c[axis] = _mm256_set_m128(hi_c[axis], lo_c[axis]);
+            r[axis] = _mm256_set_m128(hi_r[axis], lo_r[axis]);
+        }
+
+        U32 outside_bits, partial_bits;
+        test_boxes_avx(c, r, batch_planes, plane_count, outside_bits, partial_bits);
+        store_results(outside_bits, partial_bits, first, count, 8, results);
+    }
+#endif
+    for (; first < count; first += 4)
+    {
+        LLQuad c[3], r[3];
+        load_boxes(centers, radii, first, count, c, r);
+
+        U32 outside_bits, partial_bits;
+        test_boxes_sse(c, r, batch_planes, plane_count, outside_bits, partial_bits);
+        store_results(outside_bits, partial_bits, first, count, 4, results);
+    }
+}
+
+void LLCamera::AABBsInFrustum(const LLVector4a* centers, const LLVector4a* radii, U32 count, S32* results, const LLPlane* planes)
+{
+    AABBsInPlanes(centers, radii, count, results, planes ? planes : mAgentPlanes, false);
+}
+
+void LLCamera::AABBsInRegionFrustum(const LLVector4a* centers, const LLVector4a* radii, U32 count, S32* results)
+{
+    AABBsInPlanes(centers, radii, count, results, mRegionPlanes, false);
+}
+
+void LLCamera::AABBsInFrustumNoFarClip(const LLVector4a* centers, const LLVector4a* radii, U32 count, S32* results, const LLPlane* planes)
+{
+    AABBsInPlanes(centers, radii, count, results, planes ? planes : mAgentPlanes, true);
+}
+
+void LLCamera::AABBsInRegionFrustumNoFarClip(const LLVector4a* centers, const LLVector4a* radii, U32 count, S32* results)
+{
+    AABBsInPlanes(centers, radii, count, results, mRegionPlanes, true);
+}
+
 int LLCamera::sphereInFrustumQuick(const LLVector3 &sphere_center, const F32 radius)
 {
     LLVector3 dist = sphere_center-mFrustCenter;
@@ -211,6 +211,14 @@ public:
     S32 AABBInFrustumNoFarClip(const LLVector4a& center, const LLVector4a& radius, const LLPlane* planes = NULL);
     S32 AABBInRegionFrustumNoFarClip(const LLVector4a& center, const LLVector4a& radius);
 
+    // Batched versions of the AABB tests above. Test count boxes at once,
+    // 4 per pass with SSE or 8 with AVX, and write 0 (outside), 1 (partly in)
+    // or 2 (fully in) for each box to results, same as the single box tests.
+    void AABBsInFrustum(const LLVector4a* centers, const LLVector4a* radii, U32 count, S32* results, const LLPlane* planes = NULL);
+    void AABBsInRegionFrustum(const LLVector4a* centers, const LLVector4a* radii, U32 count, S32* results);
+    void AABBsInFrustumNoFarClip(const LLVector4a* centers, const LLVector4a* radii, U32 count, S32* results, const LLPlane* planes = NULL);
+    void AABBsInRegionFrustumNoFarClip(const LLVector4a* centers, const LLVector4a* radii, U32 count, S32* results);
+
     //does a quick 'n dirty sphere-sphere check
     S32 sphereInFrustumQuick(const LLVector3 &sphere_center, const F32 radius);
 
@@ -224,6 +232,8 @@ public:
     friend std::ostream& operator<<(std::ostream &s, const LLCamera &C);
 
 protected:
+    void AABBsInPlanes(const LLVector4a* centers, const LLVector4a* radii, U32 count, S32* results, const LLPlane* planes, bool no_far_clip) const;
+
     void calculateFrustumPlanes();
     void calculateFrustumPlanes(F32 left, F32 right, F32 top, F32 bottom);
     void calculateFrustumPlanesFromWindow(F32 x1, F32 y1, F32 x2, F32 y2);
@@ -0,0 +1,219 @@
+/**
+ * @file lloctreelinear.h
+ * @brief Packed, read only copy of an LLOctreeNode tree for fast traversal.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLOCTREELINEAR_H
+#define LL_LLOCTREELINEAR_H
+
+#include "llcamera.h"
+#include "lloctree.h"
+#include "llvector4a.h"
+#include <vector>
+
+// LLOctreeLinear is a breadth first packed copy of an LLOctreeNode tree.
+// Node bounds live in two flat arrays (centers and half sizes), the children
+// of a node are stored next to each other and the elements of all nodes are
+// in one contiguous list, so a traversal walks a few arrays instead of
+// chasing node, child and element vector pointers.
+//
+// It is a snapshot: the owner rebuilds it with build() after elements or
+// nodes are added or removed, and can patch node bounds in place with
+// setNodeBounds() when only those change. Element pointers are held as
+// T_PTR, so with LLPointer storage elements stay alive until the next build.
+template <class T, typename T_PTR>
+class LLOctreeLinear
+{
+public:
+    typedef LLOctreeNode<T, T_PTR> oct_node;
+
+    static constexpr U32 INVALID_NODE = U32_MAX;
+
+    // Return values of traversal node tests, same meaning as
+    // LLCamera::AABBInFrustum()
+    enum
+    {
+        NODE_OUTSIDE = 0,   // skip node and children
+        NODE_PARTIAL = 1,   // visit node elements, test children
+        NODE_INSIDE = 2     // visit node and all children without further tests
+    };
+
+    LLOctreeLinear() = default;
+
+    // Rebuild from root using the octree node bounds.
+    void build(const oct_node* root)
+    {
+        build(root, [](const oct_node* node, U32 index, LLVector4a& center, LLVector4a& size)
+            {
+                center = node->getCenter();
+                size = node->getSize();
+            });
+    }
+
+    // Rebuild from root. get_bounds(node, index, center, size) supplies the
+    // bounds to pack for each node, and lets the caller remember the index
+    // of the node for later setNodeBounds() calls.
+    template <typename BOUNDS_FN>
+    void build(const oct_node* root, BOUNDS_FN&& get_bounds)
+    {
+        clear();
+        if (!root)
+        {
+            return;
+        }
+
+        mSourceNodes.push_back(root);
+        for (U32 index = 0; index < (U32)mSourceNodes.size(); ++index)
+        {
+            const oct_node* node = mSourceNodes[index];
+
+            LLVector4a center, size;
+            get_bounds(node, index, center, size);
+            mCenters.push_back(center);
+            mSizes.push_back(size);
+
+            mFirstElement.push_back((U32)mElements.size());
+            mElementCount.push_back(node->getElementCount());
+            mElements.insert(mElements.end(), node->getDataBegin(), node->getDataEnd());
+
+            // children are appended to the queue, so they end up adjacent
+            mFirstChild.push_back((U32)mSourceNodes.size());
+            mChildCount.push_back(node->getChildCount());
+            for (U32 i = 0; i < node->getChildCount(); ++i)
+            {
+                mSourceNodes.push_back(node->getChild(i));
+            }
+        }
+    }
+
+    void clear()
+    {
+        mCenters.clear();
+        mSizes.clear();
+        mFirstChild.clear();
+        mChildCount.clear();
+        mFirstElement.clear();
+        mElementCount.clear();
+        mSourceNodes.clear();
+        mElements.clear();
+    }
+
+    bool isEmpty() const                            { return mSourceNodes.empty(); }
+    U32 getNodeCount() const                        { return (U32)mSourceNodes.size(); }
+    size_t getElementCount() const                  { return mElements.size(); }
+    const oct_node* getSourceNode(U32 index) const  { return mSourceNodes[index]; }
+    const LLVector4a& getCenter(U32 index) const    { return mCenters[index]; }
+    const LLVector4a& getSize(U32 index) const      { return mSizes[index]; }
+
+    // Patch the bounds of one node in place. Indices that are out of date
+    // (node no longer packed) are ignored.
+    void setNodeBounds(U32 index, const LLVector4a& center, const LLVector4a& size)
+    {
+        if (index < (U32)mCenters.size())
+        {
+            mCenters[index] = center;
+            mSizes[index] = size;
+        }
+    }
+
+    // Depth first traversal in the same order as LLOctreeTraveler.
+    // test(index, center, size) returns one of the NODE_ values above,
+    // visit(element) is called for each element of accepted nodes.
+    template <typename TEST_FN, typename VISIT_FN>
+    void traverse(TEST_FN&& test, VISIT_FN&& visit) const
+    {
+        if (isEmpty())
+        {
+            return;
+        }
+
+        // Each entry is a node index, with the top bit set if the node is
+        // known to be entirely inside and needs no further tests.
+        const U32 INSIDE_BIT = 0x80000000;
+        std::vector<U32> stack;
+        stack.reserve(64);
+        stack.push_back(0);
+
+        while (!stack.empty())
+        {
+            U32 entry = stack.back();
+            stack.pop_back();
+
+            U32 index = entry & ~INSIDE_BIT;
+            bool inside = (entry & INSIDE_BIT) != 0;
+            if (!inside)
+            {
+                S32 res = test(index, mCenters[index], mSizes[index]);
+                if (res == NODE_OUTSIDE)
+                {
+                    continue;
+                }
+                inside = res == NODE_INSIDE;
+            }
+
+            const U32 first_element = mFirstElement[index];
+            const U32 end_element = first_element + mElementCount[index];
+            for (U32 i = first_element; i < end_element; ++i)
+            {
+                visit(mElements[i]);
+            }
+
+            // push in reverse so the first child is visited first
+            const U32 flag = inside ? INSIDE_BIT : 0;
+            for (U32 i = mChildCount[index]; i > 0; --i)
+            {
+                stack.push_back((mFirstChild[index] + i - 1) | flag);
+            }
+        }
+    }
+
+    // Frustum cull against the camera agent planes, pad grows each node box
+    // to account for elements that extend past their node.
+    template <typename VISIT_FN>
+    void cull(LLCamera& camera, const LLVector4a& pad, VISIT_FN&& visit) const
+    {
+        traverse([&](U32 index, const LLVector4a& center, const LLVector4a& size) -> S32
+            {
+                LLVector4a loose_size;
+                loose_size.setAdd(size, pad);
+                return camera.AABBInFrustum(center, loose_size);
+            },
+            visit);
+    }
+
+private:
+    // Node data, indexed by node, breadth first
+    std::vector<LLVector4a>         mCenters;
+    std::vector<LLVector4a>         mSizes;
+    std::vector<U32>                mFirstChild;
+    std::vector<U32>                mChildCount;
+    std::vector<U32>                mFirstElement;
+    std::vector<U32>                mElementCount;
+    std::vector<const oct_node*>    mSourceNodes;
+
+    // Elements of all nodes, in node order
+    std::vector<T_PTR>              mElements;
+};
+
+#endif // LL_LLOCTREELINEAR_H
@@ -28,6 +28,7 @@
 
 #include "llmath.h"
 #include "llrigginginfo.h"
+#include "llmatrix4a.h"
 
 //-----------------------------------------------------------------------------
 // LLJointRiggingInfo
@@ -159,3 +160,96 @@ void LLJointRiggingInfoTab::merge(const LLJointRiggingInfoTab& src)
     //showDetails(*this, "output this");
 
 }
+
+//-----------------------------------------------------------------------------
+// LLJointVertexBounds
+//-----------------------------------------------------------------------------
+LLJointVertexBounds::LLJointVertexBounds():
+    mBuilt(false)
+{
+}
+
+void LLJointVertexBounds::build(const LLVector4a* positions, const LLVector4a* weights, S32 count)
+{
+    clear();
+
+    // Joint indices come from a byte in the mesh asset, so a table indexed
+    // by joint stays small.
+    std::vector<LLVector4a> extents;
+    std::vector<bool> used;
+    for (S32 i = 0; i < count; ++i)
+    {
+        const F32* w = weights[i].getF32ptr();
+        for (U32 k = 0; k < 4; ++k)
+        {
+            // Truncate and clamp negative indices to 0, same as skinning
+            S32 joint = llmax((S32)w[k], 0);
+            if (joint >= (S32)used.size())
+            {
+                used.resize(joint + 1, false);
+                extents.resize((joint + 1) * 2);
+            }
+
+            if (used[joint])
+            {
+                update_min_max(extents[joint * 2], extents[joint * 2 + 1], positions[i]);
+            }
+            else
+            {
+                used[joint] = true;
+                extents[joint * 2] = positions[i];
+                extents[joint * 2 + 1] = positions[i];
+            }
+        }
+    }
+
+    for (S32 joint = 0; joint < (S32)used.size(); ++joint)
+    {
+        if (used[joint])
+        {
+            mJoints.push_back(joint);
+            mExtents.push_back(extents[joint * 2]);
+            mExtents.push_back(extents[joint * 2 + 1]);
+        }
+    }
+    mBuilt = true;
+}
+
+void LLJointVertexBounds::clear()
+{
+    mJoints.clear();
+    mExtents.clear();
+    mBuilt = false;
+}
+
+bool LLJointVertexBounds::getSkinnedExtents(const LLMatrix4a* palette, U32 palette_count, const LLMatrix4a& bind_shape,
+                                            LLVector4a* extents) const
+{
+    if (mJoints.empty() || !palette_count)
+    {
+        return false;
+    }
+
+    for (S32 i = 0; i < (S32)mJoints.size(); ++i)
+    {
+        const S32 joint = llmin(mJoints[i], (S32)palette_count - 1);
+
+        // bind shape first, then the joint
+        LLMatrix4a mat;
+        matMulUnsafe(bind_shape, palette[joint], mat);
+
+        LLVector4a box[2];
+        matMulBoundBox(mat, &mExtents[i * 2], box);
+        if (i == 0)
+        {
+            extents[0] = box[0];
+            extents[1] = box[1];
+        }
+        else
+        {
+            extents[0].setMin(extents[0], box[0]);
+            extents[1].setMax(extents[1], box[1]);
+        }
+    }
+    return true;
+}
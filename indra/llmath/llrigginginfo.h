@@ -32,6 +32,10 @@
 
 #include "llvector4a.h"
 
+#include <vector>
+
+class LLMatrix4a;
+
 // Extents are in joint space
 // isRiggedTo is based on the state of all currently associated rigged meshes
 class alignas(16) LLJointRiggingInfo
@@ -80,4 +84,37 @@ private:
     bool mNeedsUpdate;
 };
 
+// Bounding boxes of the vertices of one rigged face, one box per joint
+// index that influences any of them, in the space of the face before the
+// bind shape matrix. A skinned vertex is a weighted average of the vertex
+// put through the matrices of its joints, so it lies inside the boxes put
+// through the same matrices. The extents of the skinned face can then be
+// had by transforming a few boxes per joint instead of every vertex.
+class LLJointVertexBounds
+{
+public:
+    LLJointVertexBounds();
+
+    // weights are in the mWeights format of LLVolumeFace, joint index in
+    // the integer part and weight in the fractional part. Every joint index
+    // of a vertex counts, whatever its weight.
+    void build(const LLVector4a* positions, const LLVector4a* weights, S32 count);
+    void clear();
+    bool isBuilt() const { return mBuilt; }
+
+    // Number of joint boxes.
+    S32 size() const { return static_cast<S32>(mJoints.size()); }
+
+    // Extents of the face skinned with palette and bind_shape, as
+    // LLSkinningUtil::skinPositions() does it. Joint indices are clamped to
+    // the palette the same way. Returns false if there are no boxes.
+    bool getSkinnedExtents(const LLMatrix4a* palette, U32 palette_count, const LLMatrix4a& bind_shape,
+                           LLVector4a* extents) const;
+
+private:
+    std::vector<S32> mJoints;
+    std::vector<LLVector4a> mExtents; // min and max per joint
+    bool mBuilt;
+};
+
 #endif
@@ -0,0 +1,560 @@
+/**
+ * @file llvertextransform.cpp
+ * @brief Bulk transforms of vertex attribute arrays into vertex buffers.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "llmath.h"
+#include "llvertextransform.h"
+
+#include <immintrin.h>
+#if LL_WINDOWS
+#include <intrin.h>
+#endif
+
+// The AVX2 kernels are compiled for AVX2 whatever the target of the rest of
+// the build and only called after checking the CPU. MSVC allows AVX
+// intrinsics anywhere, gcc and clang need the function target attribute.
+#if defined(__AVX2__) || LL_WINDOWS
+#define LL_TARGET_AVX2
+#else
+#define LL_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace
+{
+    LLVertexTransform::EKernel detect_kernel()
+    {
+        return LLVertexTransform::hasAVX2() ? LLVertexTransform::KERNEL_AVX2 : LLVertexTransform::KERNEL_SSE;
+    }
+
+    LLVertexTransform::EKernel sKernel = detect_kernel();
+
+    //------------------------------------------------------------------
+    // SSE
+
+    void transform_positions_sse(const LLMatrix4a& mat, const LLVector4a* src, U32 count, F32 w, LLVector4a* dst)
+    {
+        LLVector4Logical mask;
+        mask.clear();
+        mask.setElement<3>();
+
+        LLVector4a wv;
+        wv.splat(w);
+
+        F32* out = (F32*)dst;
+        for (U32 i = 0; i < count; ++i)
+        {
+            LLVector4a res;
+            mat.affineTransform(src[i], res);
+            res.setSelectWithMask(mask, wv, res);
+            _mm_storeu_ps(out, res);
+            out += 4;
+        }
+    }
+
+    void rotate_normals_sse(const LLMatrix4a& mat, const LLVector4a* src, U32 count, LLVector4a* dst)
+    {
+        F32* out = (F32*)dst;
+        for (U32 i = 0; i < count; ++i)
+        {
+            LLVector4a res;
+            mat.rotate(src[i], res);
+            _mm_storeu_ps(out, res);
+            out += 4;
+        }
+    }
+
+    void rotate_tangents_sse(const LLMatrix4a& mat, const LLVector4a* src, U32 count, LLVector4a* dst)
+    {
+        LLVector4Logical mask;
+        mask.clear();
+        mask.setElement<3>();
+
+        F32* out = (F32*)dst;
+        for (U32 i = 0; i < count; ++i)
+        {
+            LLVector4a res;
+            mat.rotate(src[i], res);
+            res.setSelectWithMask(mask, src[i], res);
+            _mm_storeu_ps(out, res);
+            out += 4;
+        }
+    }
+
+    // Constants of the texture transform, laid out for two texture
+    // coordinates <s0, t0, s1, t1> per vector.
+    struct TexTransform
+    {
+        LLVector4a mTrans;
+        LLVector4a mRot0;
+        LLVector4a mRot1;
+        LLVector4a mScale;
+        LLVector4a mOffset;
+
+        TexTransform(F32 cos_ang, F32 sin_ang, F32 os, F32 ot, F32 ms, F32 mt)
+        {
+            mTrans.splat(-0.5f);
+            mRot0.set(cos_ang, -sin_ang, cos_ang, -sin_ang);
+            mRot1.set(sin_ang, cos_ang, sin_ang, cos_ang);
+            mScale.set(ms, mt, ms, mt);
+            mOffset.set(os + 0.5f, ot + 0.5f, os + 0.5f, ot + 0.5f);
+        }
+
+        // Same operations as the vector paths, one lane at a time
+        void apply(const LLVector2& src, LLVector2& dst) const
+        {
+            const F32 s = src.mV[0] + mTrans[0];
+            const F32 t = src.mV[1] + mTrans[1];
+            dst.mV[0] = (mRot0[0] * s + mRot1[0] * t) * mScale[0] + mOffset[0];
+            dst.mV[1] = (mRot0[1] * s + mRot1[1] * t) * mScale[1] + mOffset[1];
+        }
+    };
+
+    void transform_tex_coords_sse(const TexTransform& xf, const LLVector2* src, U32 count, LLVector2* dst)
+    {
+        const F32* in = (const F32*)src;
+        F32* out = (F32*)dst;
+        U32 i = 0;
+        for (; i + 2 <= count; i += 2)
+        {
+            LLVector4a st;
+            st.setAdd(_mm_loadu_ps(in), xf.mTrans);
+
+            LLVector4a ss = _mm_shuffle_ps(st, st, _MM_SHUFFLE(2, 2, 0, 0));
+            LLVector4a tt = _mm_shuffle_ps(st, st, _MM_SHUFFLE(3, 3, 1, 1));
+
+            LLVector4a a;
+            a.setMul(xf.mRot0, ss);
+            LLVector4a b;
+            b.setMul(xf.mRot1, tt);
+
+            st.setAdd(a, b);
+            st.mul(xf.mScale);
+            st.add(xf.mOffset);
+            _mm_storeu_ps(out, st);
+
+            in += 4;
+            out += 4;
+        }
+
+        if (i < count)
+        {
+            xf.apply(src[i], dst[i]);
+        }
+    }
+
+    //------------------------------------------------------------------
+    // AVX2, two vertices per 256 bit register, 8 vertices per iteration
+
+    LL_TARGET_AVX2 inline __m256 broadcast_row(const LLVector4a& row)
+    {
+        const __m128 q = row;
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(q), q, 1);
+    }
+
+    LL_TARGET_AVX2 inline __m256 rotate2(__m256 v, __m256 r0, __m256 r1, __m256 r2)
+    {
+        __m256 res = _mm256_permute_ps(v, _MM_SHUFFLE(0, 0, 0, 0));
+        __m256 y = _mm256_permute_ps(v, _MM_SHUFFLE(1, 1, 1, 1));
+        __m256 z = _mm256_permute_ps(v, _MM_SHUFFLE(2, 2, 2, 2));
+
+        res = _mm256_mul_ps(res, r0);
+        y = _mm256_mul_ps(y, r1);
+        z = _mm256_mul_ps(z, r2);
+
+        res = _mm256_add_ps(res, y);
+        return _mm256_add_ps(res, z);
+    }
+
+    LL_TARGET_AVX2 inline __m256 affine2(__m256 v, __m256 r0, __m256 r1, __m256 r2, __m256 r3)
+    {
+        __m256 x = _mm256_permute_ps(v, _MM_SHUFFLE(0, 0, 0, 0));
+        __m256 y = _mm256_permute_ps(v, _MM_SHUFFLE(1, 1, 1, 1));
+        __m256 z = _mm256_permute_ps(v, _MM_SHUFFLE(2, 2, 2, 2));
+
+        x = _mm256_mul_ps(x, r0);
+        y = _mm256_mul_ps(y, r1);
+        z = _mm256_mul_ps(z, r2);
+
+        x = _mm256_add_ps(x, y);
+        z = _mm256_add_ps(z, r3);
+        return _mm256_add_ps(x, z);
+    }
+
+    // Blend mask for the w components of both vertices
+    const int BLEND_W = 0x88;
+
+    LL_TARGET_AVX2 void transform_positions_avx2(const LLMatrix4a& mat, const LLVector4a* src, U32 count, F32 w, LLVector4a* dst)
+    {
+        const __m256 r0 = broadcast_row(mat.mMatrix[0]);
+        const __m256 r1 = broadcast_row(mat.mMatrix[1]);
+        const __m256 r2 = broadcast_row(mat.mMatrix[2]);
+        const __m256 r3 = broadcast_row(mat.mMatrix[3]);
+        const __m256 wv = _mm256_set1_ps(w);
+
+        const F32* in = (const F32*)src;
+        F32* out = (F32*)dst;
+        U32 i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 v0 = affine2(_mm256_loadu_ps(in), r0, r1, r2, r3);
+            __m256 v1 = affine2(_mm256_loadu_ps(in + 8), r0, r1, r2, r3);
+            __m256 v2 = affine2(_mm256_loadu_ps(in + 16), r0, r1, r2, r3);
+            __m256 v3 = affine2(_mm256_loadu_ps(in + 24), r0, r1, r2, r3);
+            _mm256_storeu_ps(out, _mm256_blend_ps(v0, wv, BLEND_W));
+            _mm256_storeu_ps(out + 8, _mm256_blend_ps(v1, wv, BLEND_W));
+            _mm256_storeu_ps(out + 16, _mm256_blend_ps(v2, wv, BLEND_W));
+            _mm256_storeu_ps(out + 24, _mm256_blend_ps(v3, wv, BLEND_W));
+            in += 32;
+            out += 32;
+        }
+
+        transform_positions_sse(mat, src + i, count - i, w, dst + i);
+    }
+
+    LL_TARGET_AVX2 void rotate_normals_avx2(const LLMatrix4a& mat, const LLVector4a* src, U32 count, LLVector4a* dst)
+    {
+        const __m256 r0 = broadcast_row(mat.mMatrix[0]);
+        const __m256 r1 = broadcast_row(mat.mMatrix[1]);
+        const __m256 r2 = broadcast_row(mat.mMatrix[2]);
+
+        const F32* in = (const F32*)src;
+        F32* out = (F32*)dst;
+        U32 i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 v0 = rotate2(_mm256_loadu_ps(in), r0, r1, r2);
+            __m256 v1 = rotate2(_mm256_loadu_ps(in + 8), r0, r1, r2);
+            __m256 v2 = rotate2(_mm256_loadu_ps(in + 16), r0, r1, r2);
+            __m256 v3 = rotate2(_mm256_loadu_ps(in + 24), r0, r1, r2);
+            _mm256_storeu_ps(out, v0);
+            _mm256_storeu_ps(out + 8, v1);
+            _mm256_storeu_ps(out + 16, v2);
+            _mm256_storeu_ps(out + 24, v3);
+            in += 32;
+            out += 32;
+        }
+
+        rotate_normals_sse(mat, src + i, count - i, dst + i);
+    }
+
+    LL_TARGET_AVX2 void rotate_tangents_avx2(const LLMatrix4a& mat, const LLVector4a* src, U32 count, LLVector4a* dst)
+    {
+        const __m256 r0 = broadcast_row(mat.mMatrix[0]);
+        const __m256 r1 = broadcast_row(mat.mMatrix[1]);
+        const __m256 r2 = broadcast_row(mat.mMatrix[2]);
+
+        const F32* in = (const F32*)src;
+        F32* out = (F32*)dst;
+        U32 i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 s0 = _mm256_loadu_ps(in);
+            __m256 s1 = _mm256_loadu_ps(in + 8);
+            __m256 s2 = _mm256_loadu_ps(in + 16);
+            __m256 s3 = _mm256_loadu_ps(in + 24);
+            _mm256_storeu_ps(out, _mm256_blend_ps(rotate2(s0, r0, r1, r2), s0, BLEND_W));
+            _mm256_storeu_ps(out + 8, _mm256_blend_ps(rotate2(s1, r0, r1, r2), s1, BLEND_W));
+            _mm256_storeu_ps(out + 16, _mm256_blend_ps(rotate2(s2, r0, r1, r2), s2, BLEND_W));
+            _mm256_storeu_ps(out + 24, _mm256_blend_ps(rotate2(s3, r0, r1, r2), s3, BLEND_W));
+            in += 32;
+            out += 32;
+        }
+
+        rotate_tangents_sse(mat, src + i, count - i, dst + i);
+    }
+
+    // Four texture coordinates per register
+    LL_TARGET_AVX2 inline __m256 tex_xform4(__m256 v, __m256 trans, __m256 rot0, __m256 rot1, __m256 scale, __m256 offset)
+    {
+        __m256 st = _mm256_add_ps(v, trans);
+        __m256 ss = _mm256_permute_ps(st, _MM_SHUFFLE(2, 2, 0, 0));
+        __m256 tt = _mm256_permute_ps(st, _MM_SHUFFLE(3, 3, 1, 1));
+
+        __m256 a = _mm256_mul_ps(rot0, ss);
+        __m256 b = _mm256_mul_ps(rot1, tt);
+
+        st = _mm256_add_ps(a, b);
+        st = _mm256_mul_ps(st, scale);
+        return _mm256_add_ps(st, offset);
+    }
+
+    LL_TARGET_AVX2 void transform_tex_coords_avx2(const TexTransform& xf, const LLVector2* src, U32 count, LLVector2* dst)
+    {
+        const __m256 trans = broadcast_row(xf.mTrans);
+        const __m256 rot0 = broadcast_row(xf.mRot0);
+        const __m256 rot1 = broadcast_row(xf.mRot1);
+        const __m256 scale = broadcast_row(xf.mScale);
+        const __m256 offset = broadcast_row(xf.mOffset);
+
+        const F32* in = (const F32*)src;
+        F32* out = (F32*)dst;
+        U32 i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 v0 = tex_xform4(_mm256_loadu_ps(in), trans, rot0, rot1, scale, offset);
+            __m256 v1 = tex_xform4(_mm256_loadu_ps(in + 8), trans, rot0, rot1, scale, offset);
+            _mm256_storeu_ps(out, v0);
+            _mm256_storeu_ps(out + 8, v1);
+            in += 16;
+            out += 16;
+        }
+
+        transform_tex_coords_sse(xf, src + i, count - i, dst + i);
+    }
+
+    //------------------------------------------------------------------
+    // Skinning
+
+    // Joint indices and normalized weights of one vertex, same arithmetic
+    // as FSSkinningUtil::getPerVertexSkinMatrixSSE(). Indices are clamped
+    // to [0, max_idx].
+    inline void unpack_weights(const LLVector4a& weights, __m128i max_idx, S32* idx, __m128& wght)
+    {
+        __m128i i = _mm_cvttps_epi32(weights);
+        __m128 w = _mm_sub_ps(weights, _mm_cvtepi32_ps(i));
+
+        __m128i below = _mm_cmplt_epi32(i, max_idx);
+        i = _mm_or_si128(_mm_and_si128(below, i), _mm_andnot_si128(below, max_idx));
+        i = _mm_and_si128(i, _mm_cmpgt_epi32(i, _mm_set1_epi32(-1)));
+        _mm_storeu_si128((__m128i*)idx, i);
+
+        __m128 scale = _mm_add_ps(w, _mm_movehl_ps(w, w));
+        scale = _mm_add_ss(scale, _mm_shuffle_ps(scale, scale, 1));
+        scale = _mm_shuffle_ps(scale, scale, 0);
+        wght = _mm_div_ps(w, scale);
+    }
+
+    void skin_positions_sse(const LLMatrix4a* palette, U32 palette_count, const LLMatrix4a& bind_shape,
+                            const LLVector4a* positions, const LLVector4a* weights, U32 count, LLVector4a* dst)
+    {
+        const __m128i max_idx = _mm_set1_epi32((S32)palette_count - 1);
+        for (U32 i = 0; i < count; ++i)
+        {
+            S32 idx[4];
+            __m128 wght;
+            unpack_weights(weights[i], max_idx, idx, wght);
+
+            LL_ALIGN_16(F32 w[4]);
+            _mm_store_ps(w, wght);
+
+            LLMatrix4a final_mat;
+            final_mat.clear();
+            for (U32 k = 0; k < 4; ++k)
+            {
+                LLMatrix4a src;
+                src.setMul(palette[idx[k]], w[k]);
+                final_mat.add(src);
+            }
+
+            LLVector4a t;
+            bind_shape.affineTransform(positions[i], t);
+            final_mat.affineTransform(t, dst[i]);
+        }
+    }
+
+    // Blend the palette matrices of one vertex and apply the result to its
+    // bind shape transformed position. lane is 0 or 4, the vertex half of
+    // wght and t. The matrix is held as rows 0 and 1 in one register and
+    // rows 2 and 3 in another, and the transform sums the products in the
+    // same order as LLMatrix4a::affineTransform().
+    LL_TARGET_AVX2 inline __m128 skin_one(const LLMatrix4a* palette, const S32* idx, __m256 wght, __m256 t, S32 lane)
+    {
+        __m256 rows01 = _mm256_setzero_ps();
+        __m256 rows23 = _mm256_setzero_ps();
+        for (S32 k = 0; k < 4; ++k)
+        {
+            const __m256 w = _mm256_permutevar8x32_ps(wght, _mm256_set1_epi32(lane + k));
+            const F32* m = palette[idx[k]].mMatrix[0].getF32ptr();
+            rows01 = _mm256_add_ps(rows01, _mm256_mul_ps(_mm256_loadu_ps(m), w));
+            rows23 = _mm256_add_ps(rows23, _mm256_mul_ps(_mm256_loadu_ps(m + 8), w));
+        }
+
+        // <x x x x y y y y> and <z z z z 1 1 1 1>
+        const __m256 xy = _mm256_permutevar8x32_ps(t, _mm256_setr_epi32(lane, lane, lane, lane, lane + 1, lane + 1, lane + 1, lane + 1));
+        __m256 z1 = _mm256_permutevar8x32_ps(t, _mm256_set1_epi32(lane + 2));
+        z1 = _mm256_blend_ps(z1, _mm256_set1_ps(1.f), 0xF0);
+
+        const __m256 p01 = _mm256_mul_ps(xy, rows01);
+        const __m256 p23 = _mm256_mul_ps(z1, rows23);
+        const __m128 x_y = _mm_add_ps(_mm256_castps256_ps128(p01), _mm256_extractf128_ps(p01, 1));
+        const __m128 z_w = _mm_add_ps(_mm256_castps256_ps128(p23), _mm256_extractf128_ps(p23, 1));
+        return _mm_add_ps(x_y, z_w);
+    }
+
+    LL_TARGET_AVX2 void skin_positions_avx2(const LLMatrix4a* palette, U32 palette_count, const LLMatrix4a& bind_shape,
+                                            const LLVector4a* positions, const LLVector4a* weights, U32 count, LLVector4a* dst)
+    {
+        const __m256 b0 = broadcast_row(bind_shape.mMatrix[0]);
+        const __m256 b1 = broadcast_row(bind_shape.mMatrix[1]);
+        const __m256 b2 = broadcast_row(bind_shape.mMatrix[2]);
+        const __m256 b3 = broadcast_row(bind_shape.mMatrix[3]);
+        const __m256i max_idx = _mm256_set1_epi32((S32)palette_count - 1);
+        const __m256i zero_idx = _mm256_setzero_si256();
+
+        const F32* in = (const F32*)positions;
+        const F32* in_weights = (const F32*)weights;
+        F32* out = (F32*)dst;
+        U32 i = 0;
+        for (; i + 2 <= count; i += 2)
+        {
+            // Indices and normalized weights of both vertices, same
+            // arithmetic as unpack_weights()
+            __m256 packed = _mm256_loadu_ps(in_weights);
+            __m256i index = _mm256_cvttps_epi32(packed);
+            __m256 wght = _mm256_sub_ps(packed, _mm256_cvtepi32_ps(index));
+            index = _mm256_max_epi32(_mm256_min_epi32(index, max_idx), zero_idx);
+
+            S32 idx[8];
+            _mm256_storeu_si256((__m256i*)idx, index);
+
+            __m256 scale = _mm256_add_ps(wght, _mm256_permute_ps(wght, _MM_SHUFFLE(3, 2, 3, 2)));
+            scale = _mm256_add_ps(scale, _mm256_permute_ps(scale, _MM_SHUFFLE(1, 1, 1, 1)));
+            scale = _mm256_permute_ps(scale, _MM_SHUFFLE(0, 0, 0, 0));
+            wght = _mm256_div_ps(wght, scale);
+
+            __m256 t = affine2(_mm256_loadu_ps(in), b0, b1, b2, b3);
+
+            _mm_storeu_ps(out, skin_one(palette, idx, wght, t, 0));
+            _mm_storeu_ps(out + 4, skin_one(palette, idx + 4, wght, t, 4));
+
+            in += 8;
+            in_weights += 8;
+            out += 8;
+        }
+
+        skin_positions_sse(palette, palette_count, bind_shape, positions + i, weights + i, count - i, dst + i);
+    }
+}
+
+namespace LLVertexTransform
+{
+    bool hasAVX2()
+    {
+#if LL_WINDOWS
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7)
+        {
+            return false;
+        }
+
+        // The OS must save the AVX registers (OSXSAVE, then XCR0 bits 1 and 2)
+        __cpuid(info, 1);
+        const int OSXSAVE_AVX = (1 << 27) | (1 << 28);
+        if ((info[2] & OSXSAVE_AVX) != OSXSAVE_AVX || (_xgetbv(0) & 0x6) != 0x6)
+        {
+            return false;
+        }
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        // Checks OS support as well
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+
+    EKernel getKernel()
+    {
+        return sKernel;
+    }
+
+    EKernel setKernel(EKernel kernel)
+    {
+        sKernel = (kernel == KERNEL_AVX2 && !hasAVX2()) ? KERNEL_SSE : kernel;
+        return sKernel;
+    }
+
+    void transformPositions(const LLMatrix4a& mat, const LLVector4a* src, U32 count, F32 w, LLVector4a* dst)
+    {
+        if (sKernel == KERNEL_AVX2)
+        {
+            transform_positions_avx2(mat, src, count, w, dst);
+        }
+        else
+        {
+            transform_positions_sse(mat, src, count, w, dst);
+        }
+    }
+
+    void rotateNormals(const LLMatrix4a& mat, const LLVector4a* src, U32 count, LLVector4a* dst)
+    {
+        if (sKernel == KERNEL_AVX2)
+        {
+            rotate_normals_avx2(mat, src, count, dst);
+        }
+        else
+        {
+            rotate_normals_sse(mat, src, count, dst);
+        }
+    }
+
+    void rotateTangents(const LLMatrix4a& mat, const LLVector4a* src, U32 count, LLVector4a* dst)
+    {
+        if (sKernel == KERNEL_AVX2)
+        {
+            rotate_tangents_avx2(mat, src, count, dst);
+        }
+        else
+        {
+            rotate_tangents_sse(mat, src, count, dst);
+        }
+    }
+
+    void transformTexCoords(const LLVector2* src, U32 count, F32 cos_ang, F32 sin_ang,
+                            F32 os, F32 ot, F32 ms, F32 mt, LLVector2* dst)
+    {
+        const TexTransform xf(cos_ang, sin_ang, os, ot, ms, mt);
+        if (sKernel == KERNEL_AVX2)
+        {
+            transform_tex_coords_avx2(xf, src, count, dst);
+        }
+        else
+        {
+            transform_tex_coords_sse(xf, src, count, dst);
+        }
+    }
+
+    void skinPositions(const LLMatrix4a* palette, U32 palette_count, const LLMatrix4a& bind_shape,
+                       const LLVector4a* positions, const LLVector4a* weights, U32 count, LLVector4a* dst)
+    {
+        if (!palette_count)
+        {
+            return;
+        }
+
+        if (sKernel == KERNEL_AVX2)
+        {
+            skin_positions_avx2(palette, palette_count, bind_shape, positions, weights, count, dst);
+        }
+        else
+        {
+            skin_positions_sse(palette, palette_count, bind_shape, positions, weights, count, dst);
+        }
+    }
+}
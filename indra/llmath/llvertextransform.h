@@ -0,0 +1,88 @@
+/**
+ * @file llvertextransform.h
+ * @brief Bulk transforms of vertex attribute arrays into vertex buffers.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLVERTEXTRANSFORM_H
+#define LL_LLVERTEXTRANSFORM_H
+
+#include "llmatrix4a.h"
+#include "v2math.h"
+
+// Kernels for the common cases of LLFace::getGeometryVolume(): whole arrays
+// of positions, normals, tangents or texture coordinates written to a vertex
+// buffer. Each kernel has an SSE version and an AVX2 version that does 8
+// vertices per iteration. The AVX2 versions are used when the CPU supports
+// them and do the same operations in the same order as the SSE versions, so
+// both produce identical output.
+//
+// Sources are 16 byte aligned, destinations need not be.
+namespace LLVertexTransform
+{
+    enum EKernel
+    {
+        KERNEL_SSE = 0,
+        KERNEL_AVX2
+    };
+
+    // True if the CPU and OS support AVX2.
+    bool hasAVX2();
+
+    // Kernel set in use, AVX2 when supported unless overridden.
+    EKernel getKernel();
+
+    // Select a kernel set. Asking for AVX2 on a CPU without it selects SSE.
+    // Returns the kernel set now in use.
+    EKernel setKernel(EKernel kernel);
+
+    // dst[i] = mat * src[i], with the w component of every output replaced
+    // by w (the texture index bits of batched faces).
+    void transformPositions(const LLMatrix4a& mat, const LLVector4a* src, U32 count, F32 w, LLVector4a* dst);
+
+    // dst[i] = rotation part of mat applied to src[i]. The w component of
+    // the output is undefined.
+    void rotateNormals(const LLMatrix4a& mat, const LLVector4a* src, U32 count, LLVector4a* dst);
+
+    // Same as rotateNormals(), but the w component (the bitangent sign) is
+    // copied from src.
+    void rotateTangents(const LLMatrix4a& mat, const LLVector4a* src, U32 count, LLVector4a* dst);
+
+    // Texture transform of LLFace: about the center of the face, rotate by
+    // the angle given as cos_ang and sin_ang, scale by (ms, mt), then
+    // offset by (os, ot).
+    void transformTexCoords(const LLVector2* src, U32 count, F32 cos_ang, F32 sin_ang,
+                            F32 os, F32 ot, F32 ms, F32 mt, LLVector2* dst);
+
+    // Linear blend skinning of positions, as LLRiggedVolume::update() does
+    // it. Each weights component holds a joint index in its integer part and
+    // a weight in its fractional part. Indices are clamped to the palette
+    // and the weights normalized to sum to 1. Positions go through
+    // bind_shape, then through the weighted sum of the palette matrices.
+    // The AVX2 version does two vertices per iteration, with two matrix rows
+    // per register.
+    void skinPositions(const LLMatrix4a* palette, U32 palette_count, const LLMatrix4a& bind_shape,
+                       const LLVector4a* positions, const LLVector4a* weights, U32 count, LLVector4a* dst);
+}
+
+#endif // LL_LLVERTEXTRANSFORM_H
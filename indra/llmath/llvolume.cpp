@@ -27,6 +27,7 @@
 #include "llmemory.h"
 #include "llmath.h"
 
+#include <algorithm>
 #include <set>
 #if !LL_WINDOWS
 #include <stdint.h>
@@ -52,6 +53,10 @@
 #include "llmeshoptimizer.h"
 #include "lltimer.h"
 #include "llvolumeoctree.h"
+#include "llvolumebvh.h"
+#include "llvolumecache.h"
+#include "parallelfor.h"
+#include "workqueue.h"
 
 #include "mikktspace/mikktspace.hh"
 
@@ -2775,16 +2780,45 @@ void LLVolume::copyVolumeFaces(const LLVolume* volume)
     mSculptLevel = 0;
 }
 
+// Below this many indices in all faces a hand off costs more than it saves
+constexpr S32 FACE_OPTIMIZE_MIN_INDICES = 3 * 4096;
+// Helpers posted per volume, the pool only runs as many as it has threads
+constexpr size_t FACE_OPTIMIZE_MAX_HELPERS = 8;
+
 bool LLVolume::cacheOptimize(bool gen_tangents)
 {
-    for (S32 i = 0; i < mVolumeFaces.size(); ++i)
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_VOLUME;
+
+    S32 total_indices = 0;
+    for (const LLVolumeFace& face : mVolumeFaces)
+    {
+        total_indices += face.mNumIndices;
+    }
+
+    if (mVolumeFaces.size() < 2 || total_indices < FACE_OPTIMIZE_MIN_INDICES)
     {
-        if (!mVolumeFaces[i].cacheOptimize(gen_tangents))
+        for (S32 i = 0; i < mVolumeFaces.size(); ++i)
         {
-            return false;
+            if (!mVolumeFaces[i].cacheOptimize(gen_tangents))
+            {
+                return false;
+            }
         }
+        return true;
     }
-    return true;
+
+    // Biggest first, so no thread is left with a big face at the end
+    std::vector<LLVolumeFace*> faces;
+    for (LLVolumeFace& face : mVolumeFaces)
+    {
+        faces.push_back(&face);
+    }
+    std::sort(faces.begin(), faces.end(),
+              [](const LLVolumeFace* a, const LLVolumeFace* b) { return a->mNumIndices > b->mNumIndices; });
+
+    return LL::parallel_for(FACE_OPTIMIZE_QUEUE, faces.size(),
+                            [&faces, gen_tangents](size_t i) { return faces[i]->cacheOptimize(gen_tangents); },
+                            FACE_OPTIMIZE_MAX_HELPERS);
 }
 
 
@@ -3234,6 +3268,25 @@ void LLVolume::sculpt(U16 sculpt_width, U16 sculpt_height, S8 sculpt_components,
     mMesh.resize(sizeS * sizeT);
     sNumMeshPoints += mMesh.size();
 
+    for (S32 i = 0; i < (S32)mProfilep->mFaces.size(); i++)
+    {
+        mFaceMask |= mProfilep->mFaces[i].mFaceID;
+    }
+
+    // Cached entries hold the faces and mesh points, none of the sampling
+    // below is needed
+    U64 cache_key = 0;
+    if (!data_is_empty && LLVolumeCache::isCacheable(this))
+    {
+        cache_key = LLVolumeCache::getKey(mParams, mDetail, sculpt_level, sculpt_width, sculpt_height,
+                                          sculpt_components, visible_placeholder);
+        if (LLVolumeCache::load(cache_key, this))
+        {
+            mSculptLevel = sculpt_level;
+            return;
+        }
+    }
+
     //generate vertex positions
     if (!data_is_empty)
     {
@@ -3269,17 +3322,17 @@ void LLVolume::sculpt(U16 sculpt_width, U16 sculpt_height, S8 sculpt_components,
         }
     }
 
-    for (S32 i = 0; i < (S32)mProfilep->mFaces.size(); i++)
-    {
-        mFaceMask |= mProfilep->mFaces[i].mFaceID;
-    }
-
     mSculptLevel = sculpt_level;
 
     // Delete any existing faces so that they get regenerated
     mVolumeFaces.clear();
 
     createVolumeFaces();
+
+    if (cache_key)
+    {
+        LLVolumeCache::store(cache_key, this);
+    }
 }
 
 
@@ -4263,6 +4316,69 @@ void LLVolume::generateSilhouetteVertices(std::vector<LLVector3> &vertices,
     }
 }
 
+// Fill in the hit point and the interpolated attributes of a hit on the
+// triangle idx of face.
+static void interpolate_hit(const LLVolumeFace& face, const U16* idx, F32 a, F32 b,
+                            const LLVector4a& start, const LLVector4a& dir, F32 t,
+                            LLVector4a* intersection, LLVector2* tex_coord, LLVector4a* normal, LLVector4a* tangent_out)
+{
+    if (intersection != NULL)
+    {
+        LLVector4a intersect = dir;
+        intersect.mul(t);
+        intersect.add(start);
+        *intersection = intersect;
+    }
+
+    if (tex_coord != NULL && face.mTexCoords)
+    {
+        LLVector2* tc = (LLVector2*) face.mTexCoords;
+        *tex_coord = ((1.f - a - b)  * tc[idx[0]] +
+            a              * tc[idx[1]] +
+            b              * tc[idx[2]]);
+    }
+
+    if (normal != NULL && face.mNormals)
+    {
+        LLVector4a* norm = face.mNormals;
+
+        LLVector4a n1,n2,n3;
+        n1 = norm[idx[0]];
+        n1.mul(1.f-a-b);
+
+        n2 = norm[idx[1]];
+        n2.mul(a);
+
+        n3 = norm[idx[2]];
+        n3.mul(b);
+
+        n1.add(n2);
+        n1.add(n3);
+
+        *normal = n1;
+    }
+
+    if (tangent_out != NULL && face.mTangents)
+    {
+        LLVector4a* tangents = face.mTangents;
+
+        LLVector4a t1,t2,t3;
+        t1 = tangents[idx[0]];
+        t1.mul(1.f-a-b);
+
+        t2 = tangents[idx[1]];
+        t2.mul(a);
+
+        t3 = tangents[idx[2]];
+        t3.mul(b);
+
+        t1.add(t2);
+        t1.add(t3);
+
+        *tangent_out = t1;
+    }
+}
+
 S32 LLVolume::lineSegmentIntersect(const LLVector4a& start, const LLVector4a& end,
                                    S32 face,
                                    LLVector4a* intersection,LLVector2* tex_coord, LLVector4a* normal, LLVector4a* tangent_out)
@@ -4308,23 +4424,28 @@ S32 LLVolume::lineSegmentIntersect(const LLVector4a& start, const LLVector4a& en
                 genTangents(i);
             }
 
-            if (isUnique())
-            { //don't bother with an octree for flexi volumes
+            const LLVolumeBVH* bvh = NULL;
+            if (!isUnique() && LLVolumeBVH::sUseBVH && usePickBVH())
+            {
+                if (face.getBVH() && face.getBVH()->getNumTriangles() != (U32)face.mNumIndices / 3)
+                { //face was rebuilt under the tree
+                    face.destroyBVH();
+                }
+                face.createBVH(true);
+                bvh = face.getBVH();
+            }
+
+            if (isUnique() || (LLVolumeBVH::sUseBVH && !bvh))
+            { //don't bother with a tree for flexi or rigged volumes, or while the tree for this face is being built
                 U32 tri_count = face.mNumIndices/3;
 
                 for (U32 j = 0; j < tri_count; ++j)
                 {
-                    U16 idx0 = face.mIndices[j*3+0];
-                    U16 idx1 = face.mIndices[j*3+1];
-                    U16 idx2 = face.mIndices[j*3+2];
-
-                    const LLVector4a& v0 = face.mPositions[idx0];
-                    const LLVector4a& v1 = face.mPositions[idx1];
-                    const LLVector4a& v2 = face.mPositions[idx2];
+                    const U16* idx = face.mIndices + j*3;
 
                     F32 a,b,t;
 
-                    if (LLTriangleRayIntersect(v0, v1, v2,
+                    if (LLTriangleRayIntersect(face.mPositions[idx[0]], face.mPositions[idx[1]], face.mPositions[idx[2]],
                             start, dir, a, b, t))
                     {
                         if ((t >= 0.f) &&      // if hit is after start
@@ -4333,68 +4454,21 @@ S32 LLVolume::lineSegmentIntersect(const LLVector4a& start, const LLVector4a& en
                         {
                             closest_t = t;
                             hit_face = i;
-
-                            if (intersection != NULL)
-                            {
-                                LLVector4a intersect = dir;
-                                intersect.mul(closest_t);
-                                intersect.add(start);
-                                *intersection = intersect;
-                            }
-
-
-                            if (tex_coord != NULL)
-                            {
-                                LLVector2* tc = (LLVector2*) face.mTexCoords;
-                                *tex_coord = ((1.f - a - b)  * tc[idx0] +
-                                    a              * tc[idx1] +
-                                    b              * tc[idx2]);
-
-                            }
-
-                            if (normal!= NULL)
-                            {
-                                LLVector4a* norm = face.mNormals;
-
-                                LLVector4a n1,n2,n3;
-                                n1 = norm[idx0];
-                                n1.mul(1.f-a-b);
-
-                                n2 = norm[idx1];
-                                n2.mul(a);
-
-                                n3 = norm[idx2];
-                                n3.mul(b);
-
-                                n1.add(n2);
-                                n1.add(n3);
-
-                                *normal     = n1;
-                            }
-
-                            if (tangent_out != NULL)
-                            {
-                                LLVector4a* tangents = face.mTangents;
-
-                                LLVector4a t1,t2,t3;
-                                t1 = tangents[idx0];
-                                t1.mul(1.f-a-b);
-
-                                t2 = tangents[idx1];
-                                t2.mul(a);
-
-                                t3 = tangents[idx2];
-                                t3.mul(b);
-
-                                t1.add(t2);
-                                t1.add(t3);
-
-                                *tangent_out = t1;
-                            }
+                            interpolate_hit(face, idx, a, b, start, dir, closest_t, intersection, tex_coord, normal, tangent_out);
                         }
                     }
                 }
             }
+            else if (bvh)
+            {
+                U32 tri;
+                F32 a, b;
+                if (bvh->intersect(face.mPositions, face.mIndices, start, dir, closest_t, tri, a, b))
+                {
+                    hit_face = i;
+                    interpolate_hit(face, face.mIndices + tri*3, a, b, start, dir, closest_t, intersection, tex_coord, normal, tangent_out);
+                }
+            }
             else
             {
                 if (!face.getOctree())
@@ -5132,6 +5206,7 @@ void LLVolumeFace::freeData()
 #endif
 
     destroyOctree();
+    destroyBVH();
 }
 
 bool LLVolumeFace::create(LLVolume* volume, bool partial_build)
@@ -5140,6 +5215,7 @@ bool LLVolumeFace::create(LLVolume* volume, bool partial_build)
 
     //tree for this face is no longer valid
     destroyOctree();
+    destroyBVH();
 
     LL_CHECK_MEMORY
     bool ret = false ;
@@ -5939,6 +6015,61 @@ const LLVolumeOctree* LLVolumeFace::getOctree() const
     return mOctree;
 }
 
+// Faces with fewer triangles build in less time than a hand off to a worker
+constexpr U32 BVH_BACKGROUND_MIN_TRIANGLES = 2048;
+
+void LLVolumeFace::createBVH(bool background)
+{
+    if (mBVH)
+    {
+        return;
+    }
+
+    if (mBVHBuild)
+    { //adopt the tree once the worker is done with it
+        mBVH = mBVHBuild->getResult();
+        if (mBVH)
+        {
+            mBVHBuild.reset();
+        }
+        return;
+    }
+
+    if (!mNumIndices)
+    {
+        return;
+    }
+
+    if (background && (U32)mNumIndices / 3 >= BVH_BACKGROUND_MIN_TRIANGLES)
+    {
+        LL::WorkQueue::ptr_t general_queue = LL::WorkQueue::getInstance("General");
+        if (general_queue)
+        {
+            auto build = std::make_shared<LLVolumeBVHBuild>(mPositions, mNumVertices, mIndices, mNumIndices);
+            if (general_queue->post([build]() { build->run(); }))
+            {
+                mBVHBuild = build;
+                return;
+            }
+        }
+    }
+
+    mBVH = std::make_shared<LLVolumeBVH>();
+    mBVH->build(mPositions, mIndices, mNumIndices);
+}
+
+void LLVolumeFace::destroyBVH()
+{
+    // a build still running on a worker owns its own copy of the data
+    mBVH.reset();
+    mBVHBuild.reset();
+}
+
+const LLVolumeBVH* LLVolumeFace::getBVH() const
+{
+    return mBVH.get();
+}
+
 
 void LLVolumeFace::swapData(LLVolumeFace& rhs)
 {
@@ -6624,6 +6755,7 @@ void LLVolumeFace::resizeVertices(S32 num_verts)
 
     // Force update
     mJointRiggingInfoTab.clear();
+    mJointVertexBounds.clear();
 }
 
 void LLVolumeFace::pushVertex(const LLVolumeFace::VertexData& cv)
@@ -6691,7 +6823,7 @@ void LLVolumeFace::allocateWeights(S32 num_verts)
 {
     ll_aligned_free_16(mWeights);
     mWeights = (LLVector4a*)ll_aligned_malloc_16(sizeof(LLVector4a)*num_verts);
-
+    mJointVertexBounds.clear();
 }
 
 void LLVolumeFace::allocateJointIndices(S32 num_verts)
@@ -28,6 +28,7 @@
 #define LL_LLVOLUME_H
 
 #include <iostream>
+#include <memory>
 
 class LLProfileParams;
 class LLPathParams;
@@ -42,6 +43,8 @@ class LLVolumeFace;
 class LLVolume;
 class LLVolumeTriangle;
 class LLVolumeOctree;
+class LLVolumeBVH;
+class LLVolumeBVHBuild;
 
 #include "lluuid.h"
 #include "v4color.h"
@@ -921,6 +924,13 @@ public:
     // Get a reference to the octree, which may be null
     const LLVolumeOctree* getOctree() const;
 
+    // BVH for picking. With background set, big faces are built on the
+    // General work queue and getBVH() stays null until a later call finds
+    // the build done.
+    void createBVH(bool background = false);
+    void destroyBVH();
+    const LLVolumeBVH* getBVH() const;
+
     // Part of silhouette generation (used by selection outlines)
     // Populates the provided edge array with numbers corresponding to
     // *partial* logic of whether a particular index should be rendered
@@ -991,6 +1001,11 @@ public:
     // vertices per joint.
     LLJointRiggingInfoTab mJointRiggingInfoTab;
 
+    // Bounding box of the vertices influenced by each joint, used to get
+    // the extents of the skinned face without skinning it. Built on first
+    // use.
+    mutable LLJointVertexBounds mJointVertexBounds;
+
     //whether or not face has been cache optimized
     bool mOptimized;
 
@@ -1002,6 +1017,8 @@ public:
 private:
     LLVolumeOctree* mOctree;
     LLVolumeTriangle* mOctreeTriangles;
+    std::shared_ptr<LLVolumeBVH> mBVH;
+    std::shared_ptr<LLVolumeBVHBuild> mBVHBuild;
 
     bool createUnCutCubeCap(LLVolume* volume, bool partial_build = false);
     bool createCap(LLVolume* volume, bool partial_build = false);
@@ -1011,6 +1028,7 @@ private:
 class LLVolume : public LLRefCount
 {
     friend class LLVolumeLODGroup;
+    friend class LLVolumeCache;
 
 protected:
     virtual ~LLVolume(); // use unref
@@ -1053,6 +1071,9 @@ public:
     bool isCap(S32 face);
     bool isFlat(S32 face);
     bool isUnique() const                                   { return mUnique; }
+    // Whether lineSegmentIntersect() builds face BVHs. Volumes whose faces
+    // change between picks would throw every tree away before using it.
+    virtual bool usePickBVH() const                         { return true; }
 
     S32 getSculptLevel() const                              { return mSculptLevel; }
     void setSculptLevel(S32 level)                          { mSculptLevel = level; }
@@ -1113,8 +1134,12 @@ public:
 
     // use meshoptimizer to optimize index buffer for vertex shader cache
     //  gen_tangents - if true, generate MikkTSpace tangents if needed before optimizing index buffer
+    // Faces are shared with the FACE_OPTIMIZE_QUEUE pool when there is one,
+    // the calling thread takes part and returns once every face is done.
     bool cacheOptimize(bool gen_tangents = false);
 
+    static constexpr const char* FACE_OPTIMIZE_QUEUE = "MeshFaceProcessing";
+
 private:
     void sculptGenerateMapVertices(U16 sculpt_width, U16 sculpt_height, S8 sculpt_components, const U8* sculpt_data, U8 sculpt_type);
     F32 sculptGetSurfaceArea();
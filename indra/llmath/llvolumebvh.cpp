@@ -0,0 +1,536 @@
+/**
+ * @file llvolumebvh.cpp
+ * @brief Bounding volume hierarchy over the triangles of a volume face,
+ * for line segment intersection.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "llmath.h"
+#include "llvolumebvh.h"
+
+#include <algorithm>
+
+#include "llvolume.h"
+
+namespace
+{
+    const U32 NUM_BINS = 16;
+    const U32 MAX_LEAF_TRIANGLES = 8;
+    // Cost of visiting a node, relative to testing a triangle
+    const F32 TRAVERSAL_COST = 1.f;
+    // Past this depth nodes become leaves whatever their size. The
+    // traversal stack is sized from it.
+    const U32 MAX_DEPTH = 48;
+    const S32 STACK_SIZE = 4 * (MAX_DEPTH + 2);
+    // Keeps a segment grazing a box from missing it to rounding
+    const F32 BOX_PADDING = 0.00001f;
+
+    F32 half_area(const LLVector4a& min, const LLVector4a& max)
+    {
+        LLVector4a size;
+        size.setSub(max, min);
+        return size[0] * size[1] + size[1] * size[2] + size[2] * size[0];
+    }
+}
+
+// Binned SAH build into a binary tree, then collapse into four wide nodes.
+class LLVolumeBVHBuilder
+{
+public:
+    LLVolumeBVHBuilder(LLVolumeBVH& bvh, const LLVector4a* positions, const U16* indices, U32 num_triangles);
+
+    void build();
+
+private:
+    struct BuildNode
+    {
+        LLVector4a mMin;
+        LLVector4a mMax;
+        S32 mLeft = -1;
+        S32 mRight = -1;
+        U32 mFirst = 0;
+        U32 mCount = 0;
+
+        bool isLeaf() const { return mLeft < 0; }
+    };
+
+    S32 buildNode(U32 first, U32 count, U32 depth);
+    S32 collapse(S32 build_index);
+
+    LLVolumeBVH& mBVH;
+    std::vector<LLVector4a> mTriMin;
+    std::vector<LLVector4a> mTriMax;
+    std::vector<LLVector4a> mCentroid;
+    std::vector<BuildNode> mBuildNodes;
+};
+
+LLVolumeBVHBuilder::LLVolumeBVHBuilder(LLVolumeBVH& bvh, const LLVector4a* positions, const U16* indices, U32 num_triangles)
+    : mBVH(bvh)
+{
+    mTriMin.resize(num_triangles);
+    mTriMax.resize(num_triangles);
+    mCentroid.resize(num_triangles);
+    mBVH.mTriangles.resize(num_triangles);
+    for (U32 i = 0; i < num_triangles; ++i)
+    {
+        const U16* idx = indices + i * 3;
+        const LLVector4a& v0 = positions[idx[0]];
+        const LLVector4a& v1 = positions[idx[1]];
+        const LLVector4a& v2 = positions[idx[2]];
+
+        mTriMin[i].setMin(v0, v1);
+        mTriMin[i].setMin(mTriMin[i], v2);
+        mTriMax[i].setMax(v0, v1);
+        mTriMax[i].setMax(mTriMax[i], v2);
+        mCentroid[i].setAdd(mTriMin[i], mTriMax[i]);
+        mCentroid[i].mul(0.5f);
+
+        mBVH.mTriangles[i] = i;
+    }
+}
+
+void LLVolumeBVHBuilder::build()
+{
+    const U32 num_triangles = static_cast<U32>(mBVH.mTriangles.size());
+    mBuildNodes.reserve(num_triangles * 2 / MAX_LEAF_TRIANGLES + 1);
+    S32 root = buildNode(0, num_triangles, 0);
+    collapse(root);
+}
+
+S32 LLVolumeBVHBuilder::buildNode(U32 first, U32 count, U32 depth)
+{
+    const S32 index = static_cast<S32>(mBuildNodes.size());
+    mBuildNodes.emplace_back();
+
+    U32* tris = mBVH.mTriangles.data();
+
+    LLVector4a min = mTriMin[tris[first]];
+    LLVector4a max = mTriMax[tris[first]];
+    LLVector4a cmin = mCentroid[tris[first]];
+    LLVector4a cmax = cmin;
+    for (U32 i = first + 1; i < first + count; ++i)
+    {
+        const U32 tri = tris[i];
+        min.setMin(min, mTriMin[tri]);
+        max.setMax(max, mTriMax[tri]);
+        update_min_max(cmin, cmax, mCentroid[tri]);
+    }
+    mBuildNodes[index].mMin = min;
+    mBuildNodes[index].mMax = max;
+    mBuildNodes[index].mFirst = first;
+    mBuildNodes[index].mCount = count;
+
+    if (count <= 2 || depth >= MAX_DEPTH)
+    {
+        return index;
+    }
+
+    // split along the widest spread of centroids
+    LLVector4a spread;
+    spread.setSub(cmax, cmin);
+    U32 axis = 0;
+    if (spread[1] > spread[axis])
+    {
+        axis = 1;
+    }
+    if (spread[2] > spread[axis])
+    {
+        axis = 2;
+    }
+    const F32 extent = spread[axis];
+    const F32 origin = cmin[axis];
+
+    U32 mid = first + count / 2;
+    bool median_split = true;
+
+    if (extent > 0.f)
+    {
+        const F32 scale = NUM_BINS * 0.9999f / extent;
+        auto bin_of = [&](U32 tri)
+        {
+            return llmin((U32)((mCentroid[tri][axis] - origin) * scale), NUM_BINS - 1);
+        };
+
+        U32 bin_count[NUM_BINS] = { 0 };
+        LLVector4a bin_min[NUM_BINS];
+        LLVector4a bin_max[NUM_BINS];
+        for (U32 i = first; i < first + count; ++i)
+        {
+            const U32 tri = tris[i];
+            const U32 bin = bin_of(tri);
+            if (bin_count[bin]++)
+            {
+                bin_min[bin].setMin(bin_min[bin], mTriMin[tri]);
+                bin_max[bin].setMax(bin_max[bin], mTriMax[tri]);
+            }
+            else
+            {
+                bin_min[bin] = mTriMin[tri];
+                bin_max[bin] = mTriMax[tri];
+            }
+        }
+
+        // right_cost[i] is the area weighted count of bins i and up
+        F32 right_cost[NUM_BINS];
+        U32 right_count = 0;
+        LLVector4a rmin, rmax;
+        for (S32 bin = NUM_BINS - 1; bin > 0; --bin)
+        {
+            if (bin_count[bin])
+            {
+                if (right_count)
+                {
+                    rmin.setMin(rmin, bin_min[bin]);
+                    rmax.setMax(rmax, bin_max[bin]);
+                }
+                else
+                {
+                    rmin = bin_min[bin];
+                    rmax = bin_max[bin];
+                }
+                right_count += bin_count[bin];
+            }
+            right_cost[bin] = right_count ? half_area(rmin, rmax) * right_count : 0.f;
+        }
+
+        F32 best_cost = F32_MAX;
+        U32 best_split = 0;
+        U32 left_count = 0;
+        LLVector4a lmin, lmax;
+        for (U32 split = 1; split < NUM_BINS; ++split)
+        {
+            const U32 bin = split - 1;
+            if (bin_count[bin])
+            {
+                if (left_count)
+                {
+                    lmin.setMin(lmin, bin_min[bin]);
+                    lmax.setMax(lmax, bin_max[bin]);
+                }
+                else
+                {
+                    lmin = bin_min[bin];
+                    lmax = bin_max[bin];
+                }
+                left_count += bin_count[bin];
+            }
+
+            if (left_count && left_count < count)
+            {
+                const F32 cost = half_area(lmin, lmax) * left_count + right_cost[split];
+                if (cost < best_cost)
+                {
+                    best_cost = cost;
+                    best_split = split;
+                }
+            }
+        }
+
+        const F32 area = half_area(min, max);
+        if (best_split && area > 0.f)
+        {
+            if (count <= MAX_LEAF_TRIANGLES && TRAVERSAL_COST + best_cost / area >= (F32)count)
+            {
+                return index;
+            }
+
+            U32* split_at = std::partition(tris + first, tris + first + count,
+                                           [&](U32 tri) { return bin_of(tri) < best_split; });
+            mid = static_cast<U32>(split_at - tris);
+            median_split = mid == first || mid == first + count;
+        }
+    }
+
+    if (median_split)
+    {
+        if (count <= MAX_LEAF_TRIANGLES)
+        {
+            return index;
+        }
+
+        // coincident centroids, or nothing to gain from the heuristic
+        mid = first + count / 2;
+        std::nth_element(tris + first, tris + mid, tris + first + count,
+                         [&](U32 a, U32 b) { return mCentroid[a][axis] < mCentroid[b][axis]; });
+    }
+
+    const S32 left = buildNode(first, mid - first, depth + 1);
+    const S32 right = buildNode(mid, first + count - mid, depth + 1);
+    mBuildNodes[index].mLeft = left;
+    mBuildNodes[index].mRight = right;
+    return index;
+}
+
+S32 LLVolumeBVHBuilder::collapse(S32 build_index)
+{
+    const S32 node_index = static_cast<S32>(mBVH.mNodes.size());
+    mBVH.mNodes.emplace_back();
+
+    // Pull grandchildren up, biggest first, until there are four children
+    S32 children[4];
+    U32 num_children = 0;
+    const BuildNode& build_node = mBuildNodes[build_index];
+    if (build_node.isLeaf())
+    {
+        children[num_children++] = build_index;
+    }
+    else
+    {
+        children[num_children++] = build_node.mLeft;
+        children[num_children++] = build_node.mRight;
+    }
+
+    while (num_children < 4)
+    {
+        S32 best = -1;
+        F32 best_area = -1.f;
+        for (U32 i = 0; i < num_children; ++i)
+        {
+            const BuildNode& child = mBuildNodes[children[i]];
+            if (!child.isLeaf())
+            {
+                const F32 area = half_area(child.mMin, child.mMax);
+                if (area > best_area)
+                {
+                    best_area = area;
+                    best = i;
+                }
+            }
+        }
+
+        if (best < 0)
+        {
+            break;
+        }
+
+        const BuildNode& child = mBuildNodes[children[best]];
+        children[best] = child.mLeft;
+        children[num_children++] = child.mRight;
+    }
+
+    LLVolumeBVH::Node node;
+    for (U32 axis = 0; axis < 3; ++axis)
+    {
+        node.mMin[axis].splat(F32_MAX);
+        node.mMax[axis].splat(-F32_MAX);
+    }
+
+    for (U32 i = 0; i < 4; ++i)
+    {
+        node.mChild[i] = -1;
+        node.mCount[i] = 0;
+        if (i >= num_children)
+        {
+            continue;
+        }
+
+        const BuildNode& child = mBuildNodes[children[i]];
+        for (U32 axis = 0; axis < 3; ++axis)
+        {
+            const F32 pad = (fabsf(child.mMin[axis]) + fabsf(child.mMax[axis])) * BOX_PADDING + F_APPROXIMATELY_ZERO;
+            node.mMin[axis].getF32ptr()[i] = child.mMin[axis] - pad;
+            node.mMax[axis].getF32ptr()[i] = child.mMax[axis] + pad;
+        }
+
+        if (child.isLeaf())
+        {
+            node.mChild[i] = child.mFirst;
+            node.mCount[i] = child.mCount;
+        }
+        else
+        {
+            node.mChild[i] = collapse(children[i]);
+        }
+    }
+
+    // children were appended after this node, write it back by index
+    mBVH.mNodes[node_index] = node;
+    return node_index;
+}
+
+//-----------------------------------------------------------------------------
+// LLVolumeBVH
+//-----------------------------------------------------------------------------
+
+bool LLVolumeBVH::sUseBVH = true;
+
+LLVolumeBVH::LLVolumeBVH()
+    : mNumTriangles(0)
+{
+}
+
+void LLVolumeBVH::build(const LLVector4a* positions, const U16* indices, U32 num_indices)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_VOLUME;
+
+    mNodes.clear();
+    mTriangles.clear();
+    mNumTriangles = num_indices / 3;
+    if (!mNumTriangles)
+    {
+        return;
+    }
+
+    LLVolumeBVHBuilder builder(*this, positions, indices, mNumTriangles);
+    builder.build();
+}
+
+bool LLVolumeBVH::intersect(const LLVector4a* positions, const U16* indices,
+                            const LLVector4a& start, const LLVector4a& dir,
+                            F32& closest_t, U32& triangle, F32& a, F32& b) const
+{
+    if (mNodes.empty())
+    {
+        return false;
+    }
+
+    // Clamp the direction away from zero so the slab distances stay finite
+    __m128 origin[3];
+    __m128 inv_dir[3];
+    for (U32 axis = 0; axis < 3; ++axis)
+    {
+        F32 d = dir[axis];
+        if (fabsf(d) < 1e-30f)
+        {
+            d = d < 0.f ? -1e-30f : 1e-30f;
+        }
+        origin[axis] = _mm_set1_ps(start[axis]);
+        inv_dir[axis] = _mm_set1_ps(1.f / d);
+    }
+
+    struct Entry
+    {
+        S32 mNode;
+        F32 mNear;
+    };
+    Entry stack[STACK_SIZE];
+    S32 top = 0;
+    stack[top++] = { 0, 0.f };
+
+    bool hit = false;
+    while (top > 0)
+    {
+        const Entry entry = stack[--top];
+        if (entry.mNear > closest_t)
+        {
+            continue;
+        }
+
+        const Node& node = mNodes[entry.mNode];
+
+        // slab test of the segment against the four child boxes at once
+        __m128 t_near = _mm_setzero_ps();
+        __m128 t_far = _mm_set1_ps(llmin(closest_t, 1.f));
+        for (U32 axis = 0; axis < 3; ++axis)
+        {
+            const __m128 t0 = _mm_mul_ps(_mm_sub_ps(node.mMin[axis], origin[axis]), inv_dir[axis]);
+            const __m128 t1 = _mm_mul_ps(_mm_sub_ps(node.mMax[axis], origin[axis]), inv_dir[axis]);
+            t_near = _mm_max_ps(t_near, _mm_min_ps(t0, t1));
+            t_far = _mm_min_ps(t_far, _mm_max_ps(t0, t1));
+        }
+
+        const S32 mask = _mm_movemask_ps(_mm_cmple_ps(t_near, t_far));
+        if (!mask)
+        {
+            continue;
+        }
+
+        LL_ALIGN_16(F32 near_t[4]);
+        _mm_store_ps(near_t, t_near);
+
+        // children hit, nearest first
+        S32 order[4];
+        S32 num_hit = 0;
+        for (S32 i = 0; i < 4; ++i)
+        {
+            if ((mask & (1 << i)) && node.mChild[i] >= 0)
+            {
+                S32 j = num_hit++;
+                for (; j > 0 && near_t[order[j - 1]] > near_t[i]; --j)
+                {
+                    order[j] = order[j - 1];
+                }
+                order[j] = i;
+            }
+        }
+
+        // test leaves now, push nodes far to near so the nearest comes off next
+        for (S32 j = 0; j < num_hit; ++j)
+        {
+            const S32 i = order[j];
+            const U32 count = node.mCount[i];
+            for (U32 k = 0; k < count; ++k)
+            {
+                const U32 tri = mTriangles[node.mChild[i] + k];
+                const U16* idx = indices + tri * 3;
+
+                F32 ta, tb, t;
+                if (LLTriangleRayIntersect(positions[idx[0]], positions[idx[1]], positions[idx[2]], start, dir, ta, tb, t) &&
+                    t >= 0.f && t <= 1.f && t < closest_t)
+                {
+                    closest_t = t;
+                    triangle = tri;
+                    a = ta;
+                    b = tb;
+                    hit = true;
+                }
+            }
+        }
+
+        for (S32 j = num_hit - 1; j >= 0; --j)
+        {
+            const S32 i = order[j];
+            if (!node.mCount[i])
+            {
+                llassert(top < STACK_SIZE);
+                stack[top++] = { node.mChild[i], near_t[i] };
+            }
+        }
+    }
+
+    return hit;
+}
+
+//-----------------------------------------------------------------------------
+// LLVolumeBVHBuild
+//-----------------------------------------------------------------------------
+
+LLVolumeBVHBuild::LLVolumeBVHBuild(const LLVector4a* positions, U32 num_vertices, const U16* indices, U32 num_indices)
+    : mPositions(positions, positions + num_vertices),
+      mIndices(indices, indices + num_indices),
+      mBVH(std::make_shared<LLVolumeBVH>()),
+      mDone(false)
+{
+}
+
+void LLVolumeBVHBuild::run()
+{
+    mBVH->build(mPositions.data(), mIndices.data(), static_cast<U32>(mIndices.size()));
+
+    // the copies are not needed any more
+    std::vector<LLVector4a>().swap(mPositions);
+    std::vector<U16>().swap(mIndices);
+    mDone = true;
+}
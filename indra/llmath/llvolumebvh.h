@@ -0,0 +1,105 @@
+/**
+ * @file llvolumebvh.h
+ * @brief Bounding volume hierarchy over the triangles of a volume face,
+ * for line segment intersection.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLVOLUMEBVH_H
+#define LL_LLVOLUMEBVH_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "llvector4a.h"
+
+// Replaces the LLVolumeOctree of a face for picking. The tree is built with
+// the surface area heuristic, then collapsed to four children per node and
+// stored flat, with the boxes of the four children of a node laid out so
+// one SSE test checks the segment against all of them.
+//
+// Only triangle numbers are stored, the positions and indices of the face
+// are passed to intersect(), so a tree outliving its face is harmless.
+class LLVolumeBVH
+{
+public:
+    // Use the BVH instead of the octree in LLVolume::lineSegmentIntersect()
+    static bool sUseBVH;
+
+    LLVolumeBVH();
+
+    // Build over the num_indices / 3 triangles of a face.
+    void build(const LLVector4a* positions, const U16* indices, U32 num_indices);
+
+    // Closest hit of the segment start + t * dir, 0 <= t <= 1, that is
+    // closer than closest_t. On a hit, closest_t is updated and triangle is
+    // set to the number of the triangle hit, a and b to the barycentric
+    // coordinates of the hit as LLTriangleRayIntersect() gives them.
+    bool intersect(const LLVector4a* positions, const U16* indices,
+                   const LLVector4a& start, const LLVector4a& dir,
+                   F32& closest_t, U32& triangle, F32& a, F32& b) const;
+
+    U32 getNumTriangles() const { return mNumTriangles; }
+    U32 getNumNodes() const { return static_cast<U32>(mNodes.size()); }
+
+private:
+    // Four children, their boxes stored by axis: mMin[0] holds the minimum
+    // x of all four. A child is a node when mCount is 0 and mChild is not
+    // -1, or a leaf of mCount triangles starting at mTriangles[mChild].
+    struct Node
+    {
+        LLVector4a mMin[3];
+        LLVector4a mMax[3];
+        S32 mChild[4];
+        U32 mCount[4];
+    };
+
+    std::vector<Node> mNodes;
+    std::vector<U32> mTriangles;
+    U32 mNumTriangles;
+
+    friend class LLVolumeBVHBuilder;
+};
+
+// Builds an LLVolumeBVH on a worker thread from copies of the face data, so
+// the face can change or go away in the meantime.
+class LLVolumeBVHBuild
+{
+public:
+    LLVolumeBVHBuild(const LLVector4a* positions, U32 num_vertices, const U16* indices, U32 num_indices);
+
+    // On the worker
+    void run();
+
+    bool isDone() const { return mDone; }
+    std::shared_ptr<LLVolumeBVH> getResult() const { return mDone ? mBVH : nullptr; }
+
+private:
+    std::vector<LLVector4a> mPositions;
+    std::vector<U16> mIndices;
+    std::shared_ptr<LLVolumeBVH> mBVH;
+    std::atomic<bool> mDone;
+};
+
+#endif // LL_LLVOLUMEBVH_H
@@ -0,0 +1,486 @@
+/**
+ * @file llvolumecache.cpp
+ * @brief Disk cache of the faces generated for prims and sculpties.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+
+#include "linden_common.h"
+
+#include "llmath.h"
+#include "llvolumecache.h"
+
+#include <algorithm>
+
+#include "fsyspath.h"
+#include "hbxxh.h"
+#include "llfile.h"
+#include "llmappedfile.h"
+#include "llvolume.h"
+#include "workqueue.h"
+
+namespace
+{
+    // Below this many mesh points generating the faces takes no longer than
+    // reading the entry. Only sculpties at the highest LOD get past it.
+    const S32 MIN_CACHED_MESH_POINTS = 1024;
+
+    // Outer sides, inner side, profile and path ends of a prim
+    const U32 MAX_VOLUME_FACES = 9;
+
+    const U32 ENTRY_MAGIC = 0x43564c4c; // "LLVC"
+    const char* ENTRY_EXTENSION = ".vol";
+
+    struct EntryHeader
+    {
+        U32 mMagic;
+        U32 mVersion;
+        U64 mKey;
+        U32 mNumFaces;
+        U32 mNumMeshPoints;
+        F32 mSurfaceArea;
+    };
+
+    struct FaceHeader
+    {
+        S32 mID;
+        U32 mTypeMask;
+        S32 mBeginS;
+        S32 mBeginT;
+        S32 mNumS;
+        S32 mNumT;
+        S32 mNumVertices;
+        S32 mNumIndices;
+        LLVector4a mExtents[3];
+        LLVector2 mTexCoordExtents[2];
+    };
+
+    // Entries are read with memcpy, the mapping has no alignment to speak of
+    class EntryReader
+    {
+    public:
+        EntryReader(const U8* data, size_t size)
+        :   mData(data),
+            mSize(size),
+            mOffset(0)
+        {
+        }
+
+        bool read(void* dst, size_t bytes)
+        {
+            if (bytes > mSize - mOffset)
+            {
+                return false;
+            }
+            memcpy(dst, mData + mOffset, bytes);
+            mOffset += bytes;
+            return true;
+        }
+
+        bool isDone() const { return mOffset == mSize; }
+
+    private:
+        const U8* mData;
+        size_t mSize;
+        size_t mOffset;
+    };
+
+    void append(std::vector<U8>& data, const void* src, size_t bytes)
+    {
+        const U8* bytes_src = (const U8*)src;
+        data.insert(data.end(), bytes_src, bytes_src + bytes);
+    }
+
+    template<typename T>
+    void hash_value(HBXXH64& hash, const T& value)
+    {
+        hash.update((const void*)&value, sizeof(T));
+    }
+
+    bool read_face(EntryReader& reader, LLVolumeFace& face)
+    {
+        FaceHeader header;
+        if (!reader.read(&header, sizeof(header)))
+        {
+            return false;
+        }
+
+        if (header.mNumVertices < 0 || header.mNumVertices > 65536 ||
+            header.mNumIndices < 0 || header.mNumIndices % 3 != 0)
+        {
+            return false;
+        }
+
+        face.mID = header.mID;
+        face.mTypeMask = header.mTypeMask;
+        face.mBeginS = header.mBeginS;
+        face.mBeginT = header.mBeginT;
+        face.mNumS = header.mNumS;
+        face.mNumT = header.mNumT;
+        face.mExtents[0] = header.mExtents[0];
+        face.mExtents[1] = header.mExtents[1];
+        *face.mCenter = header.mExtents[2];
+        face.mTexCoordExtents[0] = header.mTexCoordExtents[0];
+        face.mTexCoordExtents[1] = header.mTexCoordExtents[1];
+
+        const S32 num_vertices = header.mNumVertices;
+        const S32 num_indices = header.mNumIndices;
+        face.resizeVertices(num_vertices);
+        face.resizeIndices(num_indices);
+        if (face.mNumVertices != num_vertices || face.mNumIndices != num_indices)
+        { //out of memory
+            return false;
+        }
+
+        if (!reader.read(face.mPositions, sizeof(LLVector4a) * num_vertices) ||
+            !reader.read(face.mNormals, sizeof(LLVector4a) * num_vertices) ||
+            !reader.read(face.mTexCoords, sizeof(LLVector2) * num_vertices) ||
+            !reader.read(face.mIndices, sizeof(U16) * num_indices))
+        {
+            return false;
+        }
+
+        // A damaged entry must not index past the vertices
+        for (S32 i = 0; i < num_indices; ++i)
+        {
+            if (face.mIndices[i] >= num_vertices)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void write_face(std::vector<U8>& data, const LLVolumeFace& face)
+    {
+        FaceHeader header;
+        header.mID = face.mID;
+        header.mTypeMask = face.mTypeMask;
+        header.mBeginS = face.mBeginS;
+        header.mBeginT = face.mBeginT;
+        header.mNumS = face.mNumS;
+        header.mNumT = face.mNumT;
+        header.mNumVertices = face.mNumVertices;
+        header.mNumIndices = face.mNumIndices;
+        header.mExtents[0] = face.mExtents[0];
+        header.mExtents[1] = face.mExtents[1];
+        header.mExtents[2] = *face.mCenter;
+        header.mTexCoordExtents[0] = face.mTexCoordExtents[0];
+        header.mTexCoordExtents[1] = face.mTexCoordExtents[1];
+        append(data, &header, sizeof(header));
+
+        append(data, face.mPositions, sizeof(LLVector4a) * face.mNumVertices);
+        append(data, face.mNormals, sizeof(LLVector4a) * face.mNumVertices);
+        append(data, face.mTexCoords, sizeof(LLVector2) * face.mNumVertices);
+        append(data, face.mIndices, sizeof(U16) * face.mNumIndices);
+    }
+}
+
+bool LLVolumeCache::sEnabled = false;
+bool LLVolumeCache::sReadOnly = false;
+std::string LLVolumeCache::sDir;
+std::atomic<U32> LLVolumeCache::sHits(0);
+std::atomic<U32> LLVolumeCache::sMisses(0);
+
+//static
+void LLVolumeCache::initClass(const std::string& dir, U64 max_bytes, bool read_only)
+{
+    sDir = dir;
+    sReadOnly = read_only;
+    sHits = 0;
+    sMisses = 0;
+
+    if (!read_only)
+    {
+        LLFile::mkdir(dir);
+        purge(max_bytes);
+    }
+    sEnabled = LLFile::isdir(dir);
+
+    LL_INFOS("VolumeCache") << "Volume geometry cache " << (sEnabled ? "in " : "disabled, no directory ") << dir << LL_ENDL;
+}
+
+//static
+void LLVolumeCache::cleanupClass()
+{
+    if (sEnabled)
+    {
+        LL_INFOS("VolumeCache") << "Volume geometry cache hits: " << sHits << " misses: " << sMisses << LL_ENDL;
+    }
+    sEnabled = false;
+}
+
+//static
+bool LLVolumeCache::isCacheable(const LLVolume* volume)
+{
+    const LLVolumeParams& params = volume->getParams();
+    return sEnabled &&
+        params.isSculpt() && !params.isMeshSculpt() &&
+        !volume->isUnique() &&
+        !volume->mGenerateSingleFace &&
+        volume->getPathType() != LL_PCODE_PATH_FLEXIBLE &&
+        (S32)volume->mMesh.size() >= MIN_CACHED_MESH_POINTS;
+}
+
+//static
+U64 LLVolumeCache::getKey(const LLVolumeParams& params, F32 detail,
+                          S32 sculpt_level, U16 sculpt_width, U16 sculpt_height,
+                          S8 sculpt_components, bool visible_placeholder)
+{
+    HBXXH64 hash;
+    hash_value(hash, CACHE_VERSION);
+
+    const LLProfileParams& profile = params.getProfileParams();
+    hash_value(hash, profile.getCurveType());
+    hash_value(hash, profile.getBegin());
+    hash_value(hash, profile.getEnd());
+    hash_value(hash, profile.getHollow());
+
+    const LLPathParams& path = params.getPathParams();
+    hash_value(hash, path.getCurveType());
+    hash_value(hash, path.getBegin());
+    hash_value(hash, path.getEnd());
+    hash_value(hash, path.getScale());
+    hash_value(hash, path.getShear());
+    hash_value(hash, path.getTwistBegin());
+    hash_value(hash, path.getTwistEnd());
+    hash_value(hash, path.getRadiusOffset());
+    hash_value(hash, path.getTaper());
+    hash_value(hash, path.getRevolutions());
+    hash_value(hash, path.getSkew());
+
+    hash_value(hash, params.getSculptID());
+    hash_value(hash, params.getSculptType());
+
+    hash_value(hash, detail);
+    hash_value(hash, sculpt_level);
+    hash_value(hash, sculpt_width);
+    hash_value(hash, sculpt_height);
+    hash_value(hash, sculpt_components);
+    hash_value(hash, visible_placeholder);
+
+    return hash.digest();
+}
+
+//static
+bool LLVolumeCache::load(U64 key, LLVolume* volume)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_VOLUME;
+
+    const std::string filename = getFilename(key);
+
+    LLMappedFile file;
+    if (!file.open(filename))
+    {
+        ++sMisses;
+        return false;
+    }
+
+    EntryReader reader(file.getData(), file.getSize());
+    EntryHeader header;
+    bool valid = reader.read(&header, sizeof(header)) &&
+        header.mMagic == ENTRY_MAGIC &&
+        header.mVersion == CACHE_VERSION &&
+        header.mKey == key &&
+        header.mNumFaces <= MAX_VOLUME_FACES &&
+        header.mNumMeshPoints == volume->mMesh.size();
+
+    // calcSurfaceArea() and the like read the mesh points after the faces
+    // are made, so they are kept along
+    std::vector<LLVector4a> mesh;
+    LLVolume::face_list_t faces;
+    if (valid)
+    {
+        mesh.resize(header.mNumMeshPoints);
+        valid = reader.read(mesh.data(), sizeof(LLVector4a) * mesh.size());
+    }
+    if (valid)
+    {
+        faces.resize(header.mNumFaces);
+        for (LLVolumeFace& face : faces)
+        {
+            if (!read_face(reader, face))
+            {
+                valid = false;
+                break;
+            }
+        }
+        valid = valid && reader.isDone();
+    }
+    file.close();
+
+    if (!valid)
+    {
+        LL_WARNS("VolumeCache") << "Removing damaged entry " << filename << LL_ENDL;
+        if (!sReadOnly)
+        {
+            LLFile::remove(filename);
+        }
+        ++sMisses;
+        return false;
+    }
+
+    volume->mVolumeFaces.swap(faces);
+    memcpy(volume->mMesh.mArray, mesh.data(), sizeof(LLVector4a) * mesh.size());
+    volume->mSurfaceArea = header.mSurfaceArea;
+
+    if (!sReadOnly)
+    { //purge() goes by write time, keep entries in use
+        std::error_code ec;
+        std::filesystem::last_write_time(fsyspath(filename), std::filesystem::file_time_type::clock::now(), ec);
+    }
+
+    ++sHits;
+    return true;
+}
+
+//static
+void LLVolumeCache::store(U64 key, const LLVolume* volume)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_VOLUME;
+
+    if (!sEnabled || sReadOnly)
+    {
+        return;
+    }
+
+    EntryHeader header;
+    header.mMagic = ENTRY_MAGIC;
+    header.mVersion = CACHE_VERSION;
+    header.mKey = key;
+    header.mNumFaces = (U32)volume->mVolumeFaces.size();
+    header.mNumMeshPoints = volume->mMesh.size();
+    header.mSurfaceArea = volume->mSurfaceArea;
+
+    std::vector<U8> data;
+    append(data, &header, sizeof(header));
+    append(data, volume->mMesh.mArray, sizeof(LLVector4a) * volume->mMesh.size());
+    for (const LLVolumeFace& face : volume->mVolumeFaces)
+    {
+        write_face(data, face);
+    }
+
+    std::string filename = getFilename(key);
+
+    LL::WorkQueue::ptr_t general_queue = LL::WorkQueue::getInstance("General");
+    if (general_queue)
+    {
+        if (general_queue->post([filename, data = std::move(data)]() { write(filename, data); }))
+        {
+            return;
+        }
+    }
+
+    write(filename, data);
+}
+
+//static
+std::string LLVolumeCache::getFilename(U64 key)
+{
+    return sDir + "/" + llformat("%016llx", (unsigned long long)key) + ENTRY_EXTENSION;
+}
+
+//static
+void LLVolumeCache::write(const std::string& filename, const std::vector<U8>& data)
+{
+    // Written aside and renamed into place, so no reader maps a partial
+    // entry
+    static std::atomic<U32> sNextTemp(0);
+    const std::string temp_filename = filename + llformat(".%u.tmp", sNextTemp++);
+
+    LLFILE* fp = LLFile::fopen(temp_filename, "wb");
+    if (!fp)
+    {
+        return;
+    }
+    const bool written = fwrite(data.data(), 1, data.size(), fp) == data.size();
+    LLFile::close(fp);
+
+    if (!written || LLFile::rename(temp_filename, filename, EEXIST) != 0)
+    {
+        LLFile::remove(temp_filename);
+    }
+}
+
+//static
+void LLVolumeCache::purge(U64 max_bytes)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_VOLUME;
+
+    struct Entry
+    {
+        std::filesystem::file_time_type mTime;
+        U64 mSize;
+        fsyspath mPath;
+    };
+    std::vector<Entry> entries;
+    U64 total_bytes = 0;
+
+    std::error_code ec;
+    for (const auto& dir_entry : std::filesystem::directory_iterator(fsyspath(sDir), ec))
+    {
+        if (!dir_entry.is_regular_file(ec))
+        {
+            continue;
+        }
+
+        const fsyspath& path = dir_entry.path();
+        if (path.extension() != ENTRY_EXTENSION)
+        { //left over from a write that did not finish
+            std::filesystem::remove(path, ec);
+            continue;
+        }
+
+        Entry entry;
+        entry.mTime = dir_entry.last_write_time(ec);
+        entry.mSize = dir_entry.file_size(ec);
+        entry.mPath = path;
+        total_bytes += entry.mSize;
+        entries.push_back(entry);
+    }
+
+    if (total_bytes <= max_bytes)
+    {
+        return;
+    }
+
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry& a, const Entry& b) { return a.mTime < b.mTime; });
+
+    S32 removed = 0;
+    for (const Entry& entry : entries)
+    {
+        if (total_bytes <= max_bytes)
+        {
+            break;
+        }
+        if (std::filesystem::remove(entry.mPath, ec))
+        {
+            total_bytes -= entry.mSize;
+            ++removed;
+        }
+    }
+
+    LL_INFOS("VolumeCache") << "Purged " << removed << " volume cache entries" << LL_ENDL;
+}
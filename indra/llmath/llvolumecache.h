@@ -0,0 +1,96 @@
+/**
+ * @file llvolumecache.h
+ * @brief Disk cache of the faces generated for sculpties.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLVOLUMECACHE_H
+#define LL_LLVOLUMECACHE_H
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+class LLVolume;
+class LLVolumeParams;
+
+// Keeps the faces and mesh points of sculpted volumes on disk, so a
+// sculptie seen in an earlier session is read back instead of sampled and
+// generated again. An entry is keyed by everything the faces are generated
+// from: the volume params, the detail of the LOD and the size and discard
+// level of the sculpt texture data. Entries are read through a mapping of the file and
+// written on the General work queue.
+//
+// Only detailed faces are worth it. Reading an entry costs about as much as
+// generating a plain prim or a sculptie below the highest LOD, those are
+// always generated.
+class LLVolumeCache
+{
+public:
+    // Bump when the output of LLVolume::sculpt() or LLVolumeFace::create()
+    // changes.
+    static constexpr U32 CACHE_VERSION = 2;
+
+    // Cache in dir, trimmed to max_bytes by removing the least recently
+    // used entries. A read only cache never writes or removes entries.
+    static void initClass(const std::string& dir, U64 max_bytes, bool read_only);
+    static void cleanupClass();
+
+    // Removes every entry
+    static void clear();
+
+    static bool isEnabled() { return sEnabled; }
+
+    // Whether generating the faces of volume costs enough to go through the
+    // cache. Only sculpties qualify, and of those not unique volumes,
+    // flexible paths or small meshes.
+    static bool isCacheable(const LLVolume* volume);
+
+    static U64 getKey(const LLVolumeParams& params, F32 detail,
+                      S32 sculpt_level, U16 sculpt_width, U16 sculpt_height,
+                      S8 sculpt_components, bool visible_placeholder);
+
+    // Replaces the faces and mesh points of volume with the cached ones,
+    // mMesh must already have the size sculpt() gave it. False on a miss,
+    // volume is then left alone.
+    static bool load(U64 key, LLVolume* volume);
+
+    // Writes the faces and mesh points of volume
+    static void store(U64 key, const LLVolume* volume);
+
+    static U32 getHits()    { return sHits; }
+    static U32 getMisses()  { return sMisses; }
+
+private:
+    static std::string getFilename(U64 key);
+    static void purge(U64 max_bytes);
+    static void write(const std::string& filename, const std::vector<U8>& data);
+
+    static bool sEnabled;
+    static bool sReadOnly;
+    static std::string sDir;
+    static std::atomic<U32> sHits;
+    static std::atomic<U32> sMisses;
+};
+
+#endif // LL_LLVOLUMECACHE_H
@@ -0,0 +1,212 @@
+/**
+ * @file   llcamera_test.cpp
+ * @brief  Batched AABB frustum tests of LLCamera against the single box tests.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include <random>
+#include <vector>
+
+#include "../llcamera.h"
+#include "../test/lltut.h"
+
+namespace
+{
+    const S32 NUM_BOXES = 20000;
+    const F32 SCENE_SIZE = 512.f;
+
+    // Camera at the middle of the scene looking along +X with a 256m far clip.
+    void setup_camera(LLCamera& camera)
+    {
+        const F32 near_clip = 0.5f;
+        const F32 far_clip = 256.f;
+        const F32 half_height = tanf(camera.getView() * 0.5f);
+        const F32 half_width = half_height * camera.getAspect();
+
+        LLVector3 origin(SCENE_SIZE * 0.5f, SCENE_SIZE * 0.5f, 30.f);
+        camera.setOrigin(origin);
+        camera.setNear(near_clip);
+        camera.setFar(far_clip);
+
+        const LLVector3 at = camera.getAtAxis();
+        const LLVector3 left = camera.getLeftAxis();
+        const LLVector3 up = camera.getUpAxis();
+
+        // Near then far corners: bottom left, bottom right, top right, top left.
+        LLVector3 frust[8];
+        const F32 dist[2] = { near_clip, far_clip };
+        for (S32 i = 0; i < 2; ++i)
+        {
+            LLVector3 center = origin + at * dist[i];
+            LLVector3 w = left * (half_width * dist[i]);
+            LLVector3 h = up * (half_height * dist[i]);
+            frust[i * 4 + 0] = center + w - h;
+            frust[i * 4 + 1] = center - w - h;
+            frust[i * 4 + 2] = center - w + h;
+            frust[i * 4 + 3] = center + w + h;
+        }
+        camera.calcAgentFrustumPlanes(frust);
+    }
+
+    // The batched and single box tests sum the plane distances in a
+    // different order, so a box touching a plane to within rounding may
+    // legitimately get a different answer.
+    bool touches_plane(const LLPlane* planes, const LLVector4a& center, const LLVector4a& radius)
+    {
+        for (U32 i = 0; i < LLCamera::AGENT_PLANE_USER_CLIP_NUM; ++i)
+        {
+            const LLPlane& p = planes[i];
+            F32 dist = p[3];
+            F32 extent = 0.f;
+            for (U32 axis = 0; axis < 3; ++axis)
+            {
+                dist += p[axis] * center[axis];
+                extent += fabsf(p[axis]) * radius[axis];
+            }
+            if (fabsf(dist - extent) < 0.001f || fabsf(dist + extent) < 0.001f)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+namespace tut
+{
+    struct camera_data
+    {
+        std::vector<LLVector4a> mCenters;
+        std::vector<LLVector4a> mRadii;
+        LLCamera                mCamera;
+
+        camera_data()
+        {
+            std::mt19937 rng(4321);
+            std::uniform_real_distribution<F32> pos(0.f, SCENE_SIZE);
+            std::uniform_real_distribution<F32> height(0.f, 128.f);
+            std::uniform_real_distribution<F32> extent(0.05f, 16.f);
+
+            mCenters.resize(NUM_BOXES);
+            mRadii.resize(NUM_BOXES);
+            for (S32 i = 0; i < NUM_BOXES; ++i)
+            {
+                mCenters[i].set(pos(rng), pos(rng), height(rng));
+                mRadii[i].set(extent(rng), extent(rng), extent(rng));
+            }
+
+            setup_camera(mCamera);
+        }
+
+        // Compare the batched tests against the single box tests for every
+        // count up to 17, so all 4 and 8 box remainders are covered, then for
+        // all boxes at once.
+        void check_batched(const char* name, bool no_far_clip, const LLPlane* planes)
+        {
+            std::vector<S32> results(NUM_BOXES);
+            S32 visible = 0;
+            for (U32 count = 0; count <= NUM_BOXES; count = (count < 17) ? count + 1 : NUM_BOXES)
+            {
+                if (no_far_clip)
+                {
+                    mCamera.AABBsInFrustumNoFarClip(mCenters.data(), mRadii.data(), count, results.data(), planes);
+                }
+                else
+                {
+                    mCamera.AABBsInFrustum(mCenters.data(), mRadii.data(), count, results.data(), planes);
+                }
+
+                visible = 0;
+                for (U32 i = 0; i < count; ++i)
+                {
+                    S32 expected = no_far_clip ? mCamera.AABBInFrustumNoFarClip(mCenters[i], mRadii[i], planes)
+                                               : mCamera.AABBInFrustum(mCenters[i], mRadii[i], planes);
+                    if (results[i] != expected)
+                    {
+                        ensure(name, touches_plane(planes, mCenters[i], mRadii[i]));
+                    }
+                    visible += expected ? 1 : 0;
+                }
+
+                if (count == NUM_BOXES)
+                {
+                    break;
+                }
+            }
+
+            ensure("something visible", visible > 0);
+            ensure("something culled", visible < NUM_BOXES);
+        }
+    };
+    typedef test_group<camera_data> camera_group;
+    typedef camera_group::object camera_object;
+    tut::camera_group camera_testgroup("LLCamera");
+
+    template<> template<>
+    void camera_object::test<1>()
+    {
+        set_test_name("batched AABB tests match single box tests");
+
+        const LLPlane* planes = &mCamera.getAgentPlane(0);
+        check_batched("AABBsInFrustum", false, planes);
+        check_batched("AABBsInFrustumNoFarClip", true, planes);
+    }
+
+    template<> template<>
+    void camera_object::test<2>()
+    {
+        set_test_name("batched AABB tests with user clip and ignored planes");
+
+        // Clip away everything below 40m
+        LLPlane clip(LLVector3(0.f, 0.f, 40.f), LLVector3(0.f, 0.f, -1.f));
+        mCamera.setUserClipPlane(clip);
+        mCamera.ignoreAgentFrustumPlane(LLCamera::AGENT_PLANE_NEAR);
+
+        const LLPlane* planes = &mCamera.getAgentPlane(0);
+        check_batched("AABBsInFrustum, user clip", false, planes);
+        check_batched("AABBsInFrustumNoFarClip, user clip", true, planes);
+    }
+
+    template<> template<>
+    void camera_object::test<3>()
+    {
+        set_test_name("batched AABB test every box inside");
+
+        // Camera in the middle of a box bigger than the far clip
+        LLVector4a center(SCENE_SIZE * 0.5f, SCENE_SIZE * 0.5f, 30.f);
+        LLVector4a radius;
+        radius.splat(1024.f);
+
+        S32 result = -1;
+        mCamera.AABBsInFrustum(&center, &radius, 1, &result);
+        ensure_equals("partly in", result, mCamera.AABBInFrustum(center, radius));
+
+        // Tiny box straight ahead of the camera
+        center.set(SCENE_SIZE * 0.5f + 10.f, SCENE_SIZE * 0.5f, 30.f);
+        radius.splat(0.1f);
+        mCamera.AABBsInFrustum(&center, &radius, 1, &result);
+        ensure_equals("fully in", result, 2);
+    }
+}
@@ -0,0 +1,299 @@
+/**
+ * @file   lloctreecull_test.cpp
+ * @brief  Frustum culling of per region octrees, serial versus split across
+ *         worker threads the way LLPipeline::updateCull() does it.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../llcamera.h"
+#include "../lloctree.h"
+#include "../test/lltut.h"
+
+namespace
+{
+    // A 3x3 block of regions with one octree each, like the spatial
+    // partitions of the regions around the agent.
+    const S32 REGION_GRID = 3;
+    const F32 REGION_WIDTH = 256.f;
+    const S32 ENTRIES_PER_REGION = 20000;
+    const F32 MAX_ENTRY_RADIUS = 8.f;
+    const S32 NUM_WORKERS = 3;
+
+    // Stand in for LLViewerOctreeEntry: an axis aligned box binned by its center.
+    struct CullEntry
+    {
+        LLVector4a  mCenter;
+        LLVector4a  mHalfSize;
+        F32         mBinRadius;
+        S32         mBinIndex;
+
+        const LLVector4a& getPositionGroup() const { return mCenter; }
+        F32 getBinRadius() const { return mBinRadius; }
+        S32 getBinIndex() const { return mBinIndex; }
+        void setBinIndex(S32 index) { mBinIndex = index; }
+    };
+
+    typedef LLOctreeNode<CullEntry, CullEntry*> CullNode;
+    typedef LLOctreeRoot<CullEntry, CullEntry*> CullRoot;
+    typedef std::vector<const CullEntry*> cull_result_t;
+
+    void add_all(const CullNode* node, cull_result_t& result)
+    {
+        for (CullNode::const_element_iter iter = node->getDataBegin(); iter != node->getDataEnd(); ++iter)
+        {
+            result.push_back(*iter);
+        }
+        for (U32 i = 0; i < node->getChildCount(); ++i)
+        {
+            add_all(node->getChild(i), result);
+        }
+    }
+
+    // Elements may stick out of their node by up to their bin radius, so
+    // test nodes against loose bounds. Nodes entirely in the frustum skip
+    // the per element tests.
+    void cull_node(LLCamera& camera, const CullNode* node, cull_result_t& result)
+    {
+        LLVector4a loose_size;
+        loose_size.splat(MAX_ENTRY_RADIUS);
+        loose_size.add(node->getSize());
+
+        S32 res = camera.AABBInFrustum(node->getCenter(), loose_size);
+        if (res == 0)
+        {
+            return;
+        }
+        if (res == 2)
+        {
+            add_all(node, result);
+            return;
+        }
+
+        for (CullNode::const_element_iter iter = node->getDataBegin(); iter != node->getDataEnd(); ++iter)
+        {
+            const CullEntry* entry = *iter;
+            if (camera.AABBInFrustum(entry->mCenter, entry->mHalfSize))
+            {
+                result.push_back(entry);
+            }
+        }
+        for (U32 i = 0; i < node->getChildCount(); ++i)
+        {
+            cull_node(camera, node->getChild(i), result);
+        }
+    }
+
+    void cull_serial(LLCamera& camera, const std::vector<CullRoot*>& roots, cull_result_t& result)
+    {
+        result.clear();
+        for (const CullRoot* root : roots)
+        {
+            cull_node(camera, root, result);
+        }
+    }
+
+    // Same scheme as LLPipeline::cullPartitionsParallel(): workers pull
+    // octrees off a shared counter into per octree results, which are then
+    // appended in octree order.
+    void cull_parallel(LLCamera& camera, const std::vector<CullRoot*>& roots,
+                       std::vector<cull_result_t>& partial, cull_result_t& result)
+    {
+        const size_t count = roots.size();
+        partial.resize(count);
+
+        std::atomic<size_t> next_root(0);
+        auto cull_roots = [&]()
+        {
+            for (size_t i = next_root++; i < count; i = next_root++)
+            {
+                partial[i].clear();
+                cull_node(camera, roots[i], partial[i]);
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (S32 i = 0; i < NUM_WORKERS; ++i)
+        {
+            workers.emplace_back(cull_roots);
+        }
+        cull_roots();
+        for (std::thread& worker : workers)
+        {
+            worker.join();
+        }
+
+        result.clear();
+        for (const cull_result_t& part : partial)
+        {
+            result.insert(result.end(), part.begin(), part.end());
+        }
+    }
+
+    // Camera in the middle region looking along +X, with a far clip that
+    // reaches into the regions ahead and to either side.
+    void setup_camera(LLCamera& camera)
+    {
+        const F32 near_clip = 0.5f;
+        const F32 far_clip = 512.f;
+        const F32 half_height = tanf(camera.getView() * 0.5f);
+        const F32 half_width = half_height * camera.getAspect();
+
+        LLVector3 origin(REGION_WIDTH * 1.5f, REGION_WIDTH * 1.5f, 30.f);
+        camera.setOrigin(origin);
+        camera.setNear(near_clip);
+        camera.setFar(far_clip);
+
+        const LLVector3 at = camera.getAtAxis();
+        const LLVector3 left = camera.getLeftAxis();
+        const LLVector3 up = camera.getUpAxis();
+
+        // Near then far corners: bottom left, bottom right, top right, top left.
+        LLVector3 frust[8];
+        const F32 dist[2] = { near_clip, far_clip };
+        for (S32 i = 0; i < 2; ++i)
+        {
+            LLVector3 center = origin + at * dist[i];
+            LLVector3 w = left * (half_width * dist[i]);
+            LLVector3 h = up * (half_height * dist[i]);
+            frust[i * 4 + 0] = center + w - h;
+            frust[i * 4 + 1] = center - w - h;
+            frust[i * 4 + 2] = center - w + h;
+            frust[i * 4 + 3] = center + w + h;
+        }
+        camera.calcAgentFrustumPlanes(frust);
+    }
+}
+
+namespace tut
+{
+    struct octreecull_data
+    {
+        std::vector<CullEntry*> mEntries;
+        std::vector<CullRoot*>  mRoots;
+        LLCamera                mCamera;
+
+        octreecull_data()
+        {
+            gOctreeMaxCapacity = 128;
+            gOctreeMinSize = 0.01f;
+
+            std::mt19937 rng(1234);
+            std::uniform_real_distribution<F32> pos(0.f, REGION_WIDTH);
+            std::uniform_real_distribution<F32> height(0.f, 128.f);
+            std::uniform_real_distribution<F32> extent(0.05f, MAX_ENTRY_RADIUS / 2.f);
+
+            for (S32 y = 0; y < REGION_GRID; ++y)
+            {
+                for (S32 x = 0; x < REGION_GRID; ++x)
+                {
+                    LLVector4a origin(x * REGION_WIDTH, y * REGION_WIDTH, 0.f);
+                    LLVector4a center(REGION_WIDTH * 0.5f, REGION_WIDTH * 0.5f, REGION_WIDTH * 0.5f);
+                    center.add(origin);
+                    LLVector4a size;
+                    size.splat(REGION_WIDTH);
+                    CullRoot* root = new CullRoot(center, size, NULL);
+
+                    for (S32 i = 0; i < ENTRIES_PER_REGION; ++i)
+                    {
+                        CullEntry* entry = new CullEntry;
+                        entry->mCenter.set(pos(rng), pos(rng), height(rng));
+                        entry->mCenter.add(origin);
+                        entry->mHalfSize.set(extent(rng), extent(rng), extent(rng));
+                        entry->mBinRadius = entry->mHalfSize.getLength3().getF32();
+                        entry->mBinIndex = -1;
+                        root->insert(entry);
+                        mEntries.push_back(entry);
+                    }
+                    mRoots.push_back(root);
+                }
+            }
+
+            setup_camera(mCamera);
+        }
+
+        ~octreecull_data()
+        {
+            for (CullRoot* root : mRoots)
+            {
+                delete root;
+            }
+            for (CullEntry* entry : mEntries)
+            {
+                delete entry;
+            }
+        }
+    };
+    typedef test_group<octreecull_data> octreecull_group;
+    typedef octreecull_group::object octreecull_object;
+    tut::octreecull_group octreecull_testgroup("LLOctree culling");
+
+    template<> template<>
+    void octreecull_object::test<1>()
+    {
+        set_test_name("octree cull matches brute force");
+
+        cull_result_t culled;
+        cull_serial(mCamera, mRoots, culled);
+
+        cull_result_t expected;
+        for (const CullEntry* entry : mEntries)
+        {
+            if (mCamera.AABBInFrustum(entry->mCenter, entry->mHalfSize))
+            {
+                expected.push_back(entry);
+            }
+        }
+
+        ensure("something visible", !expected.empty());
+        ensure("something culled", expected.size() < mEntries.size());
+        ensure_equals("visible count", culled.size(), expected.size());
+
+        std::sort(culled.begin(), culled.end());
+        std::sort(expected.begin(), expected.end());
+        ensure("same entries", culled == expected);
+    }
+
+    template<> template<>
+    void octreecull_object::test<2>()
+    {
+        set_test_name("parallel cull matches serial cull");
+
+        cull_result_t serial;
+        cull_serial(mCamera, mRoots, serial);
+
+        std::vector<cull_result_t> partial;
+        cull_result_t parallel;
+        cull_parallel(mCamera, mRoots, partial, parallel);
+
+        // Merging in octree order keeps the draw order stable
+        ensure("same entries in the same order", serial == parallel);
+    }
+}
@@ -0,0 +1,312 @@
+/**
+ * @file   lloctreelinear_test.cpp
+ * @brief  LLOctreeLinear traversals against the pointer linked LLOctreeNode
+ *         tree they are packed from.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include <random>
+#include <vector>
+
+#include "../llcamera.h"
+#include "../lloctree.h"
+#include "../lloctreelinear.h"
+#include "../llvolume.h"
+#include "../test/lltut.h"
+
+namespace
+{
+    const S32 NUM_ENTRIES = 100000;
+    const F32 WORLD_WIDTH = 512.f;
+    const F32 MAX_ENTRY_RADIUS = 8.f;
+    const S32 NUM_SEGMENTS = 2000;
+
+    struct LinearEntry
+    {
+        LLVector4a  mCenter;
+        LLVector4a  mHalfSize;
+        F32         mBinRadius;
+        S32         mBinIndex;
+
+        const LLVector4a& getPositionGroup() const { return mCenter; }
+        F32 getBinRadius() const { return mBinRadius; }
+        S32 getBinIndex() const { return mBinIndex; }
+        void setBinIndex(S32 index) { mBinIndex = index; }
+    };
+
+    typedef LLOctreeNode<LinearEntry, LinearEntry*> LinearNode;
+    typedef LLOctreeRoot<LinearEntry, LinearEntry*> LinearRoot;
+    typedef LLOctreeLinear<LinearEntry, LinearEntry*> LinearTree;
+    typedef std::vector<const LinearEntry*> entry_list_t;
+
+    // Reference traversals over the linked tree, in the style of the
+    // LLOctreeTraveler based culls.
+    void add_all(const LinearNode* node, entry_list_t& result)
+    {
+        result.insert(result.end(), node->getDataBegin(), node->getDataEnd());
+        for (U32 i = 0; i < node->getChildCount(); ++i)
+        {
+            add_all(node->getChild(i), result);
+        }
+    }
+
+    void cull_linked(LLCamera& camera, const LLVector4a& pad, const LinearNode* node, entry_list_t& result)
+    {
+        LLVector4a loose_size;
+        loose_size.setAdd(node->getSize(), pad);
+        S32 res = camera.AABBInFrustum(node->getCenter(), loose_size);
+        if (res == 0)
+        {
+            return;
+        }
+        if (res == 2)
+        {
+            add_all(node, result);
+            return;
+        }
+        result.insert(result.end(), node->getDataBegin(), node->getDataEnd());
+        for (U32 i = 0; i < node->getChildCount(); ++i)
+        {
+            cull_linked(camera, pad, node->getChild(i), result);
+        }
+    }
+
+    void intersect_linked(const LLVector4a& start, const LLVector4a& end, const LLVector4a& pad,
+                          const LinearNode* node, entry_list_t& result)
+    {
+        LLVector4a loose_size;
+        loose_size.setAdd(node->getSize(), pad);
+        if (!LLLineSegmentBoxIntersect(start, end, node->getCenter(), loose_size))
+        {
+            return;
+        }
+        for (LinearNode::const_element_iter iter = node->getDataBegin(); iter != node->getDataEnd(); ++iter)
+        {
+            if (LLLineSegmentBoxIntersect(start, end, (*iter)->mCenter, (*iter)->mHalfSize))
+            {
+                result.push_back(*iter);
+            }
+        }
+        for (U32 i = 0; i < node->getChildCount(); ++i)
+        {
+            intersect_linked(start, end, pad, node->getChild(i), result);
+        }
+    }
+
+    void intersect_linear(const LLVector4a& start, const LLVector4a& end, const LLVector4a& pad,
+                          const LinearTree& tree, entry_list_t& result)
+    {
+        tree.traverse(
+            [&](U32 index, const LLVector4a& center, const LLVector4a& size) -> S32
+            {
+                LLVector4a loose_size;
+                loose_size.setAdd(size, pad);
+                return LLLineSegmentBoxIntersect(start, end, center, loose_size) ? LinearTree::NODE_PARTIAL : LinearTree::NODE_OUTSIDE;
+            },
+            [&](const LinearEntry* entry)
+            {
+                if (LLLineSegmentBoxIntersect(start, end, entry->mCenter, entry->mHalfSize))
+                {
+                    result.push_back(entry);
+                }
+            });
+    }
+
+    void setup_camera(LLCamera& camera)
+    {
+        const F32 near_clip = 0.5f;
+        const F32 far_clip = 256.f;
+        const F32 half_height = tanf(camera.getView() * 0.5f);
+        const F32 half_width = half_height * camera.getAspect();
+
+        LLVector3 origin(WORLD_WIDTH * 0.25f, WORLD_WIDTH * 0.5f, 30.f);
+        camera.setOrigin(origin);
+        camera.setNear(near_clip);
+        camera.setFar(far_clip);
+
+        const LLVector3 at = camera.getAtAxis();
+        const LLVector3 left = camera.getLeftAxis();
+        const LLVector3 up = camera.getUpAxis();
+
+        // Near then far corners: bottom left, bottom right, top right, top left.
+        LLVector3 frust[8];
+        const F32 dist[2] = { near_clip, far_clip };
+        for (S32 i = 0; i < 2; ++i)
+        {
+            LLVector3 center = origin + at * dist[i];
+            LLVector3 w = left * (half_width * dist[i]);
+            LLVector3 h = up * (half_height * dist[i]);
+            frust[i * 4 + 0] = center + w - h;
+            frust[i * 4 + 1] = center - w - h;
+            frust[i * 4 + 2] = center - w + h;
+            frust[i * 4 + 3] = center + w + h;
+        }
+        camera.calcAgentFrustumPlanes(frust);
+    }
+}
+
+namespace tut
+{
+    struct octreelinear_data
+    {
+        std::vector<LinearEntry*>   mEntries;
+        LinearRoot*                 mRoot;
+        LinearTree                  mLinear;
+        LLCamera                    mCamera;
+        LLVector4a                  mPad;
+        std::vector<LLVector4a>     mSegments;
+
+        octreelinear_data()
+        {
+            gOctreeMaxCapacity = 128;
+            gOctreeMinSize = 0.01f;
+
+            std::mt19937 rng(4321);
+            std::uniform_real_distribution<F32> pos(0.f, WORLD_WIDTH);
+            std::uniform_real_distribution<F32> height(0.f, 128.f);
+            std::uniform_real_distribution<F32> extent(0.05f, MAX_ENTRY_RADIUS / 2.f);
+
+            LLVector4a center(WORLD_WIDTH * 0.5f, WORLD_WIDTH * 0.5f, WORLD_WIDTH * 0.5f);
+            LLVector4a size;
+            size.splat(WORLD_WIDTH);
+            mRoot = new LinearRoot(center, size, NULL);
+
+            for (S32 i = 0; i < NUM_ENTRIES; ++i)
+            {
+                LinearEntry* entry = new LinearEntry;
+                entry->mCenter.set(pos(rng), pos(rng), height(rng));
+                entry->mHalfSize.set(extent(rng), extent(rng), extent(rng));
+                entry->mBinRadius = entry->mHalfSize.getLength3().getF32();
+                entry->mBinIndex = -1;
+                mRoot->insert(entry);
+                mEntries.push_back(entry);
+            }
+
+            // mouse picks: short segments from a camera height into the scene
+            for (S32 i = 0; i < NUM_SEGMENTS; ++i)
+            {
+                LLVector4a start(pos(rng), pos(rng), 40.f);
+                LLVector4a end(pos(rng), pos(rng), 0.f);
+                mSegments.push_back(start);
+                mSegments.push_back(end);
+            }
+
+            mLinear.build(mRoot);
+            mPad.splat(MAX_ENTRY_RADIUS);
+            setup_camera(mCamera);
+        }
+
+        ~octreelinear_data()
+        {
+            delete mRoot;
+            for (LinearEntry* entry : mEntries)
+            {
+                delete entry;
+            }
+        }
+    };
+    typedef test_group<octreelinear_data> octreelinear_group;
+    typedef octreelinear_group::object octreelinear_object;
+    tut::octreelinear_group octreelinear_testgroup("LLOctreeLinear");
+
+    template<> template<>
+    void octreelinear_object::test<1>()
+    {
+        set_test_name("packed layout");
+
+        ensure_equals("element count", mLinear.getElementCount(), mEntries.size());
+        ensure("root first", mLinear.getSourceNode(0) == mRoot);
+
+        // every node is packed once, after its parent
+        U32 nodes = 0;
+        mLinear.traverse([&](U32 index, const LLVector4a& center, const LLVector4a& size) -> S32
+            {
+                ensure("bounds copied", center.equals3(mLinear.getSourceNode(index)->getCenter()));
+                nodes++;
+                return LinearTree::NODE_PARTIAL;
+            },
+            [](const LinearEntry*) {});
+        ensure_equals("node count", nodes, mLinear.getNodeCount());
+
+        entry_list_t linked, linear;
+        add_all(mRoot, linked);
+        mLinear.traverse([](U32, const LLVector4a&, const LLVector4a&) -> S32 { return LinearTree::NODE_INSIDE; },
+            [&](const LinearEntry* entry) { linear.push_back(entry); });
+        ensure("same elements in the same order", linked == linear);
+    }
+
+    template<> template<>
+    void octreelinear_object::test<2>()
+    {
+        set_test_name("cull matches linked tree");
+
+        entry_list_t linked, linear;
+        cull_linked(mCamera, mPad, mRoot, linked);
+        mLinear.cull(mCamera, mPad, [&](const LinearEntry* entry) { linear.push_back(entry); });
+
+        ensure("something visible", !linked.empty());
+        ensure("something culled", linked.size() < mEntries.size());
+        ensure("same visible list", linked == linear);
+    }
+
+    template<> template<>
+    void octreelinear_object::test<3>()
+    {
+        set_test_name("segment intersect matches linked tree");
+
+        size_t hits = 0;
+        for (S32 i = 0; i < NUM_SEGMENTS; ++i)
+        {
+            entry_list_t linked, linear;
+            intersect_linked(mSegments[i * 2], mSegments[i * 2 + 1], mPad, mRoot, linked);
+            intersect_linear(mSegments[i * 2], mSegments[i * 2 + 1], mPad, mLinear, linear);
+            ensure("same hits", linked == linear);
+            hits += linked.size();
+        }
+        ensure("segments hit something", hits > 0);
+    }
+
+    template<> template<>
+    void octreelinear_object::test<4>()
+    {
+        set_test_name("bounds patch");
+
+        // push every node far away, nothing should be visible
+        for (U32 i = 0; i < mLinear.getNodeCount(); ++i)
+        {
+            LLVector4a center(-10000.f, -10000.f, -10000.f);
+            mLinear.setNodeBounds(i, center, mLinear.getSize(i));
+        }
+        mLinear.setNodeBounds(LinearTree::INVALID_NODE, mLinear.getCenter(0), mLinear.getSize(0));
+
+        size_t visible = 0;
+        mLinear.cull(mCamera, mPad, [&](const LinearEntry*) { visible++; });
+        ensure_equals("all culled", visible, (size_t)0);
+
+        mLinear.build(mRoot);
+        mLinear.cull(mCamera, mPad, [&](const LinearEntry*) { visible++; });
+        ensure("visible after rebuild", visible > 0);
+    }
+}
@@ -0,0 +1,231 @@
+/**
+ * @file   llrigginginfo_test.cpp
+ * @brief  Skinned face extents from per joint vertex bounds against the
+ *         extents of the fully skinned vertices.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include <random>
+#include <vector>
+
+#include "../llmath.h"
+#include "../llrigginginfo.h"
+#include "../llvertextransform.h"
+#include "../m4math.h"
+#include "../v4math.h"
+#include "../test/lltut.h"
+
+namespace
+{
+    // One rigged attachment: a body mesh over most of the skeleton
+    const S32 NUM_JOINTS = 48;
+    const U32 NUM_FACE_VERTICES = 30000;
+    const F32 JOINT_RADIUS = 0.15f;
+
+    // Animation frames checked against the bounds
+    const S32 NUM_FRAMES = 10;
+
+    // Skinning sums the matrices in a different order than the bounds are
+    // transformed in.
+    const F32 TOLERANCE = 0.0001f;
+
+    // Palette for one frame of animation: every joint rotated and moved a
+    // little from its bind pose.
+    void animate(std::mt19937& rng, std::vector<LLMatrix4a>& palette)
+    {
+        std::uniform_real_distribution<F32> angle(-0.5f, 0.5f);
+        std::uniform_real_distribution<F32> offset(-0.1f, 0.1f);
+
+        palette.resize(NUM_JOINTS);
+        for (LLMatrix4a& m : palette)
+        {
+            LLMatrix4 mat;
+            mat.initRotTrans(angle(rng), angle(rng), angle(rng), LLVector4(offset(rng), offset(rng), offset(rng), 1.f));
+            m.loadu(mat);
+        }
+    }
+
+    bool contains(const LLVector4a* extents, const LLVector4a& p)
+    {
+        for (U32 axis = 0; axis < 3; ++axis)
+        {
+            if (p[axis] < extents[0][axis] - TOLERANCE || p[axis] > extents[1][axis] + TOLERANCE)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void skinned_extents(const std::vector<LLVector4a>& skinned, LLVector4a* extents)
+    {
+        extents[0] = extents[1] = skinned[0];
+        for (const LLVector4a& p : skinned)
+        {
+            update_min_max(extents[0], extents[1], p);
+        }
+    }
+}
+
+namespace tut
+{
+    struct rigginginfo_data
+    {
+        std::vector<LLVector4a> mPositions;
+        std::vector<LLVector4a> mWeights;
+        std::vector<LLMatrix4a> mPalette;
+        LLMatrix4a              mBindShape;
+        std::mt19937            mRNG;
+
+        // Vertices sit around the joint that mostly drives them, blended
+        // with up to three neighbouring joints, as on a real body mesh.
+        rigginginfo_data()
+            : mRNG(2468)
+        {
+            std::uniform_real_distribution<F32> pos(-1.f, 1.f);
+            std::uniform_real_distribution<F32> around(-JOINT_RADIUS, JOINT_RADIUS);
+            std::uniform_real_distribution<F32> frac(0.01f, 0.99f);
+            std::uniform_int_distribution<S32> joint(0, NUM_JOINTS - 1);
+            std::uniform_int_distribution<S32> neighbour(-2, 2);
+            std::uniform_int_distribution<S32> influences(1, 4);
+
+            std::vector<LLVector4a> centers(NUM_JOINTS);
+            for (LLVector4a& center : centers)
+            {
+                center.set(pos(mRNG) * 0.3f, pos(mRNG) * 0.3f, pos(mRNG), 1.f);
+            }
+
+            mPositions.resize(NUM_FACE_VERTICES);
+            mWeights.resize(NUM_FACE_VERTICES);
+            for (U32 i = 0; i < NUM_FACE_VERTICES; ++i)
+            {
+                const S32 main_joint = joint(mRNG);
+                const LLVector4a& center = centers[main_joint];
+                mPositions[i].set(center[0] + around(mRNG), center[1] + around(mRNG), center[2] + around(mRNG), 1.f);
+
+                // Unused influences are joint 0 with no weight
+                F32 w[4] = { main_joint + frac(mRNG), 0.f, 0.f, 0.f };
+                const S32 count = influences(mRNG);
+                for (S32 k = 1; k < count; ++k)
+                {
+                    w[k] = llclamp(main_joint + neighbour(mRNG), 0, NUM_JOINTS - 1) + frac(mRNG) * 0.5f;
+                }
+                mWeights[i].set(w[0], w[1], w[2], w[3]);
+            }
+
+            LLMatrix4 bind;
+            bind.initRotTrans(0.f, 0.f, F_PI_BY_TWO, LLVector4(0.f, 0.f, 0.5f, 1.f));
+            mBindShape.loadu(bind);
+        }
+
+        void skin(std::vector<LLVector4a>& skinned) const
+        {
+            skinned.resize(NUM_FACE_VERTICES);
+            LLVertexTransform::skinPositions(mPalette.data(), NUM_JOINTS, mBindShape,
+                                             mPositions.data(), mWeights.data(), NUM_FACE_VERTICES, skinned.data());
+        }
+    };
+    typedef test_group<rigginginfo_data> rigginginfo_group;
+    typedef rigginginfo_group::object rigginginfo_object;
+    tut::rigginginfo_group rigginginfo_testgroup("LLJointVertexBounds");
+
+    template<> template<>
+    void rigginginfo_object::test<1>()
+    {
+        set_test_name("skinned vertices are inside the joint bound extents");
+
+        LLJointVertexBounds bounds;
+        bounds.build(mPositions.data(), mWeights.data(), NUM_FACE_VERTICES);
+        ensure("built", bounds.isBuilt());
+        ensure_equals("one box per joint", bounds.size(), NUM_JOINTS);
+
+        std::vector<LLVector4a> skinned;
+        for (S32 frame = 0; frame < NUM_FRAMES; ++frame)
+        {
+            animate(mRNG, mPalette);
+            skin(skinned);
+
+            LLVector4a extents[2];
+            ensure("have extents", bounds.getSkinnedExtents(mPalette.data(), NUM_JOINTS, mBindShape, extents));
+            for (const LLVector4a& p : skinned)
+            {
+                ensure("vertex inside", contains(extents, p));
+            }
+        }
+    }
+
+    template<> template<>
+    void rigginginfo_object::test<2>()
+    {
+        set_test_name("out of range joint indices are clamped to the palette");
+
+        animate(mRNG, mPalette);
+
+        // Joint 200 skins with the last palette entry
+        LLVector4a weights;
+        weights.set(200.5f, 0.5f, 0.f, 0.f);
+        LLVector4a clamped_weights;
+        clamped_weights.set(NUM_JOINTS - 1 + 0.5f, 0.5f, 0.f, 0.f);
+
+        LLJointVertexBounds bounds;
+        bounds.build(mPositions.data(), &weights, 1);
+        LLJointVertexBounds clamped_bounds;
+        clamped_bounds.build(mPositions.data(), &clamped_weights, 1);
+
+        LLVector4a extents[2];
+        LLVector4a clamped_extents[2];
+        bounds.getSkinnedExtents(mPalette.data(), NUM_JOINTS, mBindShape, extents);
+        clamped_bounds.getSkinnedExtents(mPalette.data(), NUM_JOINTS, mBindShape, clamped_extents);
+        ensure("same min", extents[0].equals3(clamped_extents[0]));
+        ensure("same max", extents[1].equals3(clamped_extents[1]));
+
+        LLVector4a skinned;
+        LLVertexTransform::skinPositions(mPalette.data(), NUM_JOINTS, mBindShape, mPositions.data(), &weights, 1, &skinned);
+        ensure("vertex inside", contains(extents, skinned));
+    }
+
+    template<> template<>
+    void rigginginfo_object::test<3>()
+    {
+        set_test_name("empty and cleared bounds");
+
+        animate(mRNG, mPalette);
+
+        LLJointVertexBounds bounds;
+        ensure("not built", !bounds.isBuilt());
+
+        LLVector4a extents[2];
+        bounds.build(mPositions.data(), mWeights.data(), 0);
+        ensure("built", bounds.isBuilt());
+        ensure("no extents without vertices", !bounds.getSkinnedExtents(mPalette.data(), NUM_JOINTS, mBindShape, extents));
+
+        bounds.build(mPositions.data(), mWeights.data(), NUM_FACE_VERTICES);
+        ensure("no extents without a palette", !bounds.getSkinnedExtents(mPalette.data(), 0, mBindShape, extents));
+
+        bounds.clear();
+        ensure("cleared", !bounds.isBuilt());
+        ensure_equals("no boxes", bounds.size(), 0);
+    }
+}
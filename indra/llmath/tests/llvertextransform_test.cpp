@@ -0,0 +1,419 @@
+/**
+ * @file   llvertextransform_test.cpp
+ * @brief  Vertex transform and skinning kernels against the per vertex
+ *         LLFace and LLRiggedVolume code.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "../llmath.h"
+#include "../llvertextransform.h"
+#include "../v4math.h"
+#include "../test/lltut.h"
+
+namespace
+{
+    const U32 NUM_VERTICES = 50000;
+
+    const F32 COS_ANG = 0.8f;
+    const F32 SIN_ANG = 0.6f;
+    const F32 OFFSET_S = 0.25f;
+    const F32 OFFSET_T = -0.125f;
+    const F32 SCALE_S = 2.f;
+    const F32 SCALE_T = 0.5f;
+
+    // A rigged outfit: body, head, hands, clothing and hair
+    const U32 NUM_SKINNED_VERTICES = 300000;
+    const U32 NUM_PALETTE_JOINTS = 64;
+
+    // LL_MAX_JOINTS_PER_MESH_OBJECT, llcharacter is not a dependency
+    const U32 MAX_JOINTS_PER_MESH_OBJECT = 110;
+
+    // The loops LLFace::getGeometryVolume() used before the kernels.
+    void reference_positions(const LLMatrix4a& mat, const LLVector4a* src, U32 count, F32 w, LLVector4a* dst)
+    {
+        LLVector4Logical mask;
+        mask.clear();
+        mask.setElement<3>();
+
+        LLVector4a texIdx;
+        texIdx.set(0, 0, 0, w);
+
+        for (U32 i = 0; i < count; ++i)
+        {
+            LLVector4a res;
+            mat.affineTransform(src[i], res);
+            dst[i].setSelectWithMask(mask, texIdx, res);
+        }
+    }
+
+    void reference_tangents(const LLMatrix4a& mat, const LLVector4a* src, U32 count, LLVector4a* dst)
+    {
+        LLVector4Logical mask;
+        mask.clear();
+        mask.setElement<3>();
+
+        for (U32 i = 0; i < count; ++i)
+        {
+            LLVector4a res;
+            mat.rotate(src[i], res);
+            dst[i].setSelectWithMask(mask, src[i], res);
+        }
+    }
+
+    void reference_tex_coords(const LLVector2* src, U32 count, LLVector2* dst)
+    {
+        for (U32 i = 0; i < count; ++i)
+        {
+            F32 s = src[i].mV[0] - 0.5f;
+            F32 t = src[i].mV[1] - 0.5f;
+
+            F32 temp = s;
+            s = s * COS_ANG + t * SIN_ANG;
+            t = -temp * SIN_ANG + t * COS_ANG;
+
+            dst[i].mV[0] = s * SCALE_S + (OFFSET_S + 0.5f);
+            dst[i].mV[1] = t * SCALE_T + (OFFSET_T + 0.5f);
+        }
+    }
+
+    // Per vertex skinning as LLRiggedVolume::update() did it with
+    // FSSkinningUtil::getPerVertexSkinMatrixSSE().
+    void reference_skin(const LLMatrix4a* palette, U32 max_joints, const LLMatrix4a& bind_shape,
+                        const LLVector4a* positions, const LLVector4a* weights, U32 count, LLVector4a* dst)
+    {
+        for (U32 i = 0; i < count; ++i)
+        {
+            LL_ALIGN_16(S32 idx[4]);
+            LL_ALIGN_16(F32 wght[4]);
+
+            __m128i max_idx = _mm_set1_epi16((S16)(max_joints - 1));
+            __m128i index = _mm_cvttps_epi32(weights[i]);
+            __m128 weight = _mm_sub_ps(weights[i], _mm_cvtepi32_ps(index));
+            index = _mm_min_epi16(index, max_idx);
+            _mm_store_si128((__m128i*)idx, index);
+
+            __m128 scale = _mm_add_ps(weight, _mm_movehl_ps(weight, weight));
+            scale = _mm_add_ss(scale, _mm_shuffle_ps(scale, scale, 1));
+            scale = _mm_shuffle_ps(scale, scale, 0);
+            _mm_store_ps(wght, _mm_div_ps(weight, scale));
+
+            LLMatrix4a final_mat;
+            final_mat.clear();
+            for (U32 k = 0; k < 4; ++k)
+            {
+                LLMatrix4a src;
+                src.setMul(palette[idx[k]], wght[k]);
+                final_mat.add(src);
+            }
+
+            LLVector4a t;
+            bind_shape.affineTransform(positions[i], t);
+            final_mat.affineTransform(t, dst[i]);
+        }
+    }
+
+    template <class T>
+    bool same(const std::vector<T>& a, const std::vector<T>& b, U32 count)
+    {
+        return !memcmp(a.data(), b.data(), count * sizeof(T));
+    }
+}
+
+namespace tut
+{
+    struct vertextransform_data
+    {
+        std::vector<LLVector4a> mPositions;
+        std::vector<LLVector4a> mNormals;
+        std::vector<LLVector4a> mTangents;
+        std::vector<LLVector2>  mTexCoords;
+        LLMatrix4a              mMatVert;
+        LLMatrix4a              mMatNormal;
+        LLVertexTransform::EKernel mDefaultKernel;
+
+        vertextransform_data()
+            : mDefaultKernel(LLVertexTransform::getKernel())
+        {
+            std::mt19937 rng(2468);
+            std::uniform_real_distribution<F32> pos(-16.f, 16.f);
+            std::uniform_real_distribution<F32> dir(-1.f, 1.f);
+            std::uniform_real_distribution<F32> tc(-2.f, 2.f);
+
+            mPositions.resize(NUM_VERTICES);
+            mNormals.resize(NUM_VERTICES);
+            mTangents.resize(NUM_VERTICES);
+            mTexCoords.resize(NUM_VERTICES);
+            for (U32 i = 0; i < NUM_VERTICES; ++i)
+            {
+                mPositions[i].set(pos(rng), pos(rng), pos(rng), 1.f);
+                mNormals[i].set(dir(rng), dir(rng), dir(rng));
+                mTangents[i].set(dir(rng), dir(rng), dir(rng), (i & 1) ? 1.f : -1.f);
+                mTexCoords[i].set(tc(rng), tc(rng));
+            }
+
+            LLMatrix4 mat;
+            mat.initRotTrans(0.3f, -1.2f, 2.1f, LLVector4(100.f, -20.f, 35.f, 1.f));
+            mMatVert.loadu(mat);
+            mMatNormal = mMatVert;
+        }
+
+        ~vertextransform_data()
+        {
+            LLVertexTransform::setKernel(mDefaultKernel);
+        }
+
+        // Every count up to 17 covers all the 8 vertex remainders
+        void check_kernel(LLVertexTransform::EKernel kernel)
+        {
+            ensure_equals("kernel selected", LLVertexTransform::setKernel(kernel), kernel);
+
+            std::vector<LLVector4a> expected(NUM_VERTICES);
+            std::vector<LLVector4a> result(NUM_VERTICES);
+            std::vector<LLVector2> expected_tc(NUM_VERTICES);
+            std::vector<LLVector2> result_tc(NUM_VERTICES);
+
+            const F32 w = 3.f;
+            for (U32 count = 0; count <= NUM_VERTICES; count = (count < 17) ? count + 1 : NUM_VERTICES)
+            {
+                reference_positions(mMatVert, mPositions.data(), count, w, expected.data());
+                LLVertexTransform::transformPositions(mMatVert, mPositions.data(), count, w, result.data());
+                ensure("positions", same(expected, result, count));
+
+                for (U32 i = 0; i < count; ++i)
+                {
+                    mMatNormal.rotate(mNormals[i], expected[i]);
+                }
+                LLVertexTransform::rotateNormals(mMatNormal, mNormals.data(), count, result.data());
+                ensure("normals", same(expected, result, count));
+
+                reference_tangents(mMatNormal, mTangents.data(), count, expected.data());
+                LLVertexTransform::rotateTangents(mMatNormal, mTangents.data(), count, result.data());
+                ensure("tangents", same(expected, result, count));
+
+                reference_tex_coords(mTexCoords.data(), count, expected_tc.data());
+                LLVertexTransform::transformTexCoords(mTexCoords.data(), count, COS_ANG, SIN_ANG,
+                                                      OFFSET_S, OFFSET_T, SCALE_S, SCALE_T, result_tc.data());
+                for (U32 i = 0; i < count; ++i)
+                {
+                    // Allow for the compiler contracting the scalar code into FMAs
+                    ensure_approximately_equals("s", result_tc[i].mV[0], expected_tc[i].mV[0], 20);
+                    ensure_approximately_equals("t", result_tc[i].mV[1], expected_tc[i].mV[1], 20);
+                }
+
+                if (count == NUM_VERTICES)
+                {
+                    break;
+                }
+            }
+        }
+    };
+    typedef test_group<vertextransform_data> vertextransform_group;
+    typedef vertextransform_group::object vertextransform_object;
+    tut::vertextransform_group vertextransform_testgroup("LLVertexTransform");
+
+    template<> template<>
+    void vertextransform_object::test<1>()
+    {
+        set_test_name("SSE kernels match per vertex code");
+
+        check_kernel(LLVertexTransform::KERNEL_SSE);
+    }
+
+    template<> template<>
+    void vertextransform_object::test<2>()
+    {
+        set_test_name("AVX2 kernels match per vertex code");
+
+        if (!LLVertexTransform::hasAVX2())
+        {
+            skip("CPU has no AVX2");
+        }
+        check_kernel(LLVertexTransform::KERNEL_AVX2);
+    }
+
+    template<> template<>
+    void vertextransform_object::test<3>()
+    {
+        set_test_name("AVX2 and SSE kernels give identical output");
+
+        if (!LLVertexTransform::hasAVX2())
+        {
+            skip("CPU has no AVX2");
+        }
+
+        std::vector<LLVector4a> sse(NUM_VERTICES);
+        std::vector<LLVector4a> avx2(NUM_VERTICES);
+        std::vector<LLVector2> sse_tc(NUM_VERTICES);
+        std::vector<LLVector2> avx2_tc(NUM_VERTICES);
+
+        LLVertexTransform::EKernel kernels[] = { LLVertexTransform::KERNEL_SSE, LLVertexTransform::KERNEL_AVX2 };
+        std::vector<LLVector4a>* outputs[] = { &sse, &avx2 };
+        std::vector<LLVector2>* tc_outputs[] = { &sse_tc, &avx2_tc };
+
+        for (S32 attrib = 0; attrib < 3; ++attrib)
+        {
+            for (S32 k = 0; k < 2; ++k)
+            {
+                LLVertexTransform::setKernel(kernels[k]);
+                LLVector4a* out = outputs[k]->data();
+                switch (attrib)
+                {
+                case 0:
+                    LLVertexTransform::transformPositions(mMatVert, mPositions.data(), NUM_VERTICES, 0.f, out);
+                    break;
+                case 1:
+                    LLVertexTransform::rotateNormals(mMatNormal, mNormals.data(), NUM_VERTICES, out);
+                    break;
+                default:
+                    LLVertexTransform::rotateTangents(mMatNormal, mTangents.data(), NUM_VERTICES, out);
+                    break;
+                }
+            }
+            ensure("identical vectors", same(sse, avx2, NUM_VERTICES));
+        }
+
+        for (S32 k = 0; k < 2; ++k)
+        {
+            LLVertexTransform::setKernel(kernels[k]);
+            LLVertexTransform::transformTexCoords(mTexCoords.data(), NUM_VERTICES, COS_ANG, SIN_ANG,
+                                                  OFFSET_S, OFFSET_T, SCALE_S, SCALE_T, tc_outputs[k]->data());
+        }
+        ensure("identical texture coordinates", same(sse_tc, avx2_tc, NUM_VERTICES));
+    }
+
+    struct vertexskinning_data
+    {
+        std::vector<LLVector4a> mPositions;
+        std::vector<LLVector4a> mWeights;
+        std::vector<LLMatrix4a> mPalette;
+        LLMatrix4a              mBindShape;
+        LLVertexTransform::EKernel mDefaultKernel;
+
+        vertexskinning_data()
+            : mDefaultKernel(LLVertexTransform::getKernel())
+        {
+            std::mt19937 rng(1357);
+            std::uniform_real_distribution<F32> pos(-1.f, 1.f);
+            std::uniform_real_distribution<F32> angle(0.f, F_TWO_PI);
+            std::uniform_real_distribution<F32> frac(0.01f, 0.99f);
+            std::uniform_int_distribution<S32> joint(0, NUM_PALETTE_JOINTS - 1);
+
+            mPalette.resize(NUM_PALETTE_JOINTS);
+            for (LLMatrix4a& m : mPalette)
+            {
+                LLMatrix4 mat;
+                mat.initRotTrans(angle(rng), angle(rng), angle(rng), LLVector4(pos(rng), pos(rng), pos(rng), 1.f));
+                m.loadu(mat);
+            }
+
+            LLMatrix4 bind;
+            bind.initRotTrans(0.f, 0.f, F_PI_BY_TWO, LLVector4(0.f, 0.f, 0.5f, 1.f));
+            mBindShape.loadu(bind);
+
+            mPositions.resize(NUM_SKINNED_VERTICES);
+            mWeights.resize(NUM_SKINNED_VERTICES);
+            for (U32 i = 0; i < NUM_SKINNED_VERTICES; ++i)
+            {
+                mPositions[i].set(pos(rng), pos(rng), pos(rng), 1.f);
+                mWeights[i].set(joint(rng) + frac(rng), joint(rng) + frac(rng), joint(rng) + frac(rng), joint(rng) + frac(rng));
+            }
+        }
+
+        ~vertexskinning_data()
+        {
+            LLVertexTransform::setKernel(mDefaultKernel);
+        }
+
+        void check_kernel(LLVertexTransform::EKernel kernel)
+        {
+            ensure_equals("kernel selected", LLVertexTransform::setKernel(kernel), kernel);
+
+            std::vector<LLVector4a> expected(NUM_SKINNED_VERTICES);
+            std::vector<LLVector4a> result(NUM_SKINNED_VERTICES);
+            for (U32 count = 0; count <= NUM_SKINNED_VERTICES; count = (count < 9) ? count + 1 : NUM_SKINNED_VERTICES)
+            {
+                reference_skin(mPalette.data(), MAX_JOINTS_PER_MESH_OBJECT, mBindShape,
+                               mPositions.data(), mWeights.data(), count, expected.data());
+                LLVertexTransform::skinPositions(mPalette.data(), NUM_PALETTE_JOINTS, mBindShape,
+                                                 mPositions.data(), mWeights.data(), count, result.data());
+                ensure("skinned positions", same(expected, result, count));
+
+                if (count == NUM_SKINNED_VERTICES)
+                {
+                    break;
+                }
+            }
+        }
+    };
+    typedef test_group<vertexskinning_data> vertexskinning_group;
+    typedef vertexskinning_group::object vertexskinning_object;
+    tut::vertexskinning_group vertexskinning_testgroup("LLVertexTransform skinning");
+
+    template<> template<>
+    void vertexskinning_object::test<1>()
+    {
+        set_test_name("SSE skinning matches per vertex skinning");
+
+        check_kernel(LLVertexTransform::KERNEL_SSE);
+    }
+
+    template<> template<>
+    void vertexskinning_object::test<2>()
+    {
+        set_test_name("AVX2 skinning matches per vertex skinning");
+
+        if (!LLVertexTransform::hasAVX2())
+        {
+            skip("CPU has no AVX2");
+        }
+        check_kernel(LLVertexTransform::KERNEL_AVX2);
+    }
+
+    template<> template<>
+    void vertexskinning_object::test<3>()
+    {
+        set_test_name("out of range joint indices are clamped to the palette");
+
+        // Index 200 is past both the palette and MAX_JOINTS_PER_MESH_OBJECT
+        LLVector4a weights;
+        weights.set(200.5f, 0.5f, 0.f, 0.f);
+
+        LLVector4a expected;
+        LLVector4a clamped_weights;
+        clamped_weights.set(NUM_PALETTE_JOINTS - 1 + 0.5f, 0.5f, 0.f, 0.f);
+        LLVertexTransform::setKernel(LLVertexTransform::KERNEL_SSE);
+        LLVertexTransform::skinPositions(mPalette.data(), NUM_PALETTE_JOINTS, mBindShape,
+                                         mPositions.data(), &clamped_weights, 1, &expected);
+
+        LLVector4a result;
+        LLVertexTransform::skinPositions(mPalette.data(), NUM_PALETTE_JOINTS, mBindShape,
+                                         mPositions.data(), &weights, 1, &result);
+        ensure("clamped", !memcmp(&expected, &result, sizeof(LLVector4a)));
+    }
+}
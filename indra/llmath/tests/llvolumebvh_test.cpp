@@ -0,0 +1,319 @@
+/**
+ * @file   llvolumebvh_test.cpp
+ * @brief  Line segment tests of LLVolumeBVH against testing every triangle
+ *         and against the face octree.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include <random>
+#include <vector>
+
+#include "../llmath.h"
+#include "../llvolume.h"
+#include "../llvolumebvh.h"
+#include "../llvolumeoctree.h"
+#include "../test/lltut.h"
+
+namespace
+{
+    // A mesh heavy scene: detailed sculpted meshes, each a bumpy sphere
+    // in the unit cube like a decoded mesh asset face
+    const S32 NUM_FACES = 24;
+    const U32 SPHERE_RINGS = 96;
+    const U32 SPHERE_SEGMENTS = 128;
+    const S32 NUM_SEGMENTS = 400;
+
+    // Triangle hits are found in a different order, two triangles sharing
+    // an edge can both claim a hit at the same distance.
+    const F32 TOLERANCE = 0.0001f;
+
+    void make_sphere(std::mt19937& rng, LLVolumeFace& face)
+    {
+        std::uniform_real_distribution<F32> bump(0.85f, 1.f);
+        std::uniform_real_distribution<F32> phase(0.f, F_TWO_PI);
+        const F32 p0 = phase(rng);
+        const F32 p1 = phase(rng);
+
+        const U32 row = SPHERE_SEGMENTS + 1;
+        const U32 num_vertices = (SPHERE_RINGS + 1) * row;
+        face.resizeVertices(num_vertices);
+        for (U32 r = 0; r <= SPHERE_RINGS; ++r)
+        {
+            const F32 theta = F_PI * r / SPHERE_RINGS;
+            for (U32 s = 0; s <= SPHERE_SEGMENTS; ++s)
+            {
+                const F32 phi = F_TWO_PI * s / SPHERE_SEGMENTS;
+                const F32 radius = 0.5f * (0.9f + 0.1f * sinf(theta * 7.f + p0) * cosf(phi * 5.f + p1)) * bump(rng);
+                const U32 v = r * row + s;
+                face.mPositions[v].set(radius * sinf(theta) * cosf(phi), radius * sinf(theta) * sinf(phi), radius * cosf(theta), 1.f);
+                face.mNormals[v] = face.mPositions[v];
+                face.mNormals[v].normalize3fast();
+                face.mTexCoords[v].set((F32)s / SPHERE_SEGMENTS, (F32)r / SPHERE_RINGS);
+            }
+        }
+
+        face.resizeIndices(SPHERE_RINGS * SPHERE_SEGMENTS * 6);
+        U16* idx = face.mIndices;
+        for (U32 r = 0; r < SPHERE_RINGS; ++r)
+        {
+            for (U32 s = 0; s < SPHERE_SEGMENTS; ++s)
+            {
+                const U16 v = (U16)(r * row + s);
+                *idx++ = v;
+                *idx++ = (U16)(v + row);
+                *idx++ = (U16)(v + 1);
+                *idx++ = (U16)(v + 1);
+                *idx++ = (U16)(v + row);
+                *idx++ = (U16)(v + row + 1);
+            }
+        }
+    }
+
+    // Segments from outside the unit cube aimed near its center, a few
+    // of them missing
+    void make_segments(std::mt19937& rng, std::vector<LLVector4a>& starts, std::vector<LLVector4a>& dirs)
+    {
+        std::uniform_real_distribution<F32> dir(-1.f, 1.f);
+        std::uniform_real_distribution<F32> aim(-0.6f, 0.6f);
+
+        starts.resize(NUM_SEGMENTS);
+        dirs.resize(NUM_SEGMENTS);
+        for (S32 i = 0; i < NUM_SEGMENTS; ++i)
+        {
+            LLVector4a from(dir(rng), dir(rng), dir(rng));
+            from.normalize3fast();
+            from.mul(2.f);
+            LLVector4a to(aim(rng), aim(rng), aim(rng));
+            starts[i] = from;
+            dirs[i].setSub(to, from);
+            dirs[i].mul(2.f);
+        }
+    }
+
+    struct Hit
+    {
+        bool        mHit = false;
+        F32         mT = 2.f;
+        LLVector4a  mPoint;
+    };
+
+    // What LLVolume::lineSegmentIntersect() does for unique volumes
+    Hit brute_force(const LLVolumeFace& face, const LLVector4a& start, const LLVector4a& dir)
+    {
+        Hit hit;
+        for (S32 j = 0; j < face.mNumIndices; j += 3)
+        {
+            const U16* idx = face.mIndices + j;
+            F32 a, b, t;
+            if (LLTriangleRayIntersect(face.mPositions[idx[0]], face.mPositions[idx[1]], face.mPositions[idx[2]], start, dir, a, b, t) &&
+                t >= 0.f && t <= 1.f && t < hit.mT)
+            {
+                hit.mHit = true;
+                hit.mT = t;
+            }
+        }
+        return hit;
+    }
+
+    Hit octree(LLVolumeFace& face, const LLVector4a& start, const LLVector4a& dir)
+    {
+        Hit hit;
+        LLOctreeTriangleRayIntersect intersect(start, dir, &face, &hit.mT, &hit.mPoint, NULL, NULL, NULL);
+        intersect.traverse(face.getOctree());
+        hit.mHit = intersect.mHitFace;
+        return hit;
+    }
+
+    Hit bvh(const LLVolumeFace& face, const LLVector4a& start, const LLVector4a& dir)
+    {
+        Hit hit;
+        U32 tri;
+        F32 a, b;
+        hit.mHit = face.getBVH()->intersect(face.mPositions, face.mIndices, start, dir, hit.mT, tri, a, b);
+        if (hit.mHit)
+        {
+            // the hit really is on the triangle reported
+            const U16* idx = face.mIndices + tri * 3;
+            F32 ta, tb, t;
+            LLTriangleRayIntersect(face.mPositions[idx[0]], face.mPositions[idx[1]], face.mPositions[idx[2]], start, dir, ta, tb, t);
+            tut::ensure_approximately_equals("triangle distance", t, hit.mT, 16);
+        }
+        return hit;
+    }
+
+    bool same_hit(const Hit& expected, const Hit& result)
+    {
+        return expected.mHit == result.mHit && (!expected.mHit || fabsf(expected.mT - result.mT) < TOLERANCE);
+    }
+}
+
+namespace tut
+{
+    struct volumebvh_data
+    {
+        std::vector<LLVolumeFace>   mFaces;
+        std::vector<LLVector4a>     mStarts;
+        std::vector<LLVector4a>     mDirs;
+
+        volumebvh_data()
+        {
+            std::mt19937 rng(97531);
+            mFaces.resize(NUM_FACES);
+            for (LLVolumeFace& face : mFaces)
+            {
+                make_sphere(rng, face);
+            }
+            make_segments(rng, mStarts, mDirs);
+        }
+    };
+    typedef test_group<volumebvh_data> volumebvh_group;
+    typedef volumebvh_group::object volumebvh_object;
+    tut::volumebvh_group volumebvh_testgroup("LLVolumeBVH");
+
+    template<> template<>
+    void volumebvh_object::test<1>()
+    {
+        set_test_name("BVH hits match testing every triangle and the octree");
+
+        S32 hits = 0;
+        for (S32 f = 0; f < 4; ++f)
+        {
+            LLVolumeFace& face = mFaces[f];
+            face.createOctree();
+            face.createBVH();
+            ensure("built", face.getBVH() != NULL);
+            ensure_equals("all triangles", face.getBVH()->getNumTriangles(), (U32)face.mNumIndices / 3);
+
+            for (S32 i = 0; i < NUM_SEGMENTS; ++i)
+            {
+                const Hit expected = brute_force(face, mStarts[i], mDirs[i]);
+                ensure("same as every triangle", same_hit(expected, bvh(face, mStarts[i], mDirs[i])));
+                ensure("same as octree", same_hit(octree(face, mStarts[i], mDirs[i]), bvh(face, mStarts[i], mDirs[i])));
+                hits += expected.mHit ? 1 : 0;
+            }
+        }
+        ensure("some hits", hits > 0);
+        ensure("some misses", hits < 4 * NUM_SEGMENTS);
+    }
+
+    template<> template<>
+    void volumebvh_object::test<2>()
+    {
+        set_test_name("closest_t limits the hits");
+
+        LLVolumeFace& face = mFaces[0];
+        face.createBVH();
+        for (S32 i = 0; i < NUM_SEGMENTS; ++i)
+        {
+            const Hit expected = brute_force(face, mStarts[i], mDirs[i]);
+            if (expected.mHit)
+            {
+                // something closer was already hit
+                F32 closest_t = expected.mT * 0.5f;
+                U32 tri;
+                F32 a, b;
+                ensure("nothing closer", !face.getBVH()->intersect(face.mPositions, face.mIndices, mStarts[i], mDirs[i], closest_t, tri, a, b));
+                ensure_equals("closest_t kept", closest_t, expected.mT * 0.5f);
+            }
+        }
+    }
+
+    template<> template<>
+    void volumebvh_object::test<3>()
+    {
+        set_test_name("degenerate faces");
+
+        // all triangles in one plane, on a grid, and many on one spot
+        LLVolumeFace flat;
+        const U32 grid = 64;
+        flat.resizeVertices((grid + 1) * (grid + 1));
+        for (U32 y = 0; y <= grid; ++y)
+        {
+            for (U32 x = 0; x <= grid; ++x)
+            {
+                flat.mPositions[y * (grid + 1) + x].set((F32)x / grid - 0.5f, (F32)y / grid - 0.5f, 0.f, 1.f);
+            }
+        }
+        flat.resizeIndices(grid * grid * 6 + 300);
+        U16* idx = flat.mIndices;
+        for (U32 y = 0; y < grid; ++y)
+        {
+            for (U32 x = 0; x < grid; ++x)
+            {
+                const U16 v = (U16)(y * (grid + 1) + x);
+                *idx++ = v;
+                *idx++ = (U16)(v + 1);
+                *idx++ = (U16)(v + grid + 1);
+                *idx++ = (U16)(v + 1);
+                *idx++ = (U16)(v + grid + 2);
+                *idx++ = (U16)(v + grid + 1);
+            }
+        }
+        for (U32 i = 0; i < 300; ++i)
+        {
+            *idx++ = 0;
+        }
+
+        flat.createBVH();
+        for (S32 i = 0; i < NUM_SEGMENTS; ++i)
+        {
+            ensure("flat face", same_hit(brute_force(flat, mStarts[i], mDirs[i]), bvh(flat, mStarts[i], mDirs[i])));
+        }
+
+        // axis aligned segment straight down onto the plane
+        LLVector4a start(0.1f, 0.2f, 1.f);
+        LLVector4a dir(0.f, 0.f, -2.f);
+        const Hit hit = bvh(flat, start, dir);
+        ensure("axis aligned hit", hit.mHit);
+        ensure_approximately_equals("axis aligned distance", hit.mT, 0.5f, 16);
+
+        LLVolumeFace empty;
+        empty.createBVH();
+        ensure("no tree for no triangles", empty.getBVH() == NULL);
+    }
+
+    template<> template<>
+    void volumebvh_object::test<4>()
+    {
+        set_test_name("worker build matches a direct build");
+
+        LLVolumeFace& face = mFaces[1];
+        LLVolumeBVHBuild build(face.mPositions, face.mNumVertices, face.mIndices, face.mNumIndices);
+        ensure("not done", !build.isDone());
+        ensure("no result yet", build.getResult() == NULL);
+        build.run();
+        ensure("done", build.isDone());
+
+        face.createBVH();
+        std::shared_ptr<LLVolumeBVH> result = build.getResult();
+        ensure_equals("same nodes", result->getNumNodes(), face.getBVH()->getNumNodes());
+
+        // No General work queue in the tests, so a background build happens
+        // right away
+        face.destroyBVH();
+        face.createBVH(true);
+        ensure("built without a queue", face.getBVH() != NULL);
+    }
+}
@@ -0,0 +1,301 @@
+/**
+ * @file   llvolumecache_test.cpp
+ * @brief  Sculpt faces read from the volume cache against generated ones.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include <filesystem>
+#include <vector>
+
+#include "../llmath.h"
+#include "../llvolume.h"
+#include "../llvolumecache.h"
+#include "fsyspath.h"
+#include "llfile.h"
+#include "../test/lltut.h"
+
+namespace
+{
+    // Detail of the highest LOD
+    const F32 HIGH_DETAIL = 4.f;
+    const U64 CACHE_BYTES = 64 * 1024 * 1024;
+
+    // A sculpt texture as decoded at discard 0
+    const U16 SCULPT_SIZE = 128;
+
+    LLVolumeParams torus_params(F32 hollow, F32 twist)
+    {
+        LLVolumeParams params;
+        params.setType(LL_PCODE_PROFILE_CIRCLE, LL_PCODE_PATH_CIRCLE);
+        params.setRatio(1.f, 0.25f);
+        params.setHollow(hollow);
+        params.setTwistEnd(twist);
+        return params;
+    }
+
+    LLVolumeParams sculpt_params(const LLUUID& sculpt_id)
+    {
+        LLVolumeParams params;
+        params.setType(LL_PCODE_PROFILE_CIRCLE, LL_PCODE_PATH_CIRCLE);
+        params.setSculptID(sculpt_id, LL_SCULPT_TYPE_SPHERE);
+        return params;
+    }
+
+    // Bumpy sphere, RGB mapped to xyz
+    std::vector<U8> sculpt_data()
+    {
+        std::vector<U8> data(SCULPT_SIZE * SCULPT_SIZE * 3);
+        for (S32 t = 0; t < SCULPT_SIZE; ++t)
+        {
+            for (S32 s = 0; s < SCULPT_SIZE; ++s)
+            {
+                const F32 theta = F_TWO_PI * s / (SCULPT_SIZE - 1);
+                const F32 phi = F_PI * t / (SCULPT_SIZE - 1);
+                const F32 r = 0.4f + 0.05f * sinf(theta * 7.f) * sinf(phi * 5.f);
+                U8* texel = &data[(t * SCULPT_SIZE + s) * 3];
+                texel[0] = (U8)llclamp(ll_round((0.5f + r * sinf(phi) * cosf(theta)) * 255.f), 0, 255);
+                texel[1] = (U8)llclamp(ll_round((0.5f + r * sinf(phi) * sinf(theta)) * 255.f), 0, 255);
+                texel[2] = (U8)llclamp(ll_round((0.5f + r * cosf(phi)) * 255.f), 0, 255);
+            }
+        }
+        return data;
+    }
+
+    bool same_faces(LLVolume* a, LLVolume* b)
+    {
+        if (a->getNumVolumeFaces() != b->getNumVolumeFaces() || a->getSurfaceArea() != b->getSurfaceArea())
+        {
+            return false;
+        }
+
+        if (a->getMesh().size() != b->getMesh().size() ||
+            memcmp(a->getMesh().mArray, b->getMesh().mArray, sizeof(LLVector4a) * a->getMesh().size()))
+        {
+            return false;
+        }
+
+        for (S32 i = 0; i < a->getNumVolumeFaces(); ++i)
+        {
+            const LLVolumeFace& fa = a->getVolumeFace(i);
+            const LLVolumeFace& fb = b->getVolumeFace(i);
+            if (fa.mID != fb.mID || fa.mTypeMask != fb.mTypeMask ||
+                fa.mBeginS != fb.mBeginS || fa.mBeginT != fb.mBeginT ||
+                fa.mNumS != fb.mNumS || fa.mNumT != fb.mNumT ||
+                fa.mNumVertices != fb.mNumVertices || fa.mNumIndices != fb.mNumIndices ||
+                !fa.mExtents[0].equals3(fb.mExtents[0]) || !fa.mExtents[1].equals3(fb.mExtents[1]) ||
+                !fa.mCenter->equals3(*fb.mCenter) ||
+                fa.mTexCoordExtents[0] != fb.mTexCoordExtents[0] || fa.mTexCoordExtents[1] != fb.mTexCoordExtents[1])
+            {
+                return false;
+            }
+
+            if (memcmp(fa.mPositions, fb.mPositions, sizeof(LLVector4a) * fa.mNumVertices) ||
+                memcmp(fa.mNormals, fb.mNormals, sizeof(LLVector4a) * fa.mNumVertices) ||
+                memcmp(fa.mTexCoords, fb.mTexCoords, sizeof(LLVector2) * fa.mNumVertices) ||
+                memcmp(fa.mIndices, fb.mIndices, sizeof(U16) * fa.mNumIndices))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::vector<fsyspath> entries(const std::string& dir)
+    {
+        std::vector<fsyspath> paths;
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(fsyspath(dir), ec))
+        {
+            paths.push_back(entry.path());
+        }
+        return paths;
+    }
+}
+
+namespace tut
+{
+    struct volumecache_data
+    {
+        std::string mDir;
+        std::vector<U8> mSculptData;
+
+        volumecache_data()
+        :   mSculptData(sculpt_data())
+        {
+            mDir = std::string(LLFile::tmpdir()) + "llvolumecache_test";
+            std::error_code ec;
+            std::filesystem::remove_all(fsyspath(mDir), ec);
+            LLVolumeCache::initClass(mDir, CACHE_BYTES, false);
+        }
+
+        ~volumecache_data()
+        {
+            LLVolumeCache::cleanupClass();
+            std::error_code ec;
+            std::filesystem::remove_all(fsyspath(mDir), ec);
+        }
+
+        LLPointer<LLVolume> sculpt(const LLVolumeParams& params, F32 detail = HIGH_DETAIL, S32 discard = 0) const
+        {
+            LLPointer<LLVolume> volume = new LLVolume(params, detail);
+            const U16 size = SCULPT_SIZE >> discard;
+            volume->sculpt(size, size, 3, mSculptData.data(), discard, false);
+            return volume;
+        }
+    };
+    typedef test_group<volumecache_data> volumecache_group;
+    typedef volumecache_group::object volumecache_object;
+    tut::volumecache_group volumecache_testgroup("LLVolumeCache");
+
+    template<> template<>
+    void volumecache_object::test<1>()
+    {
+        set_test_name("cached sculpt faces match generated ones");
+
+        ensure("enabled", LLVolumeCache::isEnabled());
+
+        const LLVolumeParams params = sculpt_params(LLUUID::generateNewID());
+
+        LLPointer<LLVolume> stored = sculpt(params);
+        ensure("cacheable", LLVolumeCache::isCacheable(stored));
+        ensure_equals("miss", LLVolumeCache::getMisses(), 1);
+        ensure_equals("one entry", entries(mDir).size(), 1);
+
+        LLPointer<LLVolume> loaded = sculpt(params);
+        ensure_equals("hit", LLVolumeCache::getHits(), 1);
+        ensure_equals("sculpt level", loaded->getSculptLevel(), 0);
+        ensure("same faces", same_faces(stored, loaded));
+
+        // LLVOVolume::setVolume() recomputes the area from the mesh points
+        stored->calcSurfaceArea();
+        loaded->calcSurfaceArea();
+        ensure("surface area", stored->getSurfaceArea() > 0.f);
+        ensure_equals("same surface area", loaded->getSurfaceArea(), stored->getSurfaceArea());
+
+        // Sculpting again replaces the faces
+        loaded->sculpt(SCULPT_SIZE, SCULPT_SIZE, 3, mSculptData.data(), 0, false);
+        ensure_equals("second hit", LLVolumeCache::getHits(), 2);
+        ensure("same faces again", same_faces(stored, loaded));
+    }
+
+    template<> template<>
+    void volumecache_object::test<2>()
+    {
+        set_test_name("entries per sculpt texture and discard level");
+
+        const LLVolumeParams params = sculpt_params(LLUUID::generateNewID());
+        LLPointer<LLVolume> stored = sculpt(params);
+
+        // The same texture at a lower discard
+        LLPointer<LLVolume> lower = sculpt(params, HIGH_DETAIL, 1);
+        ensure_equals("miss for the discard", LLVolumeCache::getMisses(), 2);
+
+        // Another texture with the same data
+        LLPointer<LLVolume> other = sculpt(sculpt_params(LLUUID::generateNewID()));
+        ensure_equals("miss for the texture", LLVolumeCache::getMisses(), 3);
+        ensure_equals("no hits", LLVolumeCache::getHits(), 0);
+        ensure_equals("three entries", entries(mDir).size(), 3);
+    }
+
+    template<> template<>
+    void volumecache_object::test<3>()
+    {
+        set_test_name("volumes left out of the cache");
+
+        // Reading these back costs as much as generating them
+        LLPointer<LLVolume> prim = new LLVolume(torus_params(0.5f, 0.5f), HIGH_DETAIL);
+        ensure("prim", !LLVolumeCache::isCacheable(prim));
+        LLPointer<LLVolume> low = sculpt(sculpt_params(LLUUID::generateNewID()), 2.5f);
+        ensure("lower LOD", !LLVolumeCache::isCacheable(low));
+
+        LLPointer<LLVolume> unique = new LLVolume(sculpt_params(LLUUID::generateNewID()), HIGH_DETAIL, false, true);
+        unique->sculpt(SCULPT_SIZE, SCULPT_SIZE, 3, mSculptData.data(), 0, false);
+        ensure("unique", !LLVolumeCache::isCacheable(unique));
+
+        // Missing sculpt data makes a placeholder
+        LLPointer<LLVolume> missing = new LLVolume(sculpt_params(LLUUID::generateNewID()), HIGH_DETAIL);
+        missing->sculpt(0, 0, 0, NULL, 0, true);
+
+        ensure_equals("no lookups", LLVolumeCache::getHits() + LLVolumeCache::getMisses(), 0);
+        ensure("no entries", entries(mDir).empty());
+    }
+
+    template<> template<>
+    void volumecache_object::test<4>()
+    {
+        set_test_name("damaged entries are removed and regenerated");
+
+        const LLVolumeParams params = sculpt_params(LLUUID::generateNewID());
+        LLPointer<LLVolume> stored = sculpt(params);
+
+        std::vector<fsyspath> paths = entries(mDir);
+        ensure_equals("one entry", paths.size(), 1);
+        std::error_code ec;
+        std::filesystem::resize_file(paths[0], std::filesystem::file_size(paths[0], ec) / 2, ec);
+        ensure("truncated", !ec);
+
+        LLPointer<LLVolume> regenerated = sculpt(params);
+        ensure_equals("no hit", LLVolumeCache::getHits(), 0);
+        ensure("same faces", same_faces(stored, regenerated));
+
+        // The miss stored the faces again
+        LLPointer<LLVolume> loaded = sculpt(params);
+        ensure_equals("hit", LLVolumeCache::getHits(), 1);
+        ensure("same faces from the new entry", same_faces(stored, loaded));
+    }
+
+    template<> template<>
+    void volumecache_object::test<5>()
+    {
+        set_test_name("purge trims to size, least recently used first");
+
+        std::vector<LLVolumeParams> params;
+        for (S32 i = 0; i < 8; ++i)
+        {
+            params.push_back(sculpt_params(LLUUID::generateNewID()));
+            sculpt(params.back());
+        }
+        std::vector<fsyspath> paths = entries(mDir);
+        ensure_equals("all stored", paths.size(), 8);
+
+        std::error_code ec;
+        const U64 entry_bytes = std::filesystem::file_size(paths[0], ec);
+
+        // Age every entry, then use the first one again
+        for (const fsyspath& path : paths)
+        {
+            std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now() - std::chrono::hours(1), ec);
+        }
+        sculpt(params[0]);
+        ensure_equals("hit", LLVolumeCache::getHits(), 1);
+
+        LLVolumeCache::cleanupClass();
+        LLVolumeCache::initClass(mDir, entry_bytes * 3, false);
+        ensure("trimmed", entries(mDir).size() <= 3);
+
+        sculpt(params[0]);
+        ensure_equals("recently used entry kept", LLVolumeCache::getHits(), 1);
+    }
+}
@@ -0,0 +1,319 @@
+/**
+ * @file llmessagecapture.cpp
+ * @brief Recording and playback of inbound message traffic.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "llmessagecapture.h"
+
+#include "llsdserialize.h"
+#include "lltimer.h"
+
+static const char CAPTURE_MAGIC[] = { 'L', 'L', 'M', 'C', 'A', 'P' };
+static const U16 CAPTURE_VERSION = 1;
+
+// Sanity limit for a single record, well above any UDP packet or event.
+static const U32 MAX_RECORD_DATA = 16 * 1024 * 1024;
+
+template<typename T>
+static void write_value(llofstream& out, const T& value)
+{
+    out.write((const char*)&value, sizeof(T));
+}
+
+template<typename T>
+static bool read_value(llifstream& in, T& value)
+{
+    in.read((char*)&value, sizeof(T));
+    return in.good();
+}
+
+LLMessageCapture::LLMessageCapture()
+:   mRecording(false),
+    mPlayingBack(false),
+    mSpeed(1.f),
+    mFirstRecordTime(0),
+    mPlaybackStartTime(0),
+    mRecordCount(0),
+    mHasPending(false)
+{
+}
+
+LLMessageCapture::~LLMessageCapture()
+{
+    stop();
+}
+
+bool LLMessageCapture::startRecording(const std::string& filename)
+{
+    stop();
+
+    mOutput.open(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!mOutput.is_open())
+    {
+        LL_WARNS("Messaging") << "Unable to open message capture file " << filename << LL_ENDL;
+        return false;
+    }
+
+    mOutput.write(CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC));
+    write_value(mOutput, CAPTURE_VERSION);
+
+    mFilename = filename;
+    mRecording = true;
+    mFirstRecordTime = 0;
+    mRecordCount = 0;
+    LL_INFOS("Messaging") << "Recording inbound messages to " << filename << LL_ENDL;
+    return true;
+}
+
+bool LLMessageCapture::startPlayback(const std::string& filename, F32 speed, done_callback_t done_callback)
+{
+    stop();
+
+    mInput.open(filename.c_str(), std::ios::in | std::ios::binary);
+    if (!mInput.is_open())
+    {
+        LL_WARNS("Messaging") << "Unable to open message capture file " << filename << LL_ENDL;
+        return false;
+    }
+
+    char magic[sizeof(CAPTURE_MAGIC)];
+    U16 version = 0;
+    mInput.read(magic, sizeof(magic));
+    if (!mInput.good() || memcmp(magic, CAPTURE_MAGIC, sizeof(magic)) != 0
+        || !read_value(mInput, version) || version != CAPTURE_VERSION)
+    {
+        LL_WARNS("Messaging") << "Not a message capture file, or unsupported version: " << filename << LL_ENDL;
+        mInput.close();
+        return false;
+    }
+
+    mFilename = filename;
+    mPlayingBack = true;
+    mSpeed = llmax(speed, 0.f);
+    mPlaybackStartTime = totalTime();
+    mRecordCount = 0;
+    mHasPending = false;
+    mDoneCallback = done_callback;
+    resetCosts();
+    LL_INFOS("Messaging") << "Playing back message capture " << filename << " at speed " << mSpeed << LL_ENDL;
+    return true;
+}
+
+void LLMessageCapture::stop()
+{
+    if (mRecording)
+    {
+        mOutput.close();
+        mRecording = false;
+        LL_INFOS("Messaging") << "Recorded " << mRecordCount << " inbound messages to " << mFilename << LL_ENDL;
+    }
+    if (mPlayingBack)
+    {
+        mInput.close();
+        mPlayingBack = false;
+        mHasPending = false;
+    }
+}
+
+void LLMessageCapture::recordPacket(const LLHost& host, const U8* data, S32 size)
+{
+    if (mRecording && size > 0)
+    {
+        writeRecord(RECORD_UDP, host, LLStringUtil::null, data, (U32)size);
+    }
+}
+
+void LLMessageCapture::recordLLSD(const std::string& name, const LLSD& message)
+{
+    if (!mRecording)
+    {
+        return;
+    }
+
+    std::ostringstream str;
+    LLSDSerialize::toBinary(message, str);
+    const std::string& data = str.str();
+    writeRecord(RECORD_LLSD, LLHost(), name, (const U8*)data.data(), (U32)data.size());
+}
+
+void LLMessageCapture::writeRecord(ERecordType type, const LLHost& host, const std::string& name, const U8* data, U32 size)
+{
+    U64 now = totalTime();
+    if (!mRecordCount)
+    {
+        mFirstRecordTime = now;
+    }
+
+    write_value(mOutput, (U8)type);
+    write_value(mOutput, (U64)(now - mFirstRecordTime));
+    write_value(mOutput, host.getAddress());
+    write_value(mOutput, (U16)host.getPort());
+    write_value(mOutput, (U16)name.size());
+    mOutput.write(name.data(), name.size());
+    write_value(mOutput, size);
+    mOutput.write((const char*)data, size);
+    mRecordCount++;
+
+    if (!mOutput.good())
+    {
+        LL_WARNS("Messaging") << "Write to message capture file " << mFilename << " failed, recording stopped" << LL_ENDL;
+        stop();
+    }
+}
+
+bool LLMessageCapture::readRecord(Record& record)
+{
+    U8 type;
+    U32 address, size;
+    U16 port, name_length;
+    if (!read_value(mInput, type)
+        || !read_value(mInput, record.mTime)
+        || !read_value(mInput, address)
+        || !read_value(mInput, port)
+        || !read_value(mInput, name_length))
+    {
+        return false;
+    }
+
+    record.mType = (ERecordType)type;
+    record.mHost.set(address, port);
+    record.mName.resize(name_length);
+    if (name_length)
+    {
+        mInput.read(&record.mName[0], name_length);
+    }
+    if (!read_value(mInput, size) || size > MAX_RECORD_DATA)
+    {
+        return false;
+    }
+    record.mData.resize(size);
+    if (size)
+    {
+        mInput.read((char*)record.mData.data(), size);
+    }
+    return mInput.good() && (type == RECORD_UDP || type == RECORD_LLSD);
+}
+
+bool LLMessageCapture::popDueRecord(Record& record)
+{
+    if (!mPlayingBack)
+    {
+        return false;
+    }
+
+    if (!mHasPending)
+    {
+        if (!readRecord(mPending))
+        {
+            finishPlayback();
+            return false;
+        }
+        mHasPending = true;
+    }
+
+    if (mSpeed > 0.f)
+    {
+        U64 elapsed = (U64)((F64)(totalTime() - mPlaybackStartTime) * mSpeed);
+        if (mPending.mTime > elapsed)
+        {
+            return false;
+        }
+    }
+
+    std::swap(record, mPending);
+    mHasPending = false;
+    mRecordCount++;
+    return true;
+}
+
+void LLMessageCapture::finishPlayback()
+{
+    F64 elapsed = (F64)(totalTime() - mPlaybackStartTime) / 1000000.0;
+    LL_INFOS("Messaging") << "Message capture playback of " << mFilename << " finished: "
+                          << mRecordCount << " records in " << elapsed << " seconds" << LL_ENDL;
+    stop();
+    logCostReport();
+
+    std::string report_filename = mFilename + ".report.xml";
+    llofstream report(report_filename.c_str());
+    if (report.is_open())
+    {
+        LLSDSerialize::toPrettyXML(getCostReport(), report);
+    }
+
+    if (mDoneCallback)
+    {
+        done_callback_t callback;
+        std::swap(callback, mDoneCallback);
+        callback();
+    }
+}
+
+void LLMessageCapture::addCost(const std::string& name, S32 bytes, F64 seconds)
+{
+    MessageCost& cost = mCosts[name];
+    cost.mCount++;
+    cost.mBytes += bytes;
+    cost.mSeconds += seconds;
+    cost.mMaxSeconds = llmax(cost.mMaxSeconds, seconds);
+}
+
+LLSD LLMessageCapture::getCostReport() const
+{
+    LLSD report = LLSD::emptyMap();
+    for (const auto& [name, cost] : mCosts)
+    {
+        LLSD& entry = report[name];
+        entry["count"] = (LLSD::Integer)cost.mCount;
+        entry["bytes"] = (LLSD::Real)cost.mBytes;
+        entry["total_ms"] = cost.mSeconds * 1000.0;
+        entry["mean_us"] = cost.mCount ? cost.mSeconds * 1000000.0 / cost.mCount : 0.0;
+        entry["max_us"] = cost.mMaxSeconds * 1000000.0;
+    }
+    return report;
+}
+
+void LLMessageCapture::logCostReport() const
+{
+    std::vector<std::pair<F64, std::string>> sorted;
+    sorted.reserve(mCosts.size());
+    for (const auto& [name, cost] : mCosts)
+    {
+        sorted.emplace_back(cost.mSeconds, name);
+    }
+    std::sort(sorted.rbegin(), sorted.rend());
+
+    LL_INFOS("Messaging") << "Message processing cost by type (count, bytes, total ms, mean us, max us):" << LL_ENDL;
+    for (const auto& [seconds, name] : sorted)
+    {
+        const MessageCost& cost = mCosts.at(name);
+        LL_INFOS("Messaging") << llformat("%-32s %8u %10llu %10.3f %8.1f %8.1f",
+                                          name.c_str(), cost.mCount, (unsigned long long)cost.mBytes,
+                                          cost.mSeconds * 1000.0,
+                                          cost.mCount ? cost.mSeconds * 1000000.0 / cost.mCount : 0.0,
+                                          cost.mMaxSeconds * 1000000.0) << LL_ENDL;
+    }
+}
@@ -0,0 +1,130 @@
+/**
+ * @file llmessagecapture.h
+ * @brief Recording and playback of inbound message traffic.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLMESSAGECAPTURE_H
+#define LL_LLMESSAGECAPTURE_H
+
+#include <functional>
+#include <map>
+#include <vector>
+
+#include "llfile.h"
+#include "llhost.h"
+#include "llsd.h"
+
+// Records inbound UDP packets and LLSD messages delivered through
+// LLMessageSystem::dispatch() (event queue capability traffic) to a compact
+// binary file, and feeds such a file back to the message system so that the
+// network driven code paths can be profiled reproducibly.
+//
+// File layout, host byte order:
+//   header: "LLMCAP" U16 version
+//   record: U8 type, U64 usecs since first record, U32 ip, U16 port,
+//           U16 name length, name, U32 data length, data
+// UDP records carry the raw packet as received (before zero-code expansion),
+// LLSD records carry the message name and the body as binary LLSD.
+class LLMessageCapture
+{
+public:
+    enum ERecordType : U8
+    {
+        RECORD_UDP  = 0,
+        RECORD_LLSD = 1
+    };
+
+    struct Record
+    {
+        ERecordType         mType = RECORD_UDP;
+        U64                 mTime = 0;
+        LLHost              mHost;
+        std::string         mName;
+        std::vector<U8>     mData;
+    };
+
+    typedef std::function<void()> done_callback_t;
+
+    LLMessageCapture();
+    ~LLMessageCapture();
+
+    bool startRecording(const std::string& filename);
+
+    // speed is a multiplier of the recorded pace, 0 plays back as fast as
+    // the message system can consume the records.
+    bool startPlayback(const std::string& filename, F32 speed, done_callback_t done_callback = nullptr);
+
+    void stop();
+
+    bool isRecording() const    { return mRecording; }
+    bool isPlayingBack() const  { return mPlayingBack; }
+
+    void recordPacket(const LLHost& host, const U8* data, S32 size);
+    void recordLLSD(const std::string& name, const LLSD& message);
+
+    // Fetch the next record if it is due. Returns false if there is none
+    // yet, or if the capture has been exhausted (playback is then stopped).
+    bool popDueRecord(Record& record);
+
+    // Processing cost accounting, per message type.
+    void addCost(const std::string& name, S32 bytes, F64 seconds);
+    void resetCosts()           { mCosts.clear(); }
+    LLSD getCostReport() const;
+    void logCostReport() const;
+
+    const std::string& getFilename() const { return mFilename; }
+
+private:
+    bool readRecord(Record& record);
+    void writeRecord(ERecordType type, const LLHost& host, const std::string& name, const U8* data, U32 size);
+    void finishPlayback();
+
+private:
+    struct MessageCost
+    {
+        U32 mCount = 0;
+        U64 mBytes = 0;
+        F64 mSeconds = 0.0;
+        F64 mMaxSeconds = 0.0;
+    };
+
+    std::string         mFilename;
+    llofstream          mOutput;
+    llifstream          mInput;
+
+    bool                mRecording;
+    bool                mPlayingBack;
+    F32                 mSpeed;
+    U64                 mFirstRecordTime;   // totalTime() of the first recorded record
+    U64                 mPlaybackStartTime; // totalTime() when playback started
+    U32                 mRecordCount;
+
+    Record              mPending;           // next record read from the file
+    bool                mHasPending;
+    done_callback_t     mDoneCallback;
+
+    std::map<std::string, MessageCost> mCosts;
+};
+
+#endif // LL_LLMESSAGECAPTURE_H
@@ -31,6 +31,8 @@ static bool sTimeDecodes = false;
 
 static F32 sTimeDecodesSpamThreshold = 0.05f;
 
+static bool sProfileTemplates = false;
+
 //virtual
 LLMessageReader::~LLMessageReader()
 {
@@ -60,3 +62,15 @@ F32 LLMessageReader::getTimeDecodesSpamThreshold()
 {
     return sTimeDecodesSpamThreshold;
 }
+
+//static
+void LLMessageReader::setProfileTemplates(bool b)
+{
+    sProfileTemplates = b;
+}
+
+//static
+bool LLMessageReader::getProfileTemplates()
+{
+    return sProfileTemplates;
+}
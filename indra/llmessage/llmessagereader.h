@@ -89,6 +89,10 @@ class LLMessageReader
     static bool getTimeDecodes();
     static void setTimeDecodesSpamThreshold(F32 seconds);
     static F32 getTimeDecodesSpamThreshold();
+
+    // Collect per template decode/handler time histograms, see LLMessageTemplateProfile
+    static void setProfileTemplates(bool b);
+    static bool getProfileTemplates();
 };
 
 #endif // LL_LLMESSAGEREADER_H
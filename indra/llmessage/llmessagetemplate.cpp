@@ -28,6 +28,8 @@
 
 #include "llmessagetemplate.h"
 
+#include "llmath.h"
+#include "lltrace.h"
 #include "message.h"
 
 void LLMsgVarData::addData(const void *data, S32 size, EMsgVariableType type, S32 data_size)
@@ -190,3 +192,132 @@ void LLMessageTemplate::banUdp()
     }
 }
 
+
+// Aggregate trace stats for all templates, and per message stats for the
+// types that dominate under load. Trace stats have to be declared statically,
+// the full per template breakdown is in LLMessageSystem::getTemplateProfile().
+static LLTrace::EventStatHandle<F64Seconds> MESSAGE_DECODE_TIME("messagedecodetime", "Time spent decoding UDP messages");
+static LLTrace::EventStatHandle<F64Seconds> MESSAGE_HANDLER_TIME("messagehandlertime", "Time spent in UDP message handlers");
+static LLTrace::EventStatHandle<F64Bytes> MESSAGE_BYTES("messagebytes", "Size of profiled UDP messages");
+
+static LLTrace::EventStatHandle<F64Seconds> OBJECT_UPDATE_TIME("msgobjectupdatetime", "ObjectUpdate decode and handler time");
+static LLTrace::EventStatHandle<F64Seconds> OBJECT_UPDATE_COMPRESSED_TIME("msgobjectupdatecompressedtime", "ObjectUpdateCompressed decode and handler time");
+static LLTrace::EventStatHandle<F64Seconds> OBJECT_UPDATE_CACHED_TIME("msgobjectupdatecachedtime", "ObjectUpdateCached decode and handler time");
+static LLTrace::EventStatHandle<F64Seconds> TERSE_UPDATE_TIME("msgterseupdatetime", "ImprovedTerseObjectUpdate decode and handler time");
+static LLTrace::EventStatHandle<F64Seconds> AVATAR_APPEARANCE_TIME("msgavatarappearancetime", "AvatarAppearance decode and handler time");
+static LLTrace::EventStatHandle<F64Seconds> IMAGE_DATA_TIME("msgimagedatatime", "ImageData and ImagePacket decode and handler time");
+static LLTrace::EventStatHandle<F64Seconds> LAYER_DATA_TIME("msglayerdatatime", "LayerData decode and handler time");
+
+static LLTrace::EventStatHandle<F64Seconds>* get_message_stat(const char* name)
+{
+    // Template names come from LLMessageStringTable, same as the prehash names.
+    if (name == _PREHASH_ObjectUpdate)                  return &OBJECT_UPDATE_TIME;
+    if (name == _PREHASH_ObjectUpdateCompressed)        return &OBJECT_UPDATE_COMPRESSED_TIME;
+    if (name == _PREHASH_ObjectUpdateCached)            return &OBJECT_UPDATE_CACHED_TIME;
+    if (name == _PREHASH_ImprovedTerseObjectUpdate)     return &TERSE_UPDATE_TIME;
+    if (name == _PREHASH_AvatarAppearance)              return &AVATAR_APPEARANCE_TIME;
+    if (name == _PREHASH_ImageData || name == _PREHASH_ImagePacket) return &IMAGE_DATA_TIME;
+    if (name == _PREHASH_LayerData)                     return &LAYER_DATA_TIME;
+    return NULL;
+}
+
+void LLMessageTemplateProfile::Histogram::add(F64 seconds)
+{
+    const F64 usecs = seconds * 1000000.0;
+    S32 bucket = 0;
+    if (usecs >= 1.0)
+    {
+        bucket = llmin(llfloor(log2(usecs)) + 1, NUM_BUCKETS - 1);
+    }
+    mBuckets[bucket]++;
+    mCount++;
+    mTotal += seconds;
+    mMax = llmax(mMax, seconds);
+}
+
+F64 LLMessageTemplateProfile::Histogram::getPercentile(F32 fraction) const
+{
+    if (!mCount)
+    {
+        return 0.0;
+    }
+
+    const U32 target = llmax((U32)1, (U32)ll_round(fraction * mCount));
+    U32 seen = 0;
+    for (S32 i = 0; i < NUM_BUCKETS - 1; ++i)
+    {
+        seen += mBuckets[i];
+        if (seen >= target)
+        {
+            return llmin((F64)(1 << i) / 1000000.0, mMax);
+        }
+    }
+    return mMax;
+}
+
+LLSD LLMessageTemplateProfile::Histogram::asLLSD() const
+{
+    LLSD sd;
+    sd["count"] = (LLSD::Integer)mCount;
+    sd["total_ms"] = mTotal * 1000.0;
+    sd["mean_us"] = mCount ? mTotal * 1000000.0 / mCount : 0.0;
+    sd["max_us"] = mMax * 1000000.0;
+    sd["p50_us"] = getPercentile(0.5f) * 1000000.0;
+    sd["p95_us"] = getPercentile(0.95f) * 1000000.0;
+    sd["p99_us"] = getPercentile(0.99f) * 1000000.0;
+
+    // Trailing empty buckets are left out
+    S32 last = NUM_BUCKETS - 1;
+    while (last >= 0 && !mBuckets[last])
+    {
+        --last;
+    }
+    LLSD& buckets = sd["log2_us_buckets"];
+    buckets = LLSD::emptyArray();
+    for (S32 i = 0; i <= last; ++i)
+    {
+        buckets.append((LLSD::Integer)mBuckets[i]);
+    }
+    return sd;
+}
+
+void LLMessageTemplateProfile::addSample(const char* name, F64 decode_seconds, F64 handler_seconds, S32 bytes)
+{
+    const U64 now = totalTime();
+    if (!mFirstSampleTime)
+    {
+        mFirstSampleTime = now;
+    }
+    mLastSampleTime = now;
+
+    mDecodeTime.add(decode_seconds);
+    mHandlerTime.add(handler_seconds);
+    mBytes += bytes;
+
+    record(MESSAGE_DECODE_TIME, F64Seconds(decode_seconds));
+    record(MESSAGE_HANDLER_TIME, F64Seconds(handler_seconds));
+    record(MESSAGE_BYTES, F64Bytes((F64)bytes));
+    if (LLTrace::EventStatHandle<F64Seconds>* stat = get_message_stat(name))
+    {
+        record(*stat, F64Seconds(decode_seconds + handler_seconds));
+    }
+}
+
+void LLMessageTemplateProfile::reset()
+{
+    *this = LLMessageTemplateProfile();
+}
+
+LLSD LLMessageTemplateProfile::asLLSD() const
+{
+    LLSD sd;
+    sd["count"] = (LLSD::Integer)mHandlerTime.mCount;
+    sd["bytes"] = (LLSD::Real)mBytes;
+    sd["decode"] = mDecodeTime.asLLSD();
+    sd["handler"] = mHandlerTime.asLLSD();
+
+    const F64 span = (F64)(mLastSampleTime - mFirstSampleTime) / 1000000.0;
+    sd["rate_per_sec"] = span > 0.0 ? (F64)mHandlerTime.mCount / span : 0.0;
+    sd["bytes_per_sec"] = span > 0.0 ? (F64)mBytes / span : 0.0;
+    return sd;
+}
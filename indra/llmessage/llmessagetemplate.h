@@ -266,6 +266,38 @@ enum EMsgDeprecation
 };
 
 
+// Per message type processing profile, filled in by LLTemplateMessageReader
+// while LLMessageReader::getProfileTemplates() is on.
+class LLMessageTemplateProfile
+{
+public:
+    // Bucket 0 holds samples under 1us, bucket i samples in [2^(i-1), 2^i) us,
+    // the last one everything above.
+    static const S32 NUM_BUCKETS = 24;
+
+    struct Histogram
+    {
+        U32 mBuckets[NUM_BUCKETS] = {};
+        U32 mCount = 0;
+        F64 mTotal = 0.0;   // seconds
+        F64 mMax = 0.0;     // seconds
+
+        void add(F64 seconds);
+        F64 getPercentile(F32 fraction) const; // upper bound of the bucket, seconds
+        LLSD asLLSD() const;
+    };
+
+    void addSample(const char* name, F64 decode_seconds, F64 handler_seconds, S32 bytes);
+    void reset();
+    LLSD asLLSD() const;
+
+    Histogram mDecodeTime;
+    Histogram mHandlerTime;
+    U64 mBytes = 0;
+    U64 mFirstSampleTime = 0;   // totalTime(), microseconds
+    U64 mLastSampleTime = 0;
+};
+
 class LLMessageTemplate
 {
 public:
@@ -426,6 +458,7 @@ public:
     U32                                     mTotalDecoded;      // Total messages successfully decoded
     F32                                     mTotalDecodeTime;   // Total time successfully decoding messages
     F32                                     mMaxDecodeTimePerMsg;
+    LLMessageTemplateProfile                mProfile;
 
     bool                                    mBanFromTrusted;
     bool                                    mBanFromUntrusted;
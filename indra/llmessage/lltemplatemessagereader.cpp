@@ -537,6 +537,9 @@ bool LLTemplateMessageReader::decodeData(const U8* buffer, const LLHost& sender
 {
     LL_RECORD_BLOCK_TIME(FTM_PROCESS_MESSAGES);
 
+    const bool profile = LLMessageReader::getProfileTemplates();
+    const U64 decode_start = profile ? (U64)totalTime() : 0;
+
     llassert( mReceiveSize >= 0 );
     llassert( mCurrentRMessageTemplate);
     llassert( !mCurrentRMessageData );
@@ -731,11 +734,22 @@ bool LLTemplateMessageReader::decodeData(const U8* buffer, const LLHost& sender
             decode_timer.reset();
         }
 
+        const U64 handler_start = profile ? (U64)totalTime() : 0;
+
         if( !mCurrentRMessageTemplate->callHandlerFunc(gMessageSystem) )
         {
             LL_WARNS() << "Message from " << sender << " with no handler function received: " << mCurrentRMessageTemplate->mName << LL_ENDL;
         }
 
+        if (profile)
+        {
+            const U64 handler_end = totalTime();
+            mCurrentRMessageTemplate->mProfile.addSample(mCurrentRMessageTemplate->mName,
+                                                         (F64)(handler_start - decode_start) / 1000000.0,
+                                                         (F64)(handler_end - handler_start) / 1000000.0,
+                                                         mReceiveSize);
+        }
+
         if(LLMessageReader::getTimeDecodes() || gMessageSystem->getTimingCallback())
         {
             F32 decode_time = decode_timer.getElapsedTimeF32();
@@ -55,6 +55,7 @@
 #include "llmd5.h"
 #include "llmessagebuilder.h"
 #include "llmessageconfig.h"
+#include "llmessagecapture.h"
 #include "lltemplatemessagedispatcher.h"
 #include "llpumpio.h"
 #include "lltemplatemessagebuilder.h"
@@ -78,6 +79,7 @@
 #include "lltransfertargetvfile.h"
 #include "llcorehttputil.h"
 #include "llpounceable.h"
+#include "workqueue.h"
 
 #include "nd/ndexceptions.h" // <FS:ND/> For ndxran
 
@@ -485,6 +487,103 @@ LLCircuitData* LLMessageSystem::findCircuit(const LLHost& host,
     return cdp;
 }
 
+bool LLMessageSystem::startCapture(const std::string& filename)
+{
+    if (!mCapture)
+    {
+        mCapture = std::make_unique<LLMessageCapture>();
+    }
+    return mCapture->startRecording(filename);
+}
+
+bool LLMessageSystem::startPlayback(const std::string& filename, F32 speed, std::function<void()> done_callback)
+{
+    if (!mCapture)
+    {
+        mCapture = std::make_unique<LLMessageCapture>();
+    }
+    return mCapture->startPlayback(filename, speed, done_callback);
+}
+
+void LLMessageSystem::stopCapture()
+{
+    if (mCapture)
+    {
+        mCapture->stop();
+    }
+}
+
+bool LLMessageSystem::isPlayingBack() const
+{
+    return mCapture && mCapture->isPlayingBack();
+}
+
+// Played back messages that would end, move or add to the live session
+static bool is_playback_session_message(const char* name)
+{
+    return name == _PREHASH_KickUser ||
+        name == _PREHASH_LogoutReply ||
+        name == _PREHASH_CloseCircuit ||
+        name == _PREHASH_DisableSimulator ||
+        name == _PREHASH_EnableSimulator ||
+        name == _PREHASH_CrossedRegion ||
+        name == _PREHASH_TeleportFinish;
+}
+
+S32 LLMessageSystem::receivePlaybackPacket()
+{
+    LLMessageCapture::Record record;
+    while (mCapture->popDueRecord(record))
+    {
+        if (record.mType == LLMessageCapture::RECORD_LLSD)
+        {
+            if (is_playback_session_message(LLMessageStringTable::getInstance()->getString(record.mName.c_str()))
+                || record.mName == "EstablishAgentCommunication")
+            {
+                continue;
+            }
+
+            // The LLSD handlers lock mMessageReader themselves, which the
+            // caller of checkMessages() already holds: run them from the
+            // main loop instead.
+            LL::WorkQueue::ptr_t main_queue = LL::WorkQueue::getInstance("mainloop");
+            if (main_queue)
+            {
+                main_queue->post([name = record.mName, data = std::move(record.mData)]()
+                {
+                    LLSD message;
+                    std::istringstream str(std::string(data.begin(), data.end()));
+                    if (LLSDSerialize::fromBinary(message, str, data.size()) <= 0)
+                    {
+                        LL_WARNS("Messaging") << "Bad LLSD record for " << name << " in message capture" << LL_ENDL;
+                        return;
+                    }
+
+                    const U64 start_time = totalTime();
+                    LLMessageSystem::dispatch(name, message);
+                    LLMessageCapture* capture = gMessageSystem ? gMessageSystem->getCapture() : nullptr;
+                    if (capture)
+                    {
+                        capture->addCost(name, (S32)data.size(), (F64)((U64)totalTime() - start_time) / 1000000.0);
+                    }
+                });
+            }
+            continue;
+        }
+
+        if (record.mData.empty() || record.mData.size() > MAX_BUFFER_SIZE)
+        {
+            continue;
+        }
+
+        memcpy(mTrueReceiveBuffer, record.mData.data(), record.mData.size());
+        mLastSender = record.mHost;
+        mLastReceivingIF = LLHost();
+        return (S32)record.mData.size();
+    }
+    return 0;
+}
+
 // Returns true if a valid, on-circuit message has been received.
 // Requiring a non-const LockMessageChecker reference ensures that
 // mMessageReader has been set to mTemplateMessageReader.
@@ -517,13 +616,29 @@ bool LLMessageSystem::checkMessages(LockMessageChecker&, S64 frame_count )
 
         U8* buffer = mTrueReceiveBuffer;
 
-        mTrueReceiveSize = mPacketRing.receivePacket(mSocket, (char *)mTrueReceiveBuffer);
+        // Played back packets come ahead of the live ones. They were
+        // validated when the traffic was live, so they are trusted, and are
+        // kept away from the circuits: no acks, resends or packet id tracking.
+        bool from_playback = false;
+        if (isPlayingBack())
+        {
+            mTrueReceiveSize = receivePlaybackPacket();
+            from_playback = mTrueReceiveSize > 0;
+        }
+        if (!from_playback)
+        {
+            mTrueReceiveSize = mPacketRing.receivePacket(mSocket, (char *)mTrueReceiveBuffer);
+            mLastSender = mPacketRing.getLastSender();
+            mLastReceivingIF = mPacketRing.getLastReceivingInterface();
+            if (mCapture && mCapture->isRecording())
+            {
+                mCapture->recordPacket(mLastSender, mTrueReceiveBuffer, mTrueReceiveSize);
+            }
+        }
         // If you want to dump all received packets into SecondLife.log, uncomment this
         //dumpPacketToLog();
 
         receive_size = mTrueReceiveSize;
-        mLastSender = mPacketRing.getLastSender();
-        mLastReceivingIF = mPacketRing.getLastReceivingInterface();
 
         if (receive_size < (S32) LL_MINIMUM_VALID_PACKET_SIZE)
         {
@@ -569,7 +684,7 @@ bool LLMessageSystem::checkMessages(LockMessageChecker&, S64 frame_count )
             host = getSender();
 
             const bool resetPacketId = true;
-            cdp = findCircuit(host, resetPacketId);
+            cdp = from_playback ? NULL : findCircuit(host, resetPacketId);
 
             // At this point, cdp is now a pointer to the circuit that
             // this message came in on if it's valid, and NULL if the
@@ -647,7 +762,7 @@ bool LLMessageSystem::checkMessages(LockMessageChecker&, S64 frame_count )
             // UseCircuitCode can be a valid, off-circuit packet.
             // But we don't want to acknowledge UseCircuitCode until the circuit is
             // available, which is why the acknowledgement test is done above.  JC
-            bool trusted = cdp && cdp->getTrusted();
+            bool trusted = from_playback || (cdp && cdp->getTrusted());
             valid_packet = mTemplateMessageReader->validateMessage(
                 buffer,
                 receive_size,
@@ -661,7 +776,7 @@ bool LLMessageSystem::checkMessages(LockMessageChecker&, S64 frame_count )
             // UseCircuitCode is allowed in even from an invalid circuit, so that
             // we can toss circuits around.
             else if (
-                !cdp &&
+                !cdp && !from_playback &&
                 (mTemplateMessageReader->getMessageName() !=
                  _PREHASH_UseCircuitCode))
             {
@@ -670,6 +785,12 @@ bool LLMessageSystem::checkMessages(LockMessageChecker&, S64 frame_count )
                 valid_packet = false;
             }
 
+            else if (from_playback && is_playback_session_message(mTemplateMessageReader->getMessageName()))
+            {
+                clearReceiveState();
+                valid_packet = false;
+            }
+
             if ( valid_packet &&
                 cdp &&
                 !cdp->getTrusted() &&
@@ -690,15 +811,23 @@ bool LLMessageSystem::checkMessages(LockMessageChecker&, S64 frame_count )
 
                 // valid_packet = mTemplateMessageReader->readMessage(buffer, host);
 
+                const std::string msg_name = from_playback ? mTemplateMessageReader->getMessageName() : std::string();
+                const U64 start_time = from_playback ? (U64)totalTime() : 0;
+
                 try { valid_packet = mTemplateMessageReader->readMessage(buffer, host); }
                 catch( nd::exceptions::xran &ex ) { LL_WARNS() << ex.what() << LL_ENDL; }
 
+                if (from_playback && mCapture)
+                {
+                    mCapture->addCost(msg_name, mTrueReceiveSize, (F64)((U64)totalTime() - start_time) / 1000000.0);
+                }
+
                 // </FS:ND>
             }
 
             // It's possible that the circuit went away, because ANY message can disable the circuit
             // (for example, UseCircuit, CloseCircuit, DisableSimulator).  Find it again.
-            cdp = mCircuitInfo.findCircuit(host);
+            cdp = from_playback ? NULL : mCircuitInfo.findCircuit(host);
 
             if (valid_packet)
             {
@@ -719,7 +848,7 @@ bool LLMessageSystem::checkMessages(LockMessageChecker&, S64 frame_count )
             }
             else
             {
-                if (mbProtected  && (!cdp))
+                if (mbProtected  && (!cdp) && !from_playback)
                 {
                     LL_WARNS("Messaging") << "Invalid Packet from invalid circuit " << host << LL_ENDL;
                     mOffCircuitPackets++;
@@ -2063,6 +2192,12 @@ void LLMessageSystem::dispatch(
     LLHTTPNode::ResponsePtr responsep)
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_NETWORK;
+    LLMessageCapture* capture = gMessageSystem->getCapture();
+    if (capture && capture->isRecording())
+    {
+        capture->recordLLSD(msg_name, message);
+    }
+
     if ((gMessageSystem->mMessageTemplates.find
             (LLMessageStringTable::getInstance()->getString(msg_name.c_str())) ==
                 gMessageSystem->mMessageTemplates.end()) &&
@@ -2666,6 +2801,17 @@ void end_messaging_system(bool print_summary)
             LL_INFOS("Messaging") << str.str().c_str() << LL_ENDL;
         }
 
+        if (LLMessageReader::getProfileTemplates())
+        {
+            std::string filename = gDirUtilp->getExpandedFilename(LL_PATH_LOGS, "message_profile.xml");
+            llofstream out(filename.c_str());
+            if (out.is_open())
+            {
+                LLSDSerialize::toPrettyXML(gMessageSystem->getTemplateProfile(), out);
+                LL_INFOS("Messaging") << "Wrote message template profile to " << filename << LL_ENDL;
+            }
+        }
+
         delete static_cast<LLMessageSystem*>(gMessageSystem);
         gMessageSystem = NULL;
     }
@@ -3998,6 +4144,33 @@ void LLMessageSystem::setTimeDecodesSpamThreshold( F32 seconds )
     LLMessageReader::setTimeDecodesSpamThreshold(seconds);
 }
 
+//static
+void LLMessageSystem::setProfileTemplates(bool b)
+{
+    LLMessageReader::setProfileTemplates(b);
+}
+
+LLSD LLMessageSystem::getTemplateProfile() const
+{
+    LLSD profile = LLSD::emptyMap();
+    for (const auto& [name, mt] : mMessageTemplates)
+    {
+        if (mt->mProfile.mHandlerTime.mCount)
+        {
+            profile[mt->mName] = mt->mProfile.asLLSD();
+        }
+    }
+    return profile;
+}
+
+void LLMessageSystem::resetTemplateProfile()
+{
+    for (const auto& [name, mt] : mMessageTemplates)
+    {
+        mt->mProfile.reset();
+    }
+}
+
 LockMessageChecker::LockMessageChecker(LLMessageSystem* msgsystem):
     // for the lifespan of this LockMessageChecker instance, use
     // LLTemplateMessageReader as msgsystem's mMessageReader
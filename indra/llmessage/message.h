@@ -183,6 +183,7 @@ class LLMessageBuilder;
 class LLTemplateMessageBuilder;
 class LLSDMessageBuilder;
 class LLMessageReader;
+class LLMessageCapture;
 class LLTemplateMessageReader;
 class LLSDMessageReader;
 
@@ -417,6 +418,17 @@ public:
     bool    checkMessages(LockMessageChecker&, S64 frame_count = 0 );
     void    processAcks(LockMessageChecker&, F32 collect_time = 0.f);
 
+    // Record inbound traffic to filename, see llmessagecapture.h
+    bool    startCapture(const std::string& filename);
+    // Feed a capture back through checkMessages() and dispatch() alongside
+    // the live socket. Played back packets bypass the circuits, so they are
+    // neither acked nor tracked, and live traffic carries on. speed 0 plays
+    // back as fast as possible, done_callback runs when the file is exhausted.
+    bool    startPlayback(const std::string& filename, F32 speed, std::function<void()> done_callback = nullptr);
+    void    stopCapture();
+    LLMessageCapture* getCapture() const { return mCapture.get(); }
+    bool    isPlayingBack() const;
+
     // returns total number of buffered packets after the drain
     S32     drainUdpSocket();
 
@@ -771,6 +783,11 @@ public:
     static void setTimeDecodes(bool b);
     static void setTimeDecodesSpamThreshold(F32 seconds);
 
+    // Per template decode time, handler time, bytes and rate profiling.
+    static void setProfileTemplates(bool b);
+    LLSD getTemplateProfile() const;    // map of message name to profile, received messages only
+    void resetTemplateProfile();
+
     // message handlers internal to the message systesm
     //static void processAssignCircuitCode(LLMessageSystem* msg, void**);
     static void processAddCircuitCode(LLMessageSystem* msg, void**);
@@ -918,6 +935,12 @@ private:
     /** Find, create or revive circuit for host as needed */
     LLCircuitData* findCircuit(const LLHost& host, bool resetPacketId);
 
+    // Next due UDP packet from the capture being played back, into
+    // mTrueReceiveBuffer. Due LLSD records are dispatched on the way.
+    S32 receivePlaybackPacket();
+
+    std::unique_ptr<LLMessageCapture> mCapture;
+
     // <FS:Ansariel> Restore original LLMessageSystem HTTP options for OpenSim
     bool mIsInSecondLife;
 };
@@ -0,0 +1,131 @@
+/**
+ * @file llmessagecapture_test.cpp
+ * @brief LLMessageCapture test cases.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "../llmessagecapture.h"
+
+#include "llsdserialize.h"
+#include "../test/lltut.h"
+#include "../test/namedtempfile.h"
+
+namespace tut
+{
+    struct messagecapture_data
+    {
+        messagecapture_data():
+            mPath(NamedTempFile::temp_path("capture", ".cap").string())
+        {
+        }
+
+        ~messagecapture_data()
+        {
+            LLFile::remove(mPath);
+            LLFile::remove(mPath + ".report.xml");
+        }
+
+        std::string mPath;
+    };
+    typedef test_group<messagecapture_data> messagecapture_test;
+    typedef messagecapture_test::object messagecapture_object;
+    tut::messagecapture_test messagecapture_testcase("LLMessageCapture");
+
+    template<> template<>
+    void messagecapture_object::test<1>()
+    {
+        set_test_name("record and play back");
+
+        const U8 packet[] = { 0x40, 0x00, 0x00, 0x00, 0x01, 0x00, 0xff, 0x01 };
+        LLHost host(0x0a000001, 13005);
+        LLSD body;
+        body["AgentData"]["AgentID"] = LLUUID::generateNewID();
+        body["Info"]["Count"] = 3;
+
+        {
+            LLMessageCapture capture;
+            ensure("start recording", capture.startRecording(mPath));
+            capture.recordPacket(host, packet, sizeof(packet));
+            capture.recordLLSD("EnableSimulator", body);
+            capture.stop();
+        }
+
+        LLMessageCapture capture;
+        bool done = false;
+        ensure("start playback", capture.startPlayback(mPath, 0.f, [&done]() { done = true; }));
+
+        LLMessageCapture::Record record;
+        ensure("first record", capture.popDueRecord(record));
+        ensure_equals("udp type", record.mType, LLMessageCapture::RECORD_UDP);
+        ensure_equals("host", record.mHost, host);
+        ensure_equals("packet size", record.mData.size(), sizeof(packet));
+        ensure("packet data", memcmp(record.mData.data(), packet, sizeof(packet)) == 0);
+
+        ensure("second record", capture.popDueRecord(record));
+        ensure_equals("llsd type", record.mType, LLMessageCapture::RECORD_LLSD);
+        ensure_equals("name", record.mName, std::string("EnableSimulator"));
+        LLSD decoded;
+        std::istringstream str(std::string(record.mData.begin(), record.mData.end()));
+        ensure("llsd decodes", LLSDSerialize::fromBinary(decoded, str, record.mData.size()) > 0);
+        ensure_equals("llsd body", decoded["Info"]["Count"].asInteger(), 3);
+
+        ensure("no more records", !capture.popDueRecord(record));
+        ensure("playback stopped", !capture.isPlayingBack());
+        ensure("done callback", done);
+    }
+
+    template<> template<>
+    void messagecapture_object::test<2>()
+    {
+        set_test_name("reject garbage");
+
+        {
+            llofstream out(mPath.c_str());
+            out << "not a capture";
+        }
+
+        LLMessageCapture capture;
+        ensure("bad file rejected", !capture.startPlayback(mPath, 0.f));
+        ensure("missing file rejected", !capture.startPlayback(mPath + ".missing", 0.f));
+    }
+
+    template<> template<>
+    void messagecapture_object::test<3>()
+    {
+        set_test_name("cost report");
+
+        LLMessageCapture capture;
+        capture.addCost("ObjectUpdate", 100, 0.002);
+        capture.addCost("ObjectUpdate", 300, 0.004);
+        capture.addCost("ImprovedTerseObjectUpdate", 50, 0.001);
+
+        LLSD report = capture.getCostReport();
+        ensure_equals("count", report["ObjectUpdate"]["count"].asInteger(), 2);
+        ensure_equals("bytes", report["ObjectUpdate"]["bytes"].asReal(), 400.0);
+        ensure_approximately_equals("mean", (F32)report["ObjectUpdate"]["mean_us"].asReal(), 3000.f, 8);
+        ensure_approximately_equals("max", (F32)report["ObjectUpdate"]["max_us"].asReal(), 4000.f, 8);
+        ensure("terse present", report.has("ImprovedTerseObjectUpdate"));
+    }
+}
@@ -0,0 +1,122 @@
+/**
+ * @file llmessagetemplate_test.cpp
+ * @brief LLMessageTemplateProfile test cases.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "../llmessagetemplate.h"
+
+#include "../test/lltut.h"
+
+namespace
+{
+    const F64 USEC = 0.000001;
+}
+
+namespace tut
+{
+    struct messagetemplate_data
+    {
+        typedef LLMessageTemplateProfile::Histogram Histogram;
+
+        void add(Histogram& histogram, U32 count, F64 usecs)
+        {
+            for (U32 i = 0; i < count; ++i)
+            {
+                histogram.add(usecs * USEC);
+            }
+        }
+    };
+    typedef test_group<messagetemplate_data> messagetemplate_test;
+    typedef messagetemplate_test::object messagetemplate_object;
+    tut::messagetemplate_test messagetemplate_testcase("LLMessageTemplateProfile");
+
+    template<> template<>
+    void messagetemplate_object::test<1>()
+    {
+        set_test_name("bucketing");
+
+        Histogram histogram;
+        ensure_equals("empty percentile", histogram.getPercentile(0.5f), 0.0);
+
+        histogram.add(0.5 * USEC);
+        histogram.add(1.5 * USEC);
+        histogram.add(3.0 * USEC);
+        histogram.add(100.0 * USEC);
+        histogram.add(100.0);
+        ensure_equals("under 1us", histogram.mBuckets[0], 1U);
+        ensure_equals("[1, 2) us", histogram.mBuckets[1], 1U);
+        ensure_equals("[2, 4) us", histogram.mBuckets[2], 1U);
+        ensure_equals("[64, 128) us", histogram.mBuckets[7], 1U);
+        ensure_equals("overflow", histogram.mBuckets[LLMessageTemplateProfile::NUM_BUCKETS - 1], 1U);
+        ensure_equals("count", histogram.mCount, 5U);
+        ensure_approximately_equals("max", histogram.mMax, 100.0, 20);
+    }
+
+    template<> template<>
+    void messagetemplate_object::test<2>()
+    {
+        set_test_name("percentiles");
+
+        Histogram histogram;
+        add(histogram, 50, 0.5);
+        add(histogram, 45, 3.0);
+        add(histogram, 4, 100.0);
+        add(histogram, 1, 5000.0);
+
+        // Upper bounds of the buckets the ranks fall in, capped by the max
+        ensure_approximately_equals("p50", histogram.getPercentile(0.5f), 1.0 * USEC, 20);
+        ensure_approximately_equals("p95", histogram.getPercentile(0.95f), 4.0 * USEC, 20);
+        ensure_approximately_equals("p99", histogram.getPercentile(0.99f), 128.0 * USEC, 20);
+        ensure_approximately_equals("p100", histogram.getPercentile(1.f), 5000.0 * USEC, 20);
+
+        Histogram single;
+        single.add(3.0 * USEC);
+        ensure_approximately_equals("capped by max", single.getPercentile(0.5f), 3.0 * USEC, 20);
+
+        Histogram overflow;
+        overflow.add(100.0);
+        ensure_approximately_equals("overflow", overflow.getPercentile(0.5f), 100.0, 20);
+    }
+
+    template<> template<>
+    void messagetemplate_object::test<3>()
+    {
+        set_test_name("report");
+
+        Histogram histogram;
+        // The 90th rank falls in the 4us bucket, the 95th in the 128us one
+        add(histogram, 85, 0.5);
+        add(histogram, 7, 3.0);
+        add(histogram, 8, 100.0);
+
+        LLSD sd = histogram.asLLSD();
+        ensure_equals("count", sd["count"].asInteger(), 100);
+        ensure_approximately_equals("p50", sd["p50_us"].asReal(), 1.0, 20);
+        ensure_approximately_equals("p95", sd["p95_us"].asReal(), 100.0, 20);
+        ensure_approximately_equals("p99", sd["p99_us"].asReal(), 100.0, 20);
+        ensure_equals("trailing empty buckets", sd["log2_us_buckets"].size(), 8);
+    }
+}
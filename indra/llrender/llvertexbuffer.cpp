@@ -1034,6 +1034,10 @@ LLVertexBuffer::LLVertexBuffer(U32 typemask)
 // NOTE: must not be LLPointer<LLVertexBuffer> to avoid breaking non-ref-counted LLVertexBuffer instances
 static std::vector<LLVertexBuffer*> sMappedBuffers;
 
+// guards sMappedBuffers and the mapped region lists, so geometry rebuild jobs
+// can fill disjoint ranges of mapped buffers from worker threads
+static std::mutex sMappedBuffersMutex;
+
 //static
 void LLVertexBuffer::flushBuffers()
 {
@@ -1298,6 +1302,7 @@ bool expand_region(LLVertexBuffer::MappedRegion& region, U32 start, U32 end)
 U8* LLVertexBuffer::mapVertexBuffer(LLVertexBuffer::AttributeType type, U32 index, S32 count)
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_VERTEX;
+    std::lock_guard<std::mutex> lock(sMappedBuffersMutex);
     _mapBuffer();
 
     if (count == -1)
@@ -1335,6 +1340,7 @@ U8* LLVertexBuffer::mapVertexBuffer(LLVertexBuffer::AttributeType type, U32 inde
 U8* LLVertexBuffer::mapIndexBuffer(U32 index, S32 count)
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_VERTEX;
+    std::lock_guard<std::mutex> lock(sMappedBuffersMutex);
     _mapBuffer();
 
     if (count == -1)
@@ -196,6 +196,8 @@ public:
     bool    allocateBuffer(U32 nverts, U32 nindices);
 
     // map for data access (see also getFooStrider below)
+    // may be called from worker threads that fill disjoint ranges of the buffer,
+    // flushing to GL (unmapBuffer, flushBuffers) stays on the main thread
     U8*     mapVertexBuffer(AttributeType type, U32 index, S32 count = -1);
     U8*     mapIndexBuffer(U32 index, S32 count = -1);
 
@@ -2271,14 +2271,69 @@ void LLFolderViewFolder::draw()
     LLFolderViewItem::draw();
 
     // draw children if root folder, or any other folder that is open or animating to closed state
-    if( getRoot() == this || (isOpen() || mCurHeight != mTargetHeight ))
+    if (getRoot() == this)
     {
         LLView::draw();
     }
+    else if (isOpen() || mCurHeight != mTargetHeight)
+    {
+        drawVisibleChildren();
+    }
 
     mExpanderHighlighted = false;
 }
 
+void LLFolderViewFolder::drawVisibleChildren()
+{
+    LLFolderView* root = getRoot();
+    LLRect visible_rect;
+    if (!root || root->getVisibleRect().isEmpty()
+        || !root->localRectToOtherView(root->getVisibleRect(), &visible_rect, this))
+    {
+        LLView::draw();
+        return;
+    }
+
+    // Visible children are laid out top to bottom, the folders first then
+    // the items, so the rows above the scrolled view are skipped without
+    // computing their screen rectangles and each list stops at the first
+    // row below it. Hidden children keep stale rectangles and are passed
+    // over. A folder of thousands of items only draws the rows that can be
+    // seen.
+    for (LLFolderViewFolder* folderp : mFolders)
+    {
+        if (!folderp->getVisible())
+        {
+            continue;
+        }
+        const LLRect& rect = folderp->getRect();
+        if (rect.mTop < visible_rect.mBottom)
+        {
+            break;
+        }
+        if (rect.mBottom <= visible_rect.mTop)
+        {
+            drawChild(folderp);
+        }
+    }
+    for (LLFolderViewItem* itemp : mItems)
+    {
+        if (!itemp->getVisible())
+        {
+            continue;
+        }
+        const LLRect& rect = itemp->getRect();
+        if (rect.mTop < visible_rect.mBottom)
+        {
+            break;
+        }
+        if (rect.mBottom <= visible_rect.mTop)
+        {
+            drawChild(itemp);
+        }
+    }
+}
+
 // this does prefix traversal, as folders are listed above their contents
 LLFolderViewItem* LLFolderViewFolder::getNextFromChild( LLFolderViewItem* item, bool include_children )
 {
@@ -349,6 +349,8 @@ protected:
 
     void updateLabelRotation();
     virtual bool isCollapsed() { return false; }
+    // Draws the children that are scrolled into view
+    void drawVisibleChildren();
 
 public:
     typedef std::list<LLFolderViewItem*> items_t;
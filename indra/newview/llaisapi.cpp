@@ -52,6 +52,7 @@ const std::string AISAPI::LIBRARY_CAP_NAME("LibraryAPIv3");
 const S32 AISAPI::HTTP_TIMEOUT = 180;
 
 std::list<AISAPI::ais_query_item_t> AISAPI::sPostponedQuery;
+U32 AISAPI::sThrottledCount = 0;
 
 const S32 MAX_SIMULTANEOUS_COROUTINES = 2048;
 
@@ -922,6 +923,10 @@ void AISAPI::InvokeAISCommandCoro(LLCoreHttpUtil::HttpCoroutineAdapter::ptr_t ht
                 }
             }
         }
+        else if (status.getType() == HTTP_SERVICE_UNAVAILABLE || status.getType() == 429) // TOO MANY REQUESTS
+        {
+            ++sThrottledCount;
+        }
         else if (status == LLCore::HttpStatus(HTTP_FORBIDDEN) /*403*/)
         {
             if (type == FETCHCATEGORYCHILDREN)
@@ -49,6 +49,10 @@ public:
     static bool isAvailable();
     static void getCapNames(LLSD& capNames);
 
+    // Counts the requests the server turned away as overloaded (429, 503),
+    // so that callers can back off.
+    static U32 getThrottledCount() { return sThrottledCount; }
+
     static void CreateInventory(const LLUUID& parentId, const LLSD& newInventory, completion_t callback = completion_t());
     static void SlamFolder(const LLUUID& folderId, const LLSD& newInventory, completion_t callback = completion_t());
     static void RemoveCategory(const LLUUID &categoryId, completion_t callback = completion_t());
@@ -105,6 +109,7 @@ private:
 
     typedef std::pair<std::string, LLCoprocedureManager::CoProcedure_t> ais_query_item_t;
     static std::list<ais_query_item_t> sPostponedQuery;
+    static U32 sThrottledCount;
 };
 
 class AISUpdate
@@ -618,32 +618,24 @@ public:
     {
     }
     /* virtual */ void changed(U32 mask);
+    /* virtual */ U32 getInterestMask() const { return REBUILD; }
     void postProcess();
 };
 
 void LLBrokenLinkObserver::changed(U32 mask)
 {
-    if (mask & LLInventoryObserver::REBUILD)
+    // This observer should be executed after LLInventoryPanel::itemChanged(),
+    // but if it isn't, consider calling updateAppearanceFromCOF with a delay
+    if ((mask & LLInventoryObserver::REBUILD) && gInventory.getChangedIDs().count(mUUID))
     {
-        // This observer should be executed after LLInventoryPanel::itemChanged(),
-        // but if it isn't, consider calling updateAppearanceFromCOF with a delay
-        const uuid_set_t& changed_item_ids = gInventory.getChangedIDs();
-        for (uuid_set_t::const_iterator it = changed_item_ids.begin(); it != changed_item_ids.end(); ++it)
-        {
-            const LLUUID& id = *it;
-            if (id == mUUID)
-            {
-                // Might not be processed yet and it is not a
-                // good idea to update appearane here, postpone.
-                doOnIdleOneTime([this]()
-                                {
-                                    postProcess();
-                                });
+        // Might not be processed yet and it is not a
+        // good idea to update appearane here, postpone.
+        doOnIdleOneTime([this]()
+                        {
+                            postProcess();
+                        });
 
-                gInventory.removeObserver(this);
-                return;
-            }
-        }
+        gInventory.removeObserver(this);
     }
 }
 
@@ -918,6 +910,11 @@ void LLWearableHoldingPattern::onAllComplete()
         }
     }
 
+    if (isMostRecent())
+    {
+        selfStartPhase("apply_outfit");
+    }
+
     if (isAgentAvatarValid())
     {
         LL_DEBUGS("Avatar") << self_av_string() << "Updating " << mObjItems.size() << " attachments" << LL_ENDL;
@@ -971,6 +968,11 @@ void LLWearableHoldingPattern::onAllComplete()
         LLAgentWearables::userAttachMultipleAttachments(items_to_add);
     }
 
+    if (isMostRecent())
+    {
+        selfStopPhase("apply_outfit");
+    }
+
     if (isFetchCompleted() && isMissingCompleted())
     {
         // Only safe to delete if all wearable callbacks and all missing wearables completed.
@@ -1373,6 +1375,60 @@ static void onWearableAssetFetch(LLViewerWearable* wearable, void* data)
     holder->onWearableAssetFetch(wearable);
 }
 
+// Wearable assets requested by prefetch_wearable_assets() not back yet
+static S32 sPendingWearablePrefetches = 0;
+static LLTimer sWearablePrefetchTimer;
+
+static void onWearableAssetPrefetch(LLViewerWearable* wearable, void* data)
+{
+    if (--sPendingWearablePrefetches == 0)
+    {
+        LL_INFOS("Avatar") << self_av_string() << "wearable prefetch done, elapsed "
+                           << sWearablePrefetchTimer.getElapsedTimeF32() << LL_ENDL;
+        selfStopPhase("prefetch_wearables");
+    }
+}
+
+// Starts loading the wearables of the items about to be linked into the
+// COF, so that they, and the textures they reference, load while the COF
+// is rebuilt rather than once updateAppearanceFromCOF() asks for them.
+// The holding pattern then finds them in LLWearableList.
+static void prefetch_wearable_assets(const LLInventoryModel::item_array_t& items)
+{
+    if (!isAgentAvatarValid())
+    {
+        return;
+    }
+
+    // Held for the loop, so that the assets already cached do not close
+    // the phase one by one
+    if (sPendingWearablePrefetches++ == 0)
+    {
+        sWearablePrefetchTimer.reset();
+        selfStartPhase("prefetch_wearables");
+    }
+
+    std::set<LLUUID> asset_ids;
+    for (LLViewerInventoryItem* item : items)
+    {
+        // Accessors follow links
+        if (!item || !item->isWearableType())
+        {
+            continue;
+        }
+        const LLUUID& asset_id = item->getAssetUUID();
+        if (asset_id.isNull() || LLWearableList::instance().isLoaded(asset_id) || !asset_ids.insert(asset_id).second)
+        {
+            continue;
+        }
+        ++sPendingWearablePrefetches;
+        LLWearableList::instance().prefetchAsset(asset_id, gAgentAvatarp, item->getType(), onWearableAssetPrefetch, NULL);
+    }
+    LL_DEBUGS("Avatar") << self_av_string() << "prefetching " << asset_ids.size() << " wearables" << LL_ENDL;
+
+    onWearableAssetPrefetch(NULL, NULL);
+}
+
 
 static void removeDuplicateItems(LLInventoryModel::item_array_t& items)
 {
@@ -2430,6 +2486,10 @@ void LLAppearanceMgr::updateCOF(LLInventoryModel::item_array_t& body_items_new,
     {
         dump_sequential_xml(gAgentAvatarp->getFullname() + "_slam_request", contents);
     }
+    // Attachments are rezzed by the region from the links, there is
+    // nothing to load for them ahead of time
+    prefetch_wearable_assets(body_items);
+    prefetch_wearable_assets(wear_items);
     slam_inventory_folder(getCOF(), contents, link_waiter);
 
     LL_DEBUGS("Avatar") << self_av_string() << "waiting for LLUpdateAppearanceOnDestroy" << LL_ENDL;
@@ -137,6 +137,8 @@
 #include "llurlaction.h"
 #include "llurlentry.h"
 #include "llvolumemgr.h"
+#include "llvolumebvh.h"
+#include "llvolumecache.h"
 #include "llxfermanager.h"
 #include "llphysicsextensions.h"
 
@@ -253,6 +255,7 @@
 #include "lldrawpoolbump.h"
 #include "llvieweraudio.h"
 #include "llimview.h"
+#include "llinterestmanager.h"
 #include "llviewerthrottle.h"
 #include "llparcel.h"
 #include "llavatariconctrl.h"
@@ -602,6 +605,7 @@ static void settings_to_globals()
     LLVOVolume::sLODFactor              = llclamp(gSavedSettings.getF32("RenderVolumeLODFactor"), 0.01f, MAX_LOD_FACTOR);
     LLVOVolume::sDistanceFactor         = 1.f-LLVOVolume::sLODFactor * 0.1f;
     LLVolumeImplFlexible::sUpdateFactor = gSavedSettings.getF32("RenderFlexTimeFactor");
+    LLVolumeBVH::sUseBVH                = gSavedSettings.getBOOL("RaycastFaceBVH");
     LLVOTree::sTreeFactor               = gSavedSettings.getF32("RenderTreeLODFactor");
     LLVOAvatar::sLODFactor              = llclamp(gSavedSettings.getF32("RenderAvatarLODFactor"), 0.f, MAX_AVATAR_LOD_FACTOR);
     LLVOAvatar::sPhysicsLODFactor       = llclamp(gSavedSettings.getF32("RenderAvatarPhysicsLODFactor"), 0.f, MAX_AVATAR_LOD_FACTOR);
@@ -5247,6 +5251,12 @@ bool LLAppViewer::initCache()
     const U32 CACHE_NUMBER_OF_REGIONS_FOR_OBJECTS = 128;
     LLVOCache::getInstance()->initCache(LL_PATH_CACHE, CACHE_NUMBER_OF_REGIONS_FOR_OBJECTS, getObjectCacheVersion());
 
+    if (gSavedSettings.getBOOL("VolumeGeometryCache"))
+    {
+        const U64 volume_cache_size = U64(gSavedSettings.getU32("VolumeGeometryCacheSize")) * MB;
+        LLVolumeCache::initClass(gDirUtilp->getExpandedFilename(LL_PATH_CACHE, "volumes"), volume_cache_size, read_only);
+    }
+
     return true;
 }
 
@@ -5277,6 +5287,7 @@ void LLAppViewer::purgeCache()
     LLAppViewer::getTextureCache()->purgeCache(LL_PATH_CACHE);
     LLVOCache::getInstance()->removeCache(LL_PATH_CACHE);
     LLViewerShaderMgr::instance()->clearShaderCache();
+    gDirUtilp->deleteDirAndContents(gDirUtilp->getExpandedFilename(LL_PATH_CACHE, "volumes"));
     std::string browser_cache = gDirUtilp->getExpandedFilename(LL_PATH_CACHE, "cef_cache");
     if (LLFile::isdir(browser_cache))
     {
@@ -6310,6 +6321,7 @@ void LLAppViewer::idleNetwork()
 
     gObjectList.mNumNewObjects = 0;
     S32 total_decoded = 0;
+    bool messages_backlogged = false;
 
     static LLCachedControl<bool> speed_test(gSavedSettings, "SpeedTest", false);
     if (!speed_test())
@@ -6360,6 +6372,8 @@ void LLAppViewer::idleNetwork()
                 S32 num_buffered_packets = gMessageSystem->drainUdpSocket();
                 if (num_buffered_packets > 0)
                 {
+                    messages_backlogged = true;
+
                     // Increase CheckMessagesMaxTime so that we will eventually catch up
                     CheckMessagesMaxTime *= 1.035f; // 3.5% ~= 2x in 20 frames, ~8x in 60 frames
                 }
@@ -6378,6 +6392,10 @@ void LLAppViewer::idleNetwork()
     }
     add(LLStatViewer::NUM_NEW_OBJECTS, gObjectList.mNumNewObjects);
 
+    // Apply object updates put off while the viewer was behind, as budget allows
+    LLInterestManager::getInstance()->updateLoad(messages_backlogged);
+    LLInterestManager::getInstance()->processDeferredUpdates();
+
     // Retransmit unacknowledged packets.
     gXferManager->retransmitUnackedPackets();
     gAssetStorage->checkForTimeouts();
@@ -6485,6 +6503,7 @@ void LLAppViewer::disconnectViewer()
         LLWorld::getInstance()->resetClass();
     }
     LLVOCache::deleteSingleton();
+    LLVolumeCache::cleanupClass();
 
     // call all self-registered classes
     LLDestroyClassList::instance().fireCallbacks();
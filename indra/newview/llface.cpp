@@ -34,6 +34,7 @@
 #include "llvolume.h"
 #include "m3math.h"
 #include "llmatrix4a.h"
+#include "llvertextransform.h"
 #include "v3color.h"
 
 #include "lldefs.h"
@@ -795,50 +796,6 @@ static void xform(LLVector2 &tex_coord, F32 cosAng, F32 sinAng, F32 offS, F32 of
     tex_coord.mV[1] = t;
 }
 
-// Transform the texture coordinates for this face.
-static void xform4a(LLVector4a &tex_coord, const LLVector4a& trans, const LLVector4Logical& mask, const LLVector4a& rot0, const LLVector4a& rot1, const LLVector4a& offset, const LLVector4a& scale)
-{
-    //tex coord is two coords, <s0, t0, s1, t1>
-    LLVector4a st;
-
-    // Texture transforms are done about the center of the face.
-    st.setAdd(tex_coord, trans);
-
-    // Handle rotation
-    LLVector4a rot_st;
-
-    // <s0 * cosAng, s0*-sinAng, s1*cosAng, s1*-sinAng>
-    LLVector4a s0;
-    s0.splat(st, 0);
-    LLVector4a s1;
-    s1.splat(st, 2);
-    LLVector4a ss;
-    ss.setSelectWithMask(mask, s1, s0);
-
-    LLVector4a a;
-    a.setMul(rot0, ss);
-
-    // <t0*sinAng, t0*cosAng, t1*sinAng, t1*cosAng>
-    LLVector4a t0;
-    t0.splat(st, 1);
-    LLVector4a t1;
-    t1.splat(st, 3);
-    LLVector4a tt;
-    tt.setSelectWithMask(mask, t1, t0);
-
-    LLVector4a b;
-    b.setMul(rot1, tt);
-
-    st.setAdd(a,b);
-
-    // Then scale
-    st.mul(scale);
-
-    // Then offset
-    tex_coord.setAdd(st, offset);
-}
-
-
 bool less_than_max_mag(const LLVector4a& vec)
 {
     LLVector4a MAX_MAG;
@@ -1211,7 +1168,8 @@ bool LLFace::getGeometryVolume(const LLVolume& volume,
                                 U16 index_offset,
                                 bool force_rebuild,
                                 bool no_debug_assert,
-                                bool rebuild_for_gltf)
+                                bool rebuild_for_gltf,
+                                const LLMaterialPtr* job_material)
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_FACE;
     llassert(verify());
@@ -1402,7 +1360,7 @@ bool LLFace::getGeometryVolume(const LLVolume& volume,
         if (tep &&
             !isInAlphaPool() && tep->getGLTFRenderMaterial() == nullptr)  // <--- alpha channel MUST contain transparency, not shiny
     {
-            LLMaterial* mat = tep->getMaterialParams().get();
+            LLMaterial* mat = job_material ? job_material->get() : tep->getMaterialParams().get();
 
             bool shiny_in_alpha = false;
 
@@ -1460,7 +1418,7 @@ bool LLFace::getGeometryVolume(const LLVolume& volume,
 
     // <FS:ND> Protection against faces w/o te set.
     // LLMaterial* mat = tep->getMaterialParams().get();
-    LLMaterial* mat = tep ? tep->getMaterialParams().get() : 0;
+    LLMaterial* mat = job_material ? job_material->get() : (tep ? tep->getMaterialParams().get() : 0);
     // </FS:ND>
 
     F32 r = 0, os = 0, ot = 0, ms = 0, mt = 0, cos_ang = 0, sin_ang = 0;
@@ -1731,38 +1689,8 @@ bool LLFace::getGeometryVolume(const LLVolume& volume,
                         else
                         {
                             LL_PROFILE_ZONE_NAMED_CATEGORY_FACE("ggv - texgen 2");
-                            F32* dst = (F32*) tex_coords0.get();
-                            LLVector4a* src = (LLVector4a*) vf.mTexCoords;
-
-                            LLVector4a trans;
-                            trans.splat(-0.5f);
-
-                            LLVector4a rot0;
-                            rot0.set(cos_ang, -sin_ang, cos_ang, -sin_ang);
-
-                            LLVector4a rot1;
-                            rot1.set(sin_ang, cos_ang, sin_ang, cos_ang);
-
-                            LLVector4a scale;
-                            scale.set(ms, mt, ms, mt);
-
-                            LLVector4a offset;
-                            offset.set(os+0.5f, ot+0.5f, os+0.5f, ot+0.5f);
-
-                            LLVector4Logical mask;
-                            mask.clear();
-                            mask.setElement<2>();
-                            mask.setElement<3>();
-
-                            S32 count = num_vertices/2 + num_vertices%2;
-
-                            for (S32 i = 0; i < count; i++)
-                            {
-                                LLVector4a res = *src++;
-                                xform4a(res, trans, mask, rot0, rot1, offset, scale);
-                                res.store4a(dst);
-                                dst += 4;
-                            }
+                            LLVertexTransform::transformTexCoords(vf.mTexCoords, num_vertices, cos_ang, sin_ang,
+                                                                  os, ot, ms, mt, tex_coords0.get());
                         }
                     }
                     else
@@ -2037,8 +1965,6 @@ bool LLFace::getGeometryVolume(const LLVolume& volume,
 
             LLVector4a res0; //,res1,res2,res3;
 
-            LLVector4a texIdx;
-
             S32 index = mTextureIndex < FACE_DO_NOT_BATCH_TEXTURES ? mTextureIndex : 0;
 
             F32 val = 0.f;
@@ -2047,21 +1973,12 @@ bool LLFace::getGeometryVolume(const LLVolume& volume,
 
             llassert(index < LLGLSLShader::sIndexedTextureChannels);
 
-            LLVector4Logical mask;
-            mask.clear();
-            mask.setElement<3>();
-
-            texIdx.set(0,0,0,val);
+            LLVertexTransform::transformPositions(mat_vert, src, num_vertices, val, (LLVector4a*) dst);
+            dst += num_vertices*4;
 
-            LLVector4a tmp;
-
-
-            while (src < end)
-            {
-                mat_vert.affineTransform(*src++, res0);
-                tmp.setSelectWithMask(mask, texIdx, res0);
-                tmp.store4a((F32*) dst);
-                dst += 4;
+            if (dst < end_f32)
+            { //pad the rest of the range with the last vertex
+                mat_vert.affineTransform(*(end-1), res0);
             }
 
             while (dst < end_f32)
@@ -2087,66 +2004,17 @@ bool LLFace::getGeometryVolume(const LLVolume& volume,
             LL_PROFILE_ZONE_NAMED_CATEGORY_FACE("getGeometryVolume - normal");
 
             mVertexBuffer->getNormalStrider(norm, mGeomIndex, mGeomCount);
-            F32* normals = (F32*) norm.get();
-            LLVector4a* src = vf.mNormals;
-            LLVector4a* end = src+num_vertices;
-
-            while (src < end)
-            {
-                LLVector4a normal;
-// <FS:Zi> GCC12 warning: maybe-uninitialized - probably bogus
-#if defined(__GNUC__) && (__GNUC__ >= 12)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
-#endif
-// </FS:Zi>
-                mat_normal.rotate(*src++, normal);
-// <FS:Zi> GCC12 warning: maybe-uninitialized - probably bogus
-#if defined(__GNUC__) && (__GNUC__ >= 12)
-#pragma GCC diagnostic pop
-#endif
-// </FS:Zi>
-                normal.store4a(normals);
-                normals += 4;
-            }
+            LLVertexTransform::rotateNormals(mat_normal, vf.mNormals, num_vertices, (LLVector4a*) norm.get());
         }
 
         if (rebuild_tangent)
         {
             LL_PROFILE_ZONE_NAMED_CATEGORY_FACE("getGeometryVolume - tangent");
             mVertexBuffer->getTangentStrider(tangent, mGeomIndex, mGeomCount);
-            F32* tangents = (F32*) tangent.get();
 
             mVObjp->getVolume()->genTangents(face_index);
 
-            LLVector4Logical mask;
-            mask.clear();
-            mask.setElement<3>();
-
-            LLVector4a* src = vf.mTangents;
-            LLVector4a* end = vf.mTangents +num_vertices;
-
-            while (src < end)
-            {
-                LLVector4a tangent_out;
-// <FS:Zi> GCC12 warning: maybe-uninitialized - probably bogus
-#if defined(__GNUC__) && (__GNUC__ >= 12)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
-#endif
-// </FS:Zi>
-                mat_normal.rotate(*src, tangent_out);
-// <FS:Zi> GCC12 warning: maybe-uninitialized - probably bogus
-#if defined(__GNUC__) && (__GNUC__ >= 12)
-#pragma GCC diagnostic pop
-#endif
-// </FS:Zi>
-                tangent_out.setSelectWithMask(mask, *src, tangent_out);
-                tangent_out.store4a(tangents);
-
-                src++;
-                tangents += 4;
-            }
+            LLVertexTransform::rotateTangents(mat_normal, vf.mTangents, num_vertices, (LLVector4a*) tangent.get());
         }
 
         if (rebuild_weights && vf.mWeights)
@@ -2248,6 +2116,47 @@ bool LLFace::getGeometryVolume(const LLVolume& volume,
     return true;
 }
 
+bool LLFace::prepareGeometryJob(S32 face_index, LLMaterialPtr& material)
+{
+    if (mVertexBuffer.isNull() || mVertexBufferGLTF.notNull() || !mVObjp || !mDrawablep)
+    {
+        return false;
+    }
+
+    LLVolume* volume = mVObjp->getVolume();
+    if (!volume || face_index < 0 || face_index >= volume->getNumVolumeFaces())
+    {
+        return false;
+    }
+
+    const LLTextureEntry* tep = mVObjp->getTE(face_index);
+    if (!tep)
+    {
+        return false;
+    }
+
+    if (tep->isSelected() && tep->getGLTFRenderMaterial())
+    { //selection highlight clones the vertex buffer
+        return false;
+    }
+
+    if (gPipeline.hasRenderDebugMask(LLPipeline::RENDER_DEBUG_OCTREE))
+    { //updateRebuildFlags() isn't thread safe
+        return false;
+    }
+
+    if (tep->getBumpmap() ||
+        tep->getTexGen() != LLTextureEntry::TEX_GEN_DEFAULT ||
+        mVertexBuffer->hasDataType(LLVertexBuffer::TYPE_TANGENT))
+    {
+        volume->genTangents(face_index);
+    }
+
+    material = tep->getMaterialParams();
+
+    return true;
+}
+
 void LLFace::renderIndexed()
 {
     if (mVertexBuffer.notNull())
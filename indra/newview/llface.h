@@ -40,6 +40,7 @@
 #include "llviewertexture.h"
 #include "lldrawable.h"
 #include "lljoint.h"
+#include "llmaterial.h"
 
 class LLFacePool;
 class LLVolume;
@@ -169,7 +170,16 @@ public:
                             U16 index_offset,
                             bool force_rebuild = false,
                             bool no_debug_assert = false,
-                            bool rebuild_for_gltf = false);
+                            bool rebuild_for_gltf = false,
+                            const LLMaterialPtr* job_material = nullptr);
+
+    // Returns true if getGeometryVolume() for this face can run on a geometry
+    // rebuild thread (it won't create, clone or free GL buffers). Generates the
+    // tangents getGeometryVolume() may need up front, since volumes are shared,
+    // and resolves the legacy material into material: the job must pass it
+    // back as job_material, copying the LLMaterialPtr of the texture entry
+    // from several threads would race on its reference count.
+    bool prepareGeometryJob(S32 face_index, LLMaterialPtr& material);
 
     // For avatar
     U16          getGeometryAvatar(
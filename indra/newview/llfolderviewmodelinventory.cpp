@@ -250,20 +250,14 @@ bool LLFolderViewModelItemInventory::filter(LLFolderViewFilter& filter)
         return true;
     }
 
-    // *TODO : Revise the logic for fast pass on less restrictive filter case
-    /*
-     const S32 sufficient_pass_generation = filter.getFirstSuccessGeneration();
-    if (getLastFilterGeneration() >= sufficient_pass_generation
-        && getLastFolderFilterGeneration() >= sufficient_pass_generation
-        && passedFilter(sufficient_pass_generation))
-    {
-        // passed an earlier filter that was a superset of the current one
-        // go ahead and flag this item as pass
-        setPassedFilter(true, filter_generation);
-        setPassedFolderFilter(true, filter_generation);
-        return true;
-    }
-     */
+    // Passed an earlier filter that was a subset of the current one, so it
+    // passes this one without checking it again. This is its own result:
+    // whether its descendants pass still has to be worked out below, some
+    // of them may have failed the earlier filter and pass this one.
+    const S32 sufficient_pass_generation = filter.getFirstSuccessGeneration();
+    const bool passed_earlier_filter = mPassedFilter
+        && sufficient_pass_generation < filter_generation
+        && getLastFilterGeneration() >= sufficient_pass_generation;
 
     bool is_folder = (getInventoryType() == LLInventoryType::IT_CATEGORY);
     const bool passed_filter_folder = is_folder ? filter.checkFolder(this) : true;
@@ -290,7 +284,7 @@ bool LLFolderViewModelItemInventory::filter(LLFolderViewFilter& filter)
     if (continue_filtering)
     {
         // This is where filter check on the item done (CHUI-849)
-        const bool passed_filter = filter.check(this);
+        const bool passed_filter = passed_earlier_filter || filter.check(this);
         if (passed_filter && mChildren.empty() && is_folder) // Update the latest filter generation for empty folders
         {
             LLFolderViewModelItemInventory* view_model = this;
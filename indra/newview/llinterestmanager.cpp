@@ -0,0 +1,269 @@
+/**
+ * @file llinterestmanager.cpp
+ * @brief Ranks inbound object updates and outbound image requests by
+ * screen space importance and defers low value work under load.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "llinterestmanager.h"
+
+#include "llappviewer.h"
+#include "llcircuit.h"
+#include "lldatapacker.h"
+#include "lldrawable.h"
+#include "llviewercontrol.h"
+#include "llviewerobject.h"
+#include "llviewerobjectlist.h"
+#include "llviewerregion.h"
+#include "llviewerstats.h"
+#include "llvocache.h"
+
+// Objects this close to the camera always get their updates right away,
+// matches LARGE_SCENE_CONTRIBUTION in LLVOCacheEntry::calcSceneContribution().
+static const F32 NEAR_SCENE_CONTRIBUTION = 1000.f;
+
+// Objects that were not drawn last frame may still come into view.
+static const F32 OFFSCREEN_INTEREST_SCALE = 0.1f;
+
+// Stay in the "under load" state this long after the last slow frame, so
+// that deferral does not flip on and off every other frame.
+static const F32 LOAD_HYSTERESIS_TIME = 1.f;
+
+// Upper bound on the number of objects with a deferred terse update.
+static const size_t MAX_DEFERRED_UPDATES = 4096;
+
+// Deferred updates are applied for at most this long per frame while under load.
+static const F64 DEFERRED_UPDATE_TIME_BUDGET = 0.001;
+
+LLInterestManager::LLInterestManager()
+:   mUnderLoad(false)
+{
+}
+
+void LLInterestManager::updateLoad(bool messages_backlogged)
+{
+    static LLCachedControl<bool> interest_management(gSavedSettings, "InterestManagement", true);
+    static LLCachedControl<F32> load_frame_time(gSavedSettings, "InterestLoadFrameTime", 0.066f);
+
+    if (!interest_management)
+    {
+        mUnderLoad = false;
+        return;
+    }
+
+    if (messages_backlogged || gFrameIntervalSeconds.value() > load_frame_time())
+    {
+        mLoadTimer.reset();
+        mUnderLoad = true;
+    }
+    else if (mUnderLoad && mLoadTimer.getElapsedTimeF32() > LOAD_HYSTERESIS_TIME)
+    {
+        mUnderLoad = false;
+    }
+}
+
+//static
+F32 LLInterestManager::getObjectInterest(const LLViewerObject* objectp)
+{
+    if (objectp->isAvatar()
+        || objectp->isSelected()
+        || objectp->getAvatar()
+        || objectp->isSeat()
+        || objectp->getRootEdit()->isSeat())
+    {
+        return F32_MAX;
+    }
+
+    LLViewerRegion* regionp = objectp->getRegion();
+    if (regionp)
+    {
+        LLVOCacheEntry* entry = regionp->getCacheEntry(objectp->getLocalID());
+        if (entry && entry->getSceneContribution() >= NEAR_SCENE_CONTRIBUTION)
+        {
+            return F32_MAX;
+        }
+    }
+
+    F32 interest = objectp->getPixelArea();
+    if (objectp->mDrawable.isNull() || !objectp->mDrawable->isVisible())
+    {
+        interest *= OFFSCREEN_INTEREST_SCALE;
+    }
+    return interest;
+}
+
+//static
+bool LLInterestManager::isNotOlder(const DeferredUpdate& update, const LLHost& host, U32 packet_id)
+{
+    if (host != update.mHost)
+    {
+        // Packet ids are per circuit and can not be compared. The object
+        // moved to another region, whose updates supersede the old one's.
+        return true;
+    }
+    // Packet ids wrap at LL_MAX_OUT_PACKET_ID, ids less than half the range
+    // ahead of the deferred one are newer.
+    const U32 ahead = (packet_id - update.mPacketID) & (LL_MAX_OUT_PACKET_ID - 1);
+    return ahead < LL_MAX_OUT_PACKET_ID / 2;
+}
+
+bool LLInterestManager::deferTerseUpdate(LLViewerObject* objectp, const U8* data, S32 size, const LLHost& host, U32 packet_id)
+{
+    static LLCachedControl<F32> defer_pixel_area(gSavedSettings, "InterestDeferPixelArea", 1024.f);
+
+    if (!mUnderLoad || size <= 0 || getObjectInterest(objectp) >= defer_pixel_area())
+    {
+        return false;
+    }
+
+    deferred_map_t::iterator iter = mDeferredUpdates.find(objectp->getID());
+    if (iter == mDeferredUpdates.end())
+    {
+        if (mDeferredUpdates.size() >= MAX_DEFERRED_UPDATES)
+        {
+            return false;
+        }
+        iter = mDeferredUpdates.emplace(objectp->getID(), DeferredUpdate()).first;
+        iter->second.mDeferTime = LLFrameTimer::getTotalSeconds();
+    }
+    else if (!isNotOlder(iter->second, host, packet_id))
+    {
+        // Out of order, the deferred update is newer.
+        add(LLStatViewer::TERSE_UPDATES_DROPPED, 1);
+        return true;
+    }
+    else
+    {
+        // Only the latest terse update matters, it carries the full motion state.
+        add(LLStatViewer::TERSE_UPDATES_DROPPED, 1);
+    }
+
+    DeferredUpdate& update = iter->second;
+    update.mObject = objectp;
+    update.mData.assign(data, data + size);
+    update.mHost = host;
+    update.mPacketID = packet_id;
+    add(LLStatViewer::TERSE_UPDATES_DEFERRED, 1);
+    return true;
+}
+
+void LLInterestManager::cancelDeferredUpdate(const LLViewerObject* objectp, const LLHost& host, U32 packet_id)
+{
+    if (mDeferredUpdates.empty())
+    {
+        return;
+    }
+
+    deferred_map_t::iterator iter = mDeferredUpdates.find(objectp->getID());
+    if (iter != mDeferredUpdates.end() && isNotOlder(iter->second, host, packet_id))
+    {
+        mDeferredUpdates.erase(iter);
+        add(LLStatViewer::TERSE_UPDATES_DROPPED, 1);
+    }
+}
+
+void LLInterestManager::processDeferredUpdates()
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_NETWORK;
+
+    if (mDeferredUpdates.empty())
+    {
+        return;
+    }
+
+    if (!mUnderLoad)
+    {
+        deferred_map_t updates;
+        updates.swap(mDeferredUpdates);
+        for (auto& [id, update] : updates)
+        {
+            applyDeferredUpdate(update);
+        }
+        return;
+    }
+
+    static LLCachedControl<F32> max_defer_time(gSavedSettings, "InterestMaxDeferTime", 1.f);
+
+    // Most important first, anything deferred for too long goes regardless.
+    const F64 now = LLFrameTimer::getTotalSeconds();
+    std::vector<std::pair<F32, LLUUID> > order;
+    order.reserve(mDeferredUpdates.size());
+    for (const auto& [id, update] : mDeferredUpdates)
+    {
+        F32 interest = update.mObject->isDead() ? 0.f : getObjectInterest(update.mObject);
+        if (now - update.mDeferTime > max_defer_time())
+        {
+            interest = F32_MAX;
+        }
+        order.emplace_back(interest, id);
+    }
+    std::sort(order.begin(), order.end(), [](const std::pair<F32, LLUUID>& lhs, const std::pair<F32, LLUUID>& rhs)
+        {
+            return lhs.first > rhs.first;
+        });
+
+    LLTimer timer;
+    for (const auto& [interest, id] : order)
+    {
+        if (interest < F32_MAX && timer.getElapsedTimeF64() > DEFERRED_UPDATE_TIME_BUDGET)
+        {
+            break;
+        }
+
+        deferred_map_t::iterator iter = mDeferredUpdates.find(id);
+        DeferredUpdate update = std::move(iter->second);
+        mDeferredUpdates.erase(iter);
+        applyDeferredUpdate(update);
+    }
+}
+
+void LLInterestManager::applyDeferredUpdate(DeferredUpdate& update)
+{
+    LLViewerObject* objectp = update.mObject;
+    if (objectp->isDead() || !objectp->getRegion())
+    {
+        return;
+    }
+
+    // Same path as an object update read back from the cache: no message
+    // system state is available any more, so no ping interpolation. Updates
+    // with a TextureEntry, which is read from the message, are never deferred.
+    LLDataPackerBinaryBuffer dp(update.mData.data(), (S32)update.mData.size());
+    gObjectList.processUpdateCore(objectp, NULL, 0, OUT_TERSE_IMPROVED, &dp, false, true);
+    objectp->setLastUpdateType(OUT_TERSE_IMPROVED);
+}
+
+void LLInterestManager::clearDeferredUpdates()
+{
+    mDeferredUpdates.clear();
+}
+
+bool LLInterestManager::shouldDeferImageRequest(F32 priority, S32 rank) const
+{
+    static LLCachedControl<F32> defer_pixel_area(gSavedSettings, "InterestDeferPixelArea", 1024.f);
+    static LLCachedControl<S32> max_requests(gSavedSettings, "InterestMaxImageRequestsUnderLoad", 100);
+
+    return mUnderLoad && (rank >= max_requests() || priority < defer_pixel_area());
+}
@@ -0,0 +1,100 @@
+/**
+ * @file llinterestmanager.h
+ * @brief Ranks inbound object updates and outbound image requests by
+ * screen space importance and defers low value work under load.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLINTERESTMANAGER_H
+#define LL_LLINTERESTMANAGER_H
+
+#include "llframetimer.h"
+#include "llhost.h"
+#include "llpointer.h"
+#include "llsingleton.h"
+#include "lluuid.h"
+
+#include <unordered_map>
+#include <vector>
+
+class LLViewerObject;
+
+// The simulator sends ImprovedTerseObjectUpdate for everything in the
+// interest list and UDP image requests go out as fast as the fetcher queues
+// them, regardless of how much either contributes to what is on screen.
+// While the viewer is falling behind (message backlog or low frame rate)
+// this defers terse updates of objects with a small projected area, keeping
+// only the latest one per object, and holds back low priority image
+// requests. Deferred work is applied from idle, most important first.
+class LLInterestManager : public LLSingleton<LLInterestManager>
+{
+    LLSINGLETON(LLInterestManager);
+    LOG_CLASS(LLInterestManager);
+
+public:
+    // Called once per frame after message processing.
+    void updateLoad(bool messages_backlogged);
+    bool isUnderLoad() const { return mUnderLoad; }
+
+    // Screen space importance of an object, in pixels. Objects which must
+    // never lag behind (avatars, attachments, selection) return F32_MAX.
+    static F32 getObjectInterest(const LLViewerObject* objectp);
+
+    // Terse updates, data is the compressed object data of the update and
+    // packet_id the id of the packet it came in on from host.
+    // deferTerseUpdate() returns false if the update should be applied right
+    // away. Only the object data is kept, so updates that also carry a
+    // TextureEntry must not be deferred.
+    bool deferTerseUpdate(LLViewerObject* objectp, const U8* data, S32 size, const LLHost& host, U32 packet_id);
+    // An update for objectp is about to be applied, drop any older deferred one.
+    void cancelDeferredUpdate(const LLViewerObject* objectp, const LLHost& host, U32 packet_id);
+    void processDeferredUpdates();
+    void clearDeferredUpdates();
+    size_t getNumDeferredUpdates() const { return mDeferredUpdates.size(); }
+
+    // Image requests, rank is the position of the request in the
+    // per host list sorted by decreasing priority.
+    bool shouldDeferImageRequest(F32 priority, S32 rank) const;
+
+private:
+    struct DeferredUpdate
+    {
+        LLPointer<LLViewerObject>   mObject;
+        std::vector<U8>             mData;
+        LLHost                      mHost;
+        U32                         mPacketID = 0;
+        F64                         mDeferTime = 0.0;
+    };
+
+    // Whether packet packet_id from host is not older than the deferred update
+    static bool isNotOlder(const DeferredUpdate& update, const LLHost& host, U32 packet_id);
+    void applyDeferredUpdate(DeferredUpdate& update);
+
+    typedef std::unordered_map<LLUUID, DeferredUpdate> deferred_map_t;
+    deferred_map_t  mDeferredUpdates;
+
+    LLFrameTimer    mLoadTimer;     // time since the last frame that was under load
+    bool            mUnderLoad;
+};
+
+#endif // LL_LLINTERESTMANAGER_H
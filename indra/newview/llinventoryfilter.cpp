@@ -34,6 +34,7 @@
 #include "llfolderviewitem.h"
 #include "llinventorymodel.h"
 #include "llinventorymodelbackgroundfetch.h"
+#include "llinventorysearchindex.h"
 #include "llinventoryfunctions.h"
 #include "llmarketplacefunctions.h"
 #include "llregex.h"
@@ -92,6 +93,7 @@ LLInventoryFilter::LLInventoryFilter(const Params& p)
     mFirstRequiredGeneration(0),
     mFirstSuccessGeneration(0),
     mSearchType(SEARCHTYPE_NAME),
+    mSearchIndexVersion(0),
     mSingleFolderMode(false)
 {
     // copy mFilterOps into mDefaultFilterOps
@@ -111,30 +113,35 @@ bool LLInventoryFilter::check(const LLFolderViewModelItem* item)
         return true;
     }
 
-    std::string desc = listener->getSearchableCreatorName();
-    switch (mSearchType)
+    bool passed = true;
+    const bool indexed = checkAgainstSearchIndex(listener, passed);
+
+    std::string desc;
+    if (!indexed)
     {
-        case SEARCHTYPE_CREATOR:
-            desc = listener->getSearchableCreatorName();
-            break;
-        case SEARCHTYPE_DESCRIPTION:
-            desc = listener->getSearchableDescription();
-            break;
-        case SEARCHTYPE_UUID:
-            desc = listener->getSearchableUUIDString();
-            break;
-        // <FS:Ansariel> Allow searching by all
-        case SEARCHTYPE_ALL:
-            desc = listener->getSearchableAll();
-            break;
-        // </FS:Ansariel>
-        case SEARCHTYPE_NAME:
-        default:
-            desc = listener->getSearchableName();
-            break;
+        switch (mSearchType)
+        {
+            case SEARCHTYPE_CREATOR:
+                desc = listener->getSearchableCreatorName();
+                break;
+            case SEARCHTYPE_DESCRIPTION:
+                desc = listener->getSearchableDescription();
+                break;
+            case SEARCHTYPE_UUID:
+                desc = listener->getSearchableUUIDString();
+                break;
+            // <FS:Ansariel> Allow searching by all
+            case SEARCHTYPE_ALL:
+                desc = listener->getSearchableAll();
+                break;
+            // </FS:Ansariel>
+            case SEARCHTYPE_NAME:
+            default:
+                desc = listener->getSearchableName();
+                break;
+        }
     }
 
-    bool passed = true;
     // <FS:Ansariel> Allow searching by all
     //if (!mExactToken.empty() && (mSearchType == SEARCHTYPE_NAME))
     if (!mExactToken.empty() && ((mSearchType == SEARCHTYPE_NAME) || (mSearchType == SEARCHTYPE_ALL)))
@@ -167,7 +174,7 @@ bool LLInventoryFilter::check(const LLFolderViewModelItem* item)
             }
         }
     }
-    else
+    else if (!indexed)
     {
         passed = checkAgainstFilterSubString(desc);
     }
@@ -322,6 +329,85 @@ bool LLInventoryFilter::checkFolder(const LLUUID& folder_id) const
     return true;
 }
 
+bool LLInventoryFilter::checkAgainstSearchIndex(const LLFolderViewModelItemInventory* listener, bool& passed)
+{
+    // Plain substring searches only, of the strings the inventory model
+    // holds. Searches for tokens or exact words are left to the strings.
+    if (mFilterSubString.empty() || !mExactToken.empty() || !mFilterTokens.empty())
+    {
+        return false;
+    }
+    const LLUUID& object_id = listener->getUUID();
+    const LLInventoryObject* obj = gInventory.getObject(object_id);
+    if (!obj)
+    {
+        // Not from the agent inventory, or not loaded yet
+        return false;
+    }
+
+    LLInventorySearchIndex& search_index = LLInventorySearchIndex::instance();
+    if (mSearchIndexVersion != search_index.getVersion())
+    {
+        mSearchIndexMatches.clear();
+        mSearchIndexNameMatches.clear();
+        bool found = true;
+        switch (mSearchType)
+        {
+            case SEARCHTYPE_NAME:
+                found = search_index.find(LLInventorySearchIndex::FIELD_NAME, mFilterSubString, mSearchIndexNameMatches);
+                break;
+            case SEARCHTYPE_CREATOR:
+                found = search_index.find(LLInventorySearchIndex::FIELD_CREATOR, mFilterSubString, mSearchIndexMatches);
+                break;
+            case SEARCHTYPE_DESCRIPTION:
+                found = search_index.find(LLInventorySearchIndex::FIELD_DESCRIPTION, mFilterSubString, mSearchIndexMatches);
+                break;
+            case SEARCHTYPE_UUID:
+                found = search_index.find(LLInventorySearchIndex::FIELD_ASSET_ID, mFilterSubString, mSearchIndexMatches);
+                break;
+            case SEARCHTYPE_ALL:
+                found = search_index.find(LLInventorySearchIndex::FIELD_NAME, mFilterSubString, mSearchIndexNameMatches)
+                    && search_index.find(LLInventorySearchIndex::FIELD_CREATOR, mFilterSubString, mSearchIndexMatches)
+                    && search_index.find(LLInventorySearchIndex::FIELD_DESCRIPTION, mFilterSubString, mSearchIndexMatches)
+                    && search_index.find(LLInventorySearchIndex::FIELD_ASSET_ID, mFilterSubString, mSearchIndexMatches);
+                break;
+            default:
+                found = false;
+                break;
+        }
+        if (!found)
+        {
+            mSearchIndexVersion = 0;
+            return false;
+        }
+        // Looked up after the finds, which build the fields they need
+        mSearchIndexVersion = search_index.getVersion();
+    }
+
+    // getSearchableAll() joins the strings with '+', which a plain
+    // substring never contains, so it matches when one of them does.
+    passed = mSearchIndexMatches.contains(object_id)
+        || ((mSearchType == SEARCHTYPE_NAME || mSearchType == SEARCHTYPE_ALL) && checkNameAgainstSearchIndex(listener, obj));
+    return true;
+}
+
+bool LLInventoryFilter::checkNameAgainstSearchIndex(const LLFolderViewModelItemInventory* listener, const LLInventoryObject* obj) const
+{
+    const std::string& display_name = listener->getDisplayName();
+    const std::string& searchable_name = listener->getSearchableName();
+    if (display_name != obj->getName())
+    {
+        // Localized system folders, the index does not know their label
+        return checkAgainstFilterSubString(searchable_name);
+    }
+    if (mSearchIndexNameMatches.contains(obj->getUUID()))
+    {
+        return true;
+    }
+    // The name does not match, only a label suffix still can
+    return searchable_name.size() != display_name.size() && checkAgainstFilterSubString(searchable_name);
+}
+
 bool LLInventoryFilter::checkAgainstFilterSubString(const std::string& desc) const
 {
     if (mFilterSubString.empty())
@@ -826,6 +912,7 @@ void LLInventoryFilter::setSearchType(ESearchType type)
     if (mSearchType != type)
     {
         mSearchType = type;
+        mSearchIndexVersion = 0;
         setModified();
     }
 }
@@ -1093,6 +1180,7 @@ void LLInventoryFilter::setFilterSubString(const std::string& string)
             && !filter_sub_string_new.substr(0, mFilterSubString.size()).compare(mFilterSubString);
 
         mFilterSubString = filter_sub_string_new;
+        mSearchIndexVersion = 0;
         if (exact_token_changed)
         {
             setModified(FILTER_RESTART);
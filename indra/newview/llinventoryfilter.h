@@ -30,6 +30,7 @@
 #include "llinventorytype.h"
 #include "llpermissionsflags.h"
 #include "llfolderviewmodel.h"
+#include "lltrigramindex.h"
 
 class LLFolderViewItem;
 class LLFolderViewFolder;
@@ -373,6 +374,12 @@ private:
     bool                checkAgainstCreator(const class LLFolderViewModelItemInventory* listener) const;
     bool                checkAgainstSearchVisibility(const class LLFolderViewModelItemInventory* listener) const;
     bool                checkAgainstClipboard(const LLUUID& object_id) const;
+    // Answers the substring part of check() from the inventory search index
+    // when it can, returning false when the strings have to be searched.
+    bool                checkAgainstSearchIndex(const class LLFolderViewModelItemInventory* listener, bool& passed);
+    // Whether the searchable name of listener contains the filter substring,
+    // from the name hits of the search index where they stand for it.
+    bool                checkNameAgainstSearchIndex(const class LLFolderViewModelItemInventory* listener, const class LLInventoryObject* obj) const;
 
     FilterOps               mFilterOps;
     FilterOps               mDefaultFilterOps;
@@ -403,6 +410,13 @@ private:
     std::vector<std::string> mFilterTokens;
     std::string              mExactToken;
 
+    // Objects whose searched strings other than the name, and objects whose
+    // model name, contain mFilterSubString, as of version
+    // mSearchIndexVersion of the search index, 0 if not looked up
+    LLTrigramIndex::id_set_t mSearchIndexMatches;
+    LLTrigramIndex::id_set_t mSearchIndexNameMatches;
+    U32                      mSearchIndexVersion;
+
     bool mSingleFolderMode;
 };
 
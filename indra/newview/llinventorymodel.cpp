@@ -30,6 +30,7 @@
 #include <random>
 
 #include "llinventorymodel.h"
+#include "llinventorycache.h"
 
 #include "llaisapi.h"
 #include "llagent.h"
@@ -66,6 +67,7 @@
 #include "bufferstream.h"
 #include "llcorehttputil.h"
 #include "hbxxh.h"
+#include "parallelfor.h"
 #include "llstartup.h"
 // [RLVa:KB] - Checked: 2011-05-22 (RLVa-1.3.1a)
 #include "rlvhandler.h"
@@ -106,6 +108,12 @@ S32 LLInventoryModel::sPendingSystemFolders = 0;
 //bool decompress_file(const char* src_filename, const char* dst_filename);
 static const char PRODUCTION_CACHE_FORMAT_STRING[] = "%s.inv.llsd";
 static const char GRID_CACHE_FORMAT_STRING[] = "%s.%s.inv.llsd";
+static const char PRODUCTION_BINARY_CACHE_FORMAT_STRING[] = "%s.inv.bin";
+static const char GRID_BINARY_CACHE_FORMAT_STRING[] = "%s.%s.inv.bin";
+// Lines of the notation cache parsed per task, and items of the binary
+// cache turned into viewer items per task
+static const size_t INV_CACHE_LINES_PER_CHUNK = 2048;
+static const size_t INV_CACHE_ITEMS_PER_CHUNK = 4096;
 static const char * const LOG_INV("Inventory");
 
 struct InventoryIDPtrLess
@@ -454,8 +462,7 @@ LLInventoryModel::LLInventoryModel()
     mLibraryOwnerID(),
     mCategoryMap(),
     mItemMap(),
-    mParentChildCategoryTree(),
-    mParentChildItemTree(),
+    mParentChildTree(),
     mLastItem(NULL),
     mIsNotifyObservers(false),
     mModifyMask(LLInventoryObserver::ALL),
@@ -489,6 +496,7 @@ LLInventoryModel::~LLInventoryModel()
 
 void LLInventoryModel::cleanupInventory()
 {
+    logObserverStats();
     empty();
     // Deleting one observer might erase others from the list, so always pop off the front
     while (!mObservers.empty())
@@ -700,10 +708,9 @@ LLViewerInventoryItem* LLInventoryModel::getItem(const LLUUID& id) const
     }
     else
     {
-        item_map_t::const_iterator iter = mItemMap.find(id);
-        if (iter != mItemMap.end())
+        item = mItemMap.find(id);
+        if (item)
         {
-            item = iter->second;
             mLastItem = item;
         }
     }
@@ -713,13 +720,27 @@ LLViewerInventoryItem* LLInventoryModel::getItem(const LLUUID& id) const
 // Get the category by id. Returns NULL if not found
 LLViewerInventoryCategory* LLInventoryModel::getCategory(const LLUUID& id) const
 {
-    LLViewerInventoryCategory* category = NULL;
-    cat_map_t::const_iterator iter = mCategoryMap.find(id);
-    if (iter != mCategoryMap.end())
-    {
-        category = iter->second;
-    }
-    return category;
+    return mCategoryMap.find(id);
+}
+
+LLInventoryHandle LLInventoryModel::getItemHandle(const LLUUID& id) const
+{
+    return mItemMap.getHandle(id);
+}
+
+LLViewerInventoryItem* LLInventoryModel::getItem(const LLInventoryHandle& handle) const
+{
+    return mItemMap.get(handle);
+}
+
+LLInventoryHandle LLInventoryModel::getCategoryHandle(const LLUUID& id) const
+{
+    return mCategoryMap.getHandle(id);
+}
+
+LLViewerInventoryCategory* LLInventoryModel::getCategory(const LLInventoryHandle& handle) const
+{
+    return mCategoryMap.get(handle);
 }
 
 S32 LLInventoryModel::getItemCount() const
@@ -741,13 +762,25 @@ void LLInventoryModel::getDirectDescendentsOf(const LLUUID& cat_id,
                                               cat_array_t*& categories,
                                               item_array_t*& items) const
 {
-    categories = get_ptr_in_map(mParentChildCategoryTree, cat_id);
-    items = get_ptr_in_map(mParentChildItemTree, cat_id);
+    parent_child_map_t::const_iterator found = mParentChildTree.find(cat_id);
+    if (found != mParentChildTree.end())
+    {
+        categories = found->second.mCategories;
+        items = found->second.mItems;
+    }
+    else
+    {
+        categories = NULL;
+        items = NULL;
+    }
 }
 
 void LLInventoryModel::getDirectDescendentsOf(const LLUUID& cat_id, cat_array_t& categories, item_array_t& items, LLInventoryCollectFunctor& f) const
 {
-    if (cat_array_t* categoriesp = get_ptr_in_map(mParentChildCategoryTree, cat_id))
+    cat_array_t* categoriesp;
+    item_array_t* itemsp;
+    getDirectDescendentsOf(cat_id, categoriesp, itemsp);
+    if (categoriesp)
     {
         for (LLViewerInventoryCategory* pFolder : *categoriesp)
         {
@@ -758,7 +791,7 @@ void LLInventoryModel::getDirectDescendentsOf(const LLUUID& cat_id, cat_array_t&
         }
     }
 
-    if (item_array_t* itemsp = get_ptr_in_map(mParentChildItemTree, cat_id))
+    if (itemsp)
     {
         for (LLViewerInventoryItem* pItem : *itemsp)
         {
@@ -819,9 +852,8 @@ void LLInventoryModel::consolidateForType(const LLUUID& main_id, LLFolderType::E
 {
     // Make a list of folders that are not "main_id" and are of "type"
     std::vector<LLUUID> folder_ids;
-    for (cat_map_t::iterator cit = mCategoryMap.begin(); cit != mCategoryMap.end(); ++cit)
+    for (LLViewerInventoryCategory* cat : mCategoryMap)
     {
-        LLViewerInventoryCategory* cat = cit->second;
         if ((cat->getPreferredType() == type) && (cat->getUUID() != main_id))
         {
             folder_ids.push_back(cat->getUUID());
@@ -890,7 +922,7 @@ void LLInventoryModel::ensureCategoryForTypeExists(LLFolderType::EType preferred
     }
     else if (root_id.notNull())
     {
-        cat_array_t* cats = get_ptr_in_map(mParentChildCategoryTree, root_id);
+        cat_array_t* cats = getCatArray(root_id);
         if (cats)
         {
             for (auto& p_cat : *cats)
@@ -956,7 +988,7 @@ const LLUUID LLInventoryModel::findCategoryUUIDForTypeInRoot(
     }
     else if (root_id.notNull())
     {
-        cat_array_t* cats = get_ptr_in_map(mParentChildCategoryTree, root_id);
+        cat_array_t* cats = getCatArray(root_id);
         if(cats)
         {
             for (auto& p_cat : *cats)
@@ -1047,7 +1079,7 @@ LLUUID LLInventoryModel::findCategoryByName(std::string_view name)
 {
     if (LLUUID root_id = gInventory.getRootFolderID(); root_id.notNull())
     {
-        if (auto cats = get_ptr_in_map(mParentChildCategoryTree, root_id); cats)
+        if (auto cats = getCatArray(root_id); cats)
         {
             for (const auto& cat : *cats)
             {
@@ -1371,7 +1403,9 @@ void LLInventoryModel::collectDescendentsIf(const LLUUID& id,
         if(trash_id.notNull() && (trash_id == id))
             return;
     }
-    cat_array_t* cat_array = get_ptr_in_map(mParentChildCategoryTree, id);
+    cat_array_t* cat_array;
+    item_array_t* item_array;
+    getDirectDescendentsOf(id, cat_array, item_array);
     if(cat_array)
     {
         for (auto& cat : *cat_array)
@@ -1387,8 +1421,6 @@ void LLInventoryModel::collectDescendentsIf(const LLUUID& id,
         }
     }
 
-    item_array_t* item_array = get_ptr_in_map(mParentChildItemTree, id);
-
     // Move onto items
     if(item_array)
     {
@@ -1448,7 +1480,9 @@ bool LLInventoryModel::hasMatchingDescendents(const LLUUID& id,
         if (trash_id.notNull() && (trash_id == id))
             return false;
     }
-    cat_array_t* cat_array = get_ptr_in_map(mParentChildCategoryTree, id);
+    cat_array_t* cat_array;
+    item_array_t* item_array;
+    getDirectDescendentsOf(id, cat_array, item_array);
     if (cat_array)
     {
         for (auto& cat : *cat_array)
@@ -1464,8 +1498,6 @@ bool LLInventoryModel::hasMatchingDescendents(const LLUUID& id,
         }
     }
 
-    item_array_t* item_array = get_ptr_in_map(mParentChildItemTree, id);
-
     if (item_array)
     {
         for (auto& item : *item_array)
@@ -1625,12 +1657,12 @@ U32 LLInventoryModel::updateItem(const LLViewerInventoryItem* item, U32 mask)
         {
             // need to update the parent-child tree
             item_array_t* item_array;
-            item_array = get_ptr_in_map(mParentChildItemTree, old_parent_id);
+            item_array = getItemArray(old_parent_id);
             if(item_array)
             {
                 vector_replace_with_last(*item_array, old_item);
             }
-            item_array = get_ptr_in_map(mParentChildItemTree, new_parent_id);
+            item_array = getItemArray(new_parent_id);
             if(item_array)
             {
                 if (update_parent_on_server)
@@ -1669,7 +1701,7 @@ U32 LLInventoryModel::updateItem(const LLViewerInventoryItem* item, U32 mask)
         {
             const LLUUID category_id = findCategoryUUIDForType(LLFolderType::assetTypeToFolderType(new_item->getType()));
             new_item->setParent(category_id);
-            item_array_t* item_array = get_ptr_in_map(mParentChildItemTree, category_id);
+            item_array_t* item_array = getItemArray(category_id);
             if( item_array )
             {
                 LLInventoryModel::LLCategoryUpdate update(category_id, 1);
@@ -1702,7 +1734,7 @@ U32 LLInventoryModel::updateItem(const LLViewerInventoryItem* item, U32 mask)
                 accountForUpdate(update);
 
             }
-            item_array_t* item_array = get_ptr_in_map(mParentChildItemTree, parent_id);
+            item_array_t* item_array = getItemArray(parent_id);
             if(item_array)
             {
                 item_array->push_back(new_item);
@@ -1714,7 +1746,7 @@ U32 LLInventoryModel::updateItem(const LLViewerInventoryItem* item, U32 mask)
                                   << new_item->getName() << LL_ENDL;
                 parent_id = findCategoryUUIDForType(LLFolderType::FT_LOST_AND_FOUND);
                 new_item->setParent(parent_id);
-                item_array = get_ptr_in_map(mParentChildItemTree, parent_id);
+                item_array = getItemArray(parent_id);
                 if(item_array)
                 {
                     LLInventoryModel::LLCategoryUpdate update(parent_id, 1);
@@ -1769,9 +1801,21 @@ U32 LLInventoryModel::updateItem(const LLViewerInventoryItem* item, U32 mask)
     return mask;
 }
 
+LLInventoryModel::cat_array_t* LLInventoryModel::getCatArray(const LLUUID& id) const
+{
+    parent_child_map_t::const_iterator found = mParentChildTree.find(id);
+    return found == mParentChildTree.end() ? NULL : found->second.mCategories;
+}
+
+LLInventoryModel::item_array_t* LLInventoryModel::getItemArray(const LLUUID& id) const
+{
+    parent_child_map_t::const_iterator found = mParentChildTree.find(id);
+    return found == mParentChildTree.end() ? NULL : found->second.mItems;
+}
+
 LLInventoryModel::cat_array_t* LLInventoryModel::getUnlockedCatArray(const LLUUID& id)
 {
-    cat_array_t* cat_array = get_ptr_in_map(mParentChildCategoryTree, id);
+    cat_array_t* cat_array = getCatArray(id);
     if (cat_array)
     {
         llassert_always(!mCategoryLock[id]);
@@ -1782,7 +1826,7 @@ LLInventoryModel::cat_array_t* LLInventoryModel::getUnlockedCatArray(const LLUUI
 
 LLInventoryModel::item_array_t* LLInventoryModel::getUnlockedItemArray(const LLUUID& id)
 {
-    item_array_t* item_array = get_ptr_in_map(mParentChildItemTree, id);
+    item_array_t* item_array = getItemArray(id);
     if (item_array)
     {
         llassert_always(!mItemLock[id]);
@@ -1859,10 +1903,9 @@ void LLInventoryModel::updateCategory(const LLViewerInventoryCategory* cat, U32
         // make space in the tree for this category's children.
         llassert_always(!mCategoryLock[new_cat->getUUID()]);
         llassert_always(!mItemLock[new_cat->getUUID()]);
-        cat_array_t* catsp = new cat_array_t;
-        item_array_t* itemsp = new item_array_t;
-        mParentChildCategoryTree[new_cat->getUUID()] = catsp;
-        mParentChildItemTree[new_cat->getUUID()] = itemsp;
+        LLChildArrays& children = mParentChildTree[new_cat->getUUID()];
+        children.mCategories = new cat_array_t;
+        children.mItems = new item_array_t;
         mask |= LLInventoryObserver::ADD;
         addChangedMask(mask, cat->getUUID());
     }
@@ -1877,7 +1920,7 @@ void LLInventoryModel::moveObject(const LLUUID& object_id, const LLUUID& cat_id)
         return;
     }
 
-    if((object_id == cat_id) || !is_in_map(mCategoryMap, cat_id))
+    if((object_id == cat_id) || !mCategoryMap.contains(cat_id))
     {
         LL_WARNS(LOG_INV) << "Could not move inventory object " << object_id << " to "
                           << cat_id << LL_ENDL;
@@ -2245,7 +2288,6 @@ void LLInventoryModel::deleteObject(const LLUUID& id, bool fix_broken_links, boo
             LL_WARNS(LOG_INV) << "Deleting cat " << id << " while it still has child items" << LL_ENDL;
         }
         delete item_list;
-        mParentChildItemTree.erase(id);
     }
     cat_list = getUnlockedCatArray(id);
     if(cat_list)
@@ -2255,8 +2297,8 @@ void LLInventoryModel::deleteObject(const LLUUID& id, bool fix_broken_links, boo
             LL_WARNS(LOG_INV) << "Deleting cat " << id << " while it still has child cats" << LL_ENDL;
         }
         delete cat_list;
-        mParentChildCategoryTree.erase(id);
     }
+    mParentChildTree.erase(id);
     addChangedMask(LLInventoryObserver::REMOVE, id);
 
     bool is_link_type = obj->getIsLinkType();
@@ -2366,7 +2408,21 @@ void LLInventoryModel::notifyObservers(const LLUUID& transaction_id)
          iter != mObservers.end(); )
     {
         LLInventoryObserver* observer = *iter;
-        observer->changed(mModifyMask);
+        // Looked up first, changed() may delete the observer
+        ObserverStats& stats = mObserverStats[std::type_index(typeid(*observer))];
+        // A notification without flags is a poll, polling observers such as
+        // the fetch observers check their progress on it
+        if (mModifyMask == LLInventoryObserver::NONE || (mModifyMask & observer->getInterestMask()))
+        {
+            const F64 start_time = LLTimer::getTotalSeconds();
+            observer->changed(mModifyMask);
+            stats.mSeconds += LLTimer::getTotalSeconds() - start_time;
+            ++stats.mCalls;
+        }
+        else
+        {
+            ++stats.mSkipped;
+        }
 
         // safe way to increment since changed may delete entries! (@!##%@!@&*!)
         iter = mObservers.upper_bound(observer);
@@ -2379,10 +2435,12 @@ void LLInventoryModel::notifyObservers(const LLUUID& transaction_id)
     mChangedItemIDs.insert(mChangedItemIDsBacklog.begin(), mChangedItemIDsBacklog.end());
     mAddedItemIDs.clear();
     mAddedItemIDs.insert(mAddedItemIDsBacklog.begin(), mAddedItemIDsBacklog.end());
+    mChangedMasks.swap(mChangedMasksBacklog);
 
     mModifyMaskBacklog = LLInventoryObserver::NONE;
     mChangedItemIDsBacklog.clear();
     mAddedItemIDsBacklog.clear();
+    mChangedMasksBacklog.clear();
 
 // [SL:KB] - Patch: UI-Notifications | Checked: Catznip-6.5
     mTransactionId.setNull();
@@ -2390,6 +2448,30 @@ void LLInventoryModel::notifyObservers(const LLUUID& transaction_id)
     mIsNotifyObservers = false;
 }
 
+U32 LLInventoryModel::getChangedMask(const LLUUID& id) const
+{
+    auto found = mChangedMasks.find(id);
+    return found != mChangedMasks.end() ? found->second : LLInventoryObserver::NONE;
+}
+
+void LLInventoryModel::logObserverStats() const
+{
+    std::vector<std::pair<F64, std::string> > observers;
+    observers.reserve(mObserverStats.size());
+    for (const auto& stats : mObserverStats)
+    {
+        observers.emplace_back(stats.second.mSeconds,
+                               llformat("%s: %u calls, %u skipped, %.3fs",
+                                        LLError::Log::demangle(stats.first.name()).c_str(),
+                                        stats.second.mCalls, stats.second.mSkipped, stats.second.mSeconds));
+    }
+    std::sort(observers.begin(), observers.end(), std::greater<>());
+    for (const auto& observer : observers)
+    {
+        LL_INFOS(LOG_INV) << "Inventory observer " << observer.second << LL_ENDL;
+    }
+}
+
 // store flag for change
 // and id of object change applies to
 void LLInventoryModel::addChangedMask(U32 mask, const LLUUID& referent)
@@ -2429,14 +2511,11 @@ void LLInventoryModel::addChangedMask(U32 mask, const LLUUID& referent)
     bool needs_update = false;
     if (referent.notNull())
     {
-        if (mIsNotifyObservers)
-        {
-            needs_update = mChangedItemIDsBacklog.find(referent) == mChangedItemIDsBacklog.end();
-        }
-        else
-        {
-            needs_update = mChangedItemIDs.find(referent) == mChangedItemIDs.end();
-        }
+        // Every change is kept per object, the first one also updates the
+        // changed ids and what depends on them
+        auto inserted = (mIsNotifyObservers ? mChangedMasksBacklog : mChangedMasks).try_emplace(referent, 0);
+        inserted.first->second |= mask;
+        needs_update = inserted.second;
     }
 
     if (needs_update)
@@ -2494,8 +2573,8 @@ bool LLInventoryModel::fetchDescendentsOf(const LLUUID& folder_id) const
         return false;
     }
     //S32 known_descendents = 0;
-    ///cat_array_t* categories = get_ptr_in_map(mParentChildCategoryTree, folder_id);
-    //item_array_t* items = get_ptr_in_map(mParentChildItemTree, folder_id);
+    ///cat_array_t* categories = getCatArray(folder_id);
+    //item_array_t* items = getItemArray(folder_id);
     //if(categories)
     //{
     //  known_descendents += categories->size();
@@ -2507,8 +2586,7 @@ bool LLInventoryModel::fetchDescendentsOf(const LLUUID& folder_id) const
     return cat->fetch();
 }
 
-//static
-std::string LLInventoryModel::getInvCacheAddres(const LLUUID& owner_id)
+static std::string inv_cache_address(const LLUUID& owner_id, const char* production_format, const char* grid_format)
 {
     std::string inventory_addr;
     std::string owner_id_str;
@@ -2519,7 +2597,7 @@ std::string LLInventoryModel::getInvCacheAddres(const LLUUID& owner_id)
     if (LLGridManager::getInstance()->isInSLMain())
     // </FS:Ansariel>
     {
-        inventory_addr = llformat(PRODUCTION_CACHE_FORMAT_STRING, path.c_str());
+        inventory_addr = llformat(production_format, path.c_str());
     }
     else
     {
@@ -2531,11 +2609,23 @@ std::string LLInventoryModel::getInvCacheAddres(const LLUUID& owner_id)
         const std::string grid_id_str = LLDir::getScrubbedFileName(LLGridManager::getInstance()->getGridId());
         // </FS:Ansariel>
         const std::string& grid_id_lower = utf8str_tolower(grid_id_str);
-        inventory_addr = llformat(GRID_CACHE_FORMAT_STRING, path.c_str(), grid_id_lower.c_str());
+        inventory_addr = llformat(grid_format, path.c_str(), grid_id_lower.c_str());
     }
     return inventory_addr;
 }
 
+//static
+std::string LLInventoryModel::getInvCacheAddres(const LLUUID& owner_id)
+{
+    return inv_cache_address(owner_id, PRODUCTION_CACHE_FORMAT_STRING, GRID_CACHE_FORMAT_STRING);
+}
+
+//static
+std::string LLInventoryModel::getInvBinaryCacheAddres(const LLUUID& owner_id)
+{
+    return inv_cache_address(owner_id, PRODUCTION_BINARY_CACHE_FORMAT_STRING, GRID_BINARY_CACHE_FORMAT_STRING);
+}
+
 void LLInventoryModel::cache(
     const LLUUID& parent_folder_id,
     const LLUUID& agent_id)
@@ -2556,20 +2646,16 @@ void LLInventoryModel::cache(
         items,
         INCLUDE_TRASH,
         can_cache);
-    // Use temporary file to avoid potential conflicts with other
-    // instances (even a 'read only' instance unzips into a file)
-    std::string temp_file = gDirUtilp->getTempFilename();
-    saveToFile(temp_file, categories, items);
-    std::string gzip_filename = getInvCacheAddres(agent_id);
-    gzip_filename.append(".gz");
-    if(gzip_file(temp_file, gzip_filename))
-    {
-        LL_DEBUGS(LOG_INV) << "Successfully compressed " << temp_file << " to " << gzip_filename << LL_ENDL;
-        LLFile::remove(temp_file);
-    }
-    else
+    if (saveToBinaryFile(getInvBinaryCacheAddres(agent_id), categories, items))
     {
-        LL_WARNS(LOG_INV) << "Unable to compress " << temp_file << " into " << gzip_filename << LL_ENDL;
+        // Migrated, the notation cache would only be read if the binary
+        // one went missing and is older than it anyway
+        std::string gzip_filename = getInvCacheAddres(agent_id);
+        gzip_filename.append(".gz");
+        if (LLFile::isfile(gzip_filename))
+        {
+            LLFile::remove(gzip_filename);
+        }
     }
 }
 
@@ -2589,7 +2675,7 @@ void LLInventoryModel::addCategory(LLViewerInventoryCategory* category)
         category->localizeName();
 
         // Insert category uniquely into the map
-        mCategoryMap[category->getUUID()] = category; // LLPointer will deref and delete the old one
+        mCategoryMap.insert(category->getUUID(), category); // LLPointer will deref and delete the old one
         //mInventory[category->getUUID()] = category;
     }
 }
@@ -2722,7 +2808,7 @@ void LLInventoryModel::addItem(LLViewerInventoryItem* item)
             const LLUUID& target_id = item->getLinkedUUID();
             addBacklinkInfo(link_id, target_id);
         }
-        mItemMap[item->getUUID()] = item;
+        mItemMap.insert(item->getUUID(), item);
     }
 }
 
@@ -2730,16 +2816,12 @@ void LLInventoryModel::addItem(LLViewerInventoryItem* item)
 void LLInventoryModel::empty()
 {
 //  LL_INFOS(LOG_INV) << "LLInventoryModel::empty()" << LL_ENDL;
-    std::for_each(
-        mParentChildCategoryTree.begin(),
-        mParentChildCategoryTree.end(),
-        DeletePairedPointer());
-    mParentChildCategoryTree.clear();
-    std::for_each(
-        mParentChildItemTree.begin(),
-        mParentChildItemTree.end(),
-        DeletePairedPointer());
-    mParentChildItemTree.clear();
+    for (parent_child_map_t::value_type& entry : mParentChildTree)
+    {
+        delete entry.second.mCategories;
+        delete entry.second.mItems;
+    }
+    mParentChildTree.clear();
     mBacklinkMMap.clear(); // forget all backlink information.
     mCategoryMap.clear(); // remove all references (should delete entries)
     mItemMap.clear(); // remove all references (should delete entries)
@@ -2836,13 +2918,10 @@ LLInventoryModel::EHasChildren LLInventoryModel::categoryHasChildren(
     }
 
     // Shouldn't have to run this, but who knows.
-    parent_cat_map_t::const_iterator cat_it = mParentChildCategoryTree.find(cat->getUUID());
-    if (cat_it != mParentChildCategoryTree.end() && cat_it->second->size() > 0)
-    {
-        return CHILDREN_YES;
-    }
-    parent_item_map_t::const_iterator item_it = mParentChildItemTree.find(cat->getUUID());
-    if (item_it != mParentChildItemTree.end() && item_it->second->size() > 0)
+    cat_array_t* cat_array;
+    item_array_t* item_array;
+    getDirectDescendentsOf(cat->getUUID(), cat_array, item_array);
+    if ((cat_array && cat_array->size() > 0) || (item_array && item_array->size() > 0))
     {
         return CHILDREN_YES;
     }
@@ -2893,6 +2972,13 @@ bool LLInventoryModel::loadSkeleton(
             LLFile::remove(inventory_filename);
         }
 
+        inventory_filename = getInvBinaryCacheAddres(owner_id);
+        if (LLFile::isfile(inventory_filename))
+        {
+            LL_INFOS("LLInventoryModel") << "Purging inventory cache file: " << inventory_filename << LL_ENDL;
+            LLFile::remove(inventory_filename);
+        }
+
         // also delete library cache if inventory cache is purged, so issues with EEP settings going missing
         // and bridge objects not being found can be resolved
         // <FS:Beq> correct OS library owner.
@@ -2912,6 +2998,13 @@ bool LLInventoryModel::loadSkeleton(
             LLFile::remove(inventory_filename);
         }
 
+        inventory_filename = getInvBinaryCacheAddres(gInventory.getLibraryOwnerID());
+        if (LLFile::isfile(inventory_filename))
+        {
+            LL_INFOS("LLInventoryModel") << "Purging library cache file: " << inventory_filename << LL_ENDL;
+            LLFile::remove(inventory_filename);
+        }
+
         LL_INFOS("LLInventoryModel") << "Clear inventory cache marker removed: " << delete_cache_marker << LL_ENDL;
         LLFile::remove(delete_cache_marker);
     }
@@ -2973,37 +3066,50 @@ bool LLInventoryModel::loadSkeleton(
         const S32 NO_VERSION = LLViewerInventoryCategory::VERSION_UNKNOWN;
         std::string gzip_filename(inventory_filename);
         gzip_filename.append(".gz");
-        LLFILE* fp = LLFile::fopen(gzip_filename, "rb");
+        const std::string binary_filename = getInvBinaryCacheAddres(owner_id);
+        const bool has_binary_cache = LLFile::isfile(binary_filename);
         bool remove_inventory_file = false;
-        if (LLAppViewer::instance()->isSecondInstance())
+        bool is_cache_obsolete = false;
+        bool loaded = false;
+        if (has_binary_cache)
         {
-            // Safeguard viewer against trying to unpack file twice
-            // ex: user logs into two accounts simultaneously, so two
-            // viewers are trying to unpack library into same file
-            //
-            // Would be better to do it in gunzip_file, but it doesn't
-            // have access to llfilesystem
-            inventory_filename = gDirUtilp->getTempFilename();
-            remove_inventory_file = true;
+            // Mapped read only, a second instance can share it
+            loaded = loadFromBinaryFile(binary_filename, categories, items, categories_to_update, is_cache_obsolete);
         }
-        if(fp)
+        else
         {
-            fclose(fp);
-            fp = NULL;
-            if(gunzip_file(gzip_filename, inventory_filename))
+            // Not migrated yet, the next cache() writes the binary cache
+            LLFILE* fp = LLFile::fopen(gzip_filename, "rb");
+            if (LLAppViewer::instance()->isSecondInstance())
             {
-                // we only want to remove the inventory file if it was
-                // gzipped before we loaded, and we successfully
-                // gunziped it.
+                // Safeguard viewer against trying to unpack file twice
+                // ex: user logs into two accounts simultaneously, so two
+                // viewers are trying to unpack library into same file
+                //
+                // Would be better to do it in gunzip_file, but it doesn't
+                // have access to llfilesystem
+                inventory_filename = gDirUtilp->getTempFilename();
                 remove_inventory_file = true;
             }
-            else
+            if(fp)
             {
-                LL_INFOS(LOG_INV) << "Unable to gunzip " << gzip_filename << LL_ENDL;
+                fclose(fp);
+                fp = NULL;
+                if(gunzip_file(gzip_filename, inventory_filename))
+                {
+                    // we only want to remove the inventory file if it was
+                    // gzipped before we loaded, and we successfully
+                    // gunziped it.
+                    remove_inventory_file = true;
+                }
+                else
+                {
+                    LL_INFOS(LOG_INV) << "Unable to gunzip " << gzip_filename << LL_ENDL;
+                }
             }
+            loaded = loadFromFile(inventory_filename, categories, items, categories_to_update, is_cache_obsolete);
         }
-        bool is_cache_obsolete = false;
-        if (loadFromFile(inventory_filename, categories, items, categories_to_update, is_cache_obsolete))
+        if (loaded)
         {
             // We were able to find a cache of files. So, use what we
             // found to generate a set of categories we should add. We
@@ -3071,17 +3177,15 @@ bool LLInventoryModel::loadSkeleton(
             S32 bad_link_count = 0;
             S32 good_link_count = 0;
             S32 recovered_link_count = 0;
-            cat_map_t::iterator unparented = mCategoryMap.end();
             for(item_array_t::const_iterator item_iter = items.begin();
                 item_iter != items.end();
                 ++item_iter)
             {
                 LLViewerInventoryItem *item = (*item_iter).get();
-                const cat_map_t::iterator cit = mCategoryMap.find(item->getParentUUID());
+                const LLViewerInventoryCategory* cat = mCategoryMap.find(item->getParentUUID());
 
-                if(cit != unparented)
+                if(cat)
                 {
-                    const LLViewerInventoryCategory* cat = cit->second.get();
                     if(cat->getVersion() != NO_VERSION)
                     {
                         // This can happen if the linked object's baseobj is removed from the cache but the linked object is still in the cache.
@@ -3112,12 +3216,11 @@ bool LLInventoryModel::loadSkeleton(
                     ++item_iter)
                 {
                     LLViewerInventoryItem *item = (*item_iter).get();
-                    const cat_map_t::iterator cit = mCategoryMap.find(item->getParentUUID());
-                    const LLViewerInventoryCategory* cat = cit->second.get();
+                    LLViewerInventoryCategory* cat = mCategoryMap.find(item->getParentUUID());
                     if (item->getIsBrokenLink())
                     {
                         bad_link_count++;
-                        invalid_categories.insert(cit->second);
+                        invalid_categories.insert(cat);
                         //LL_INFOS(LOG_INV) << "link still broken: " << item->getName() << " in folder " << cat->getName() << LL_ENDL;
                     }
                     else
@@ -3196,7 +3299,7 @@ bool LLInventoryModel::loadSkeleton(
         {
             // If out of date, remove the gzipped file too.
             LL_WARNS(LOG_INV) << "Inv cache out of date, removing" << LL_ENDL;
-            LLFile::remove(gzip_filename);
+            LLFile::remove(has_binary_cache ? binary_filename : gzip_filename);
         }
         categories.clear(); // will unref and delete entries
     }
@@ -3227,32 +3330,60 @@ void LLInventoryModel::buildParentChildMap()
     cat_array_t* catsp;
     item_array_t* itemsp;
 
-    for(cat_map_t::iterator cit = mCategoryMap.begin(); cit != mCategoryMap.end(); ++cit)
+    // Children are filed through hash maps of the unlocked arrays of their
+    // parents, so every parent is looked up and checked for a lock once
+    // instead of once per child. Parents that are not categories map to
+    // null.
+    std::unordered_map<LLUUID, cat_array_t*> cat_arrays;
+    std::unordered_map<LLUUID, item_array_t*> item_arrays;
+    cat_arrays.reserve(mCategoryMap.size() + 1);
+    item_arrays.reserve(mCategoryMap.size() + 1);
+
+    cats.reserve(mCategoryMap.size());
+    mParentChildTree.reserve(mCategoryMap.size() + 1);
+    for (LLViewerInventoryCategory* cat : mCategoryMap)
     {
-        LLViewerInventoryCategory* cat = cit->second;
         cats.push_back(cat);
-        if (mParentChildCategoryTree.count(cat->getUUID()) == 0)
+        LLChildArrays& children = mParentChildTree[cat->getUUID()];
+        if (!children.mCategories)
         {
             llassert_always(!mCategoryLock[cat->getUUID()]);
-            catsp = new cat_array_t;
-            mParentChildCategoryTree[cat->getUUID()] = catsp;
+            children.mCategories = new cat_array_t;
         }
-        if (mParentChildItemTree.count(cat->getUUID()) == 0)
+        if (!children.mItems)
         {
             llassert_always(!mItemLock[cat->getUUID()]);
-            itemsp = new item_array_t;
-            mParentChildItemTree[cat->getUUID()] = itemsp;
+            children.mItems = new item_array_t;
         }
     }
 
+    auto unlocked_cat_array = [this, &cat_arrays](const LLUUID& id)
+    {
+        auto found = cat_arrays.find(id);
+        if (found == cat_arrays.end())
+        {
+            found = cat_arrays.emplace(id, getUnlockedCatArray(id)).first;
+        }
+        return found->second;
+    };
+    auto unlocked_item_array = [this, &item_arrays](const LLUUID& id)
+    {
+        auto found = item_arrays.find(id);
+        if (found == item_arrays.end())
+        {
+            found = item_arrays.emplace(id, getUnlockedItemArray(id)).first;
+        }
+        return found->second;
+    };
+
     // Insert a special parent for the root - so that lookups on
     // LLUUID::null as the parent work correctly. This is kind of a
     // blatent wastes of space since we allocate a block of memory for
     // the array, but whatever - it's not that much space.
-    if (mParentChildCategoryTree.count(LLUUID::null) == 0)
+    LLChildArrays& root_children = mParentChildTree[LLUUID::null];
+    if (!root_children.mCategories)
     {
-        catsp = new cat_array_t;
-        mParentChildCategoryTree[LLUUID::null] = catsp;
+        root_children.mCategories = new cat_array_t;
     }
 
     // Now we have a structure with all of the categories that we can
@@ -3263,7 +3394,7 @@ void LLInventoryModel::buildParentChildMap()
     cat_array_t lost_cats;
     for (auto& cat : cats)
     {
-        catsp = getUnlockedCatArray(cat->getParentUUID());
+        catsp = unlocked_cat_array(cat->getParentUUID());
 #ifdef OPENSIM
         if(catsp &&
            (!LLGridManager::getInstance()->isInSecondLife() || (cat->getParentUUID().notNull() ||
@@ -3344,21 +3475,12 @@ void LLInventoryModel::buildParentChildMap()
     // Now the items. We allocated in the last step, so now all we
     // have to do is iterate over the items and put them in the right
     // place.
-    item_array_t items;
-    if(!mItemMap.empty())
-    {
-        LLPointer<LLViewerInventoryItem> item;
-        for(item_map_t::iterator iit = mItemMap.begin(); iit != mItemMap.end(); ++iit)
-        {
-            item = (*iit).second;
-            items.push_back(item);
-        }
-    }
+    item_array_t items(mItemMap.begin(), mItemMap.end());
     lost = 0;
     uuid_vec_t lost_item_ids;
     for (auto& item : items)
     {
-        itemsp = getUnlockedItemArray(item->getParentUUID());
+        itemsp = unlocked_item_array(item->getParentUUID());
         if(itemsp)
         {
             itemsp->push_back(item);
@@ -3422,17 +3544,21 @@ void LLInventoryModel::buildParentChildMap()
     const LLUUID &agent_inv_root_id = gInventory.getRootFolderID();
     if (agent_inv_root_id.notNull())
     {
-        cat_array_t* catsp = get_ptr_in_map(mParentChildCategoryTree, agent_inv_root_id);
+        cat_array_t* catsp = getCatArray(agent_inv_root_id);
         if(catsp)
         {
             // *HACK - fix root inventory folder
             // some accounts has pbroken inventory root folders
 
             std::string name = "My Inventory";
-            for (parent_cat_map_t::const_iterator it = mParentChildCategoryTree.begin(),
-                     it_end = mParentChildCategoryTree.end(); it != it_end; ++it)
+            for (parent_child_map_t::const_iterator it = mParentChildTree.begin(),
+                     it_end = mParentChildTree.end(); it != it_end; ++it)
             {
-                cat_array_t* cat_array = it->second;
+                cat_array_t* cat_array = it->second.mCategories;
+                if (!cat_array)
+                {
+                    continue;
+                }
                 for (cat_array_t::const_iterator cat_it = cat_array->begin(),
                          cat_it_end = cat_array->end(); cat_it != cat_it_end; ++cat_it)
                     {
@@ -3661,159 +3787,277 @@ bool LLInventoryModel::loadFromFile(const std::string& filename,
 
     is_cache_obsolete = true; // Obsolete until proven current
 
-    //U64 lines_count = 0U;
+    std::vector<std::string> lines;
     std::string line;
-    LLPointer<LLSDParser> parser = new LLSDNotationParser();
     while (std::getline(file, line))
+    {
+        lines.push_back(std::move(line));
+    }
+    file.close();
+
+    if (lines.empty())
+    {
+        return false;
+    }
+
+    // The first line holds the cache version
     {
         LLSD s_item;
-        std::istringstream iss(line);
-        if (parser->parse(iss, s_item, line.length()) == LLSDParser::PARSE_FAILURE)
+        LLPointer<LLSDParser> parser = new LLSDNotationParser();
+        std::istringstream iss(lines[0]);
+        if (parser->parse(iss, s_item, lines[0].length()) == LLSDParser::PARSE_FAILURE)
         {
             LL_WARNS(LOG_INV)<< "Parsing inventory cache failed" << LL_ENDL;
-            break;
+            return false;
         }
-
-        if (s_item.has("inv_cache_version"))
+        if (!s_item.has("inv_cache_version"))
         {
-            S32 version = s_item["inv_cache_version"].asInteger();
-            if (version == sCurrentInvCacheVersion)
-            {
-                // Cache is up to date
-                is_cache_obsolete = false;
-                continue;
-            }
-            else
-            {
-                LL_WARNS(LOG_INV)<< "Inventory cache is out of date" << LL_ENDL;
-                break;
-            }
+            return false;
         }
-        else if (s_item.has("cat_id"))
+        if (s_item["inv_cache_version"].asInteger() != sCurrentInvCacheVersion)
         {
-            if (is_cache_obsolete)
-                break;
-
-            LLPointer<LLViewerInventoryCategory> inv_cat = new LLViewerInventoryCategory(LLUUID::null);
-            if(inv_cat->importLLSD(s_item))
-            {
-                categories.push_back(inv_cat);
-            }
+            LL_WARNS(LOG_INV)<< "Inventory cache is out of date" << LL_ENDL;
+            return false;
         }
-        else if (s_item.has("item_id"))
-        {
-            if (is_cache_obsolete)
-                break;
+        // Cache is up to date
+        is_cache_obsolete = false;
+    }
 
-            LLPointer<LLViewerInventoryItem> inv_item = new LLViewerInventoryItem;
-            if( inv_item->fromLLSD(s_item) )
+    // The rest is parsed in chunks on the General queue, each chunk into
+    // its own arrays, which are then appended in file order. A chunk stops
+    // where the serial parse used to stop reading, and nothing after it is
+    // used.
+    struct Chunk
+    {
+        cat_array_t mCategories;
+        item_array_t mItems;
+        changed_items_t mCatsToUpdate;
+        bool mStopped = false;
+    };
+    const size_t num_lines = lines.size() - 1;
+    const size_t num_chunks = (num_lines + INV_CACHE_LINES_PER_CHUNK - 1) / INV_CACHE_LINES_PER_CHUNK;
+    std::vector<Chunk> chunks(num_chunks);
+    LL::parallel_for("General", num_chunks, [&lines, &chunks, num_lines](size_t c)
+        {
+            Chunk& chunk = chunks[c];
+            LLPointer<LLSDParser> parser = new LLSDNotationParser();
+            const size_t first = 1 + c * INV_CACHE_LINES_PER_CHUNK;
+            const size_t last = 1 + llmin(num_lines, (c + 1) * INV_CACHE_LINES_PER_CHUNK);
+            for (size_t i = first; i < last; ++i)
             {
-                if(inv_item->getUUID().isNull())
+                const std::string& line = lines[i];
+                LLSD s_item;
+                std::istringstream iss(line);
+                if (parser->parse(iss, s_item, line.length()) == LLSDParser::PARSE_FAILURE)
                 {
-                    LL_DEBUGS(LOG_INV) << "Ignoring inventory with null item id: "
-                        << inv_item->getName() << LL_ENDL;
+                    LL_WARNS(LOG_INV)<< "Parsing inventory cache failed" << LL_ENDL;
+                    chunk.mStopped = true;
+                    break;
                 }
-                else
+
+                if (s_item.has("inv_cache_version"))
                 {
-                    if (inv_item->getType() == LLAssetType::AT_UNKNOWN)
+                    if (s_item["inv_cache_version"].asInteger() != sCurrentInvCacheVersion)
                     {
-                        cats_to_update.insert(inv_item->getParentUUID());
+                        LL_WARNS(LOG_INV)<< "Inventory cache is out of date" << LL_ENDL;
+                        chunk.mStopped = true;
+                        break;
                     }
-                    else
+                }
+                else if (s_item.has("cat_id"))
+                {
+                    LLPointer<LLViewerInventoryCategory> inv_cat = new LLViewerInventoryCategory(LLUUID::null);
+                    if(inv_cat->importLLSD(s_item))
                     {
-                        items.push_back(inv_item);
+                        chunk.mCategories.push_back(inv_cat);
+                    }
+                }
+                else if (s_item.has("item_id"))
+                {
+                    LLPointer<LLViewerInventoryItem> inv_item = new LLViewerInventoryItem;
+                    if( inv_item->fromLLSD(s_item) )
+                    {
+                        if(inv_item->getUUID().isNull())
+                        {
+                            LL_DEBUGS(LOG_INV) << "Ignoring inventory with null item id: "
+                                << inv_item->getName() << LL_ENDL;
+                        }
+                        else
+                        {
+                            if (inv_item->getType() == LLAssetType::AT_UNKNOWN)
+                            {
+                                chunk.mCatsToUpdate.insert(inv_item->getParentUUID());
+                            }
+                            else
+                            {
+                                chunk.mItems.push_back(inv_item);
+                            }
+                        }
                     }
                 }
             }
-        }
+            // Keep going, the chunks before a stopped one are still used
+            return true;
+        });
 
-//      TODO(brad) - figure out how to reenable this without breaking everything else
-//      static constexpr U64 BATCH_SIZE = 512U;
-//      if ((++lines_count % BATCH_SIZE) == 0)
-//      {
-//          // SL-19968 - make sure message system code gets a chance to run every so often
-//          pump_idle_startup_network();
-//      }
+    for (Chunk& chunk : chunks)
+    {
+        categories.insert(categories.end(), chunk.mCategories.begin(), chunk.mCategories.end());
+        items.insert(items.end(), chunk.mItems.begin(), chunk.mItems.end());
+        cats_to_update.insert(chunk.mCatsToUpdate.begin(), chunk.mCatsToUpdate.end());
+        if (chunk.mStopped)
+        {
+            break;
+        }
     }
 
-    file.close();
-
     return !is_cache_obsolete;
 }
 
 // static
-bool LLInventoryModel::saveToFile(const std::string& filename,
-    const cat_array_t& categories,
-    const item_array_t& items)
+bool LLInventoryModel::loadFromBinaryFile(const std::string& filename,
+                                          LLInventoryModel::cat_array_t& categories,
+                                          LLInventoryModel::item_array_t& items,
+                                          LLInventoryModel::changed_items_t& cats_to_update,
+                                          bool& is_cache_obsolete)
 {
-    if (filename.empty())
+    LL_PROFILE_ZONE_NAMED("inventory load from binary file");
+
+    LL_INFOS(LOG_INV) << "loading inventory from: (" << filename << ")" << LL_ENDL;
+
+    std::vector<LLInventoryCacheFile::Category> cache_categories;
+    std::vector<LLInventoryCacheFile::Item> cache_items;
+    LLInventoryCacheFile::EResult result = LLInventoryCacheFile::read(filename, sCurrentInvCacheVersion, cache_categories, cache_items);
+    if (result != LLInventoryCacheFile::RESULT_OK)
     {
-        LL_ERRS(LOG_INV) << "Filename is Null!" << LL_ENDL;
+        // Damaged files are thrown away like out of date ones
+        is_cache_obsolete = result != LLInventoryCacheFile::RESULT_MISSING;
+        LL_WARNS(LOG_INV) << "Unable to load inventory from: " << filename << " result: " << (S32)result << LL_ENDL;
         return false;
     }
+    is_cache_obsolete = false;
 
-    LL_INFOS(LOG_INV) << "saving inventory to: (" << filename << ")" << LL_ENDL;
-
-    try
+    categories.reserve(categories.size() + cache_categories.size());
+    for (const LLInventoryCacheFile::Category& cache_cat : cache_categories)
     {
-        llofstream fileXML(filename.c_str());
-        if (!fileXML.is_open())
+        LLPointer<LLViewerInventoryCategory> inv_cat = new LLViewerInventoryCategory(
+            cache_cat.mUUID, cache_cat.mParentUUID, cache_cat.mPreferredType, cache_cat.mName, cache_cat.mOwnerID);
+        inv_cat->setVersion(cache_cat.mVersion);
+        inv_cat->setThumbnailUUID(cache_cat.mThumbnailUUID);
+        categories.push_back(inv_cat);
+    }
+
+    // Viewer items are made in chunks on the General queue, then appended
+    // in file order
+    std::vector<LLPointer<LLViewerInventoryItem> > inv_items(cache_items.size());
+    const size_t num_chunks = (cache_items.size() + INV_CACHE_ITEMS_PER_CHUNK - 1) / INV_CACHE_ITEMS_PER_CHUNK;
+    LL::parallel_for("General", num_chunks, [&cache_items, &inv_items](size_t c)
         {
-            LL_WARNS(LOG_INV) << "Failed to open file. Unable to save inventory to: " << filename << LL_ENDL;
-            return false;
-        }
+            const size_t last = llmin(cache_items.size(), (c + 1) * INV_CACHE_ITEMS_PER_CHUNK);
+            for (size_t i = c * INV_CACHE_ITEMS_PER_CHUNK; i < last; ++i)
+            {
+                const LLInventoryCacheFile::Item& cache_item = cache_items[i];
+                if (cache_item.mUUID.isNull() || cache_item.mType == LLAssetType::AT_UNKNOWN)
+                {
+                    continue;
+                }
 
-        LLSD cache_ver;
-        cache_ver["inv_cache_version"] = sCurrentInvCacheVersion;
+                LLViewerInventoryItem* inv_item = new LLViewerInventoryItem(
+                    cache_item.mUUID, cache_item.mParentUUID, cache_item.mPermissions, cache_item.mAssetUUID,
+                    cache_item.mType, cache_item.mInventoryType, cache_item.mName, cache_item.mDescription,
+                    cache_item.mSaleInfo, cache_item.mFlags, cache_item.mCreationDate);
+                inv_item->setThumbnailUUID(cache_item.mThumbnailUUID);
+                // As loadFromFile() leaves them
+                inv_item->setComplete(false);
+                inv_items[i] = inv_item;
+            }
+            return true;
+        });
 
-        if (fileXML.fail())
+    items.reserve(items.size() + cache_items.size());
+    for (size_t i = 0; i < cache_items.size(); ++i)
+    {
+        const LLInventoryCacheFile::Item& cache_item = cache_items[i];
+        if (cache_item.mUUID.isNull())
         {
-            LL_WARNS(LOG_INV) << "Failed to write cache version to file. Unable to save inventory to: " << filename << LL_ENDL;
-            return false;
+            LL_DEBUGS(LOG_INV) << "Ignoring inventory with null item id: " << cache_item.mName << LL_ENDL;
         }
-
-        fileXML << LLSDOStreamer<LLSDNotationFormatter>(cache_ver) << std::endl;
-
-        S32 cat_count = 0;
-        for (auto& cat : categories)
+        else if (cache_item.mType == LLAssetType::AT_UNKNOWN)
         {
-            if (cat->getVersion() != LLViewerInventoryCategory::VERSION_UNKNOWN)
-            {
-                fileXML << LLSDOStreamer<LLSDNotationFormatter>(cat->exportLLSD()) << std::endl;
-                cat_count++;
-            }
-
-            if (fileXML.fail())
-            {
-                LL_WARNS(LOG_INV) << "Failed to write a folder to file. Unable to save inventory to: " << filename << LL_ENDL;
-                return false;
-            }
+            cats_to_update.insert(cache_item.mParentUUID);
         }
-
-        auto it_count = items.size();
-        for (auto& item : items)
+        else
         {
-            fileXML << LLSDOStreamer<LLSDNotationFormatter>(item->asLLSD()) << std::endl;
-
-            if (fileXML.fail())
-            {
-                LL_WARNS(LOG_INV) << "Failed to write an item to file. Unable to save inventory to: " << filename << LL_ENDL;
-                return false;
-            }
+            items.push_back(std::move(inv_items[i]));
         }
-        fileXML.flush();
+    }
 
-        fileXML.close();
+    return true;
+}
+
+// static
+bool LLInventoryModel::saveToBinaryFile(const std::string& filename,
+                                        const cat_array_t& categories,
+                                        const item_array_t& items)
+{
+    LL_PROFILE_ZONE_NAMED("inventory save to binary file");
 
-        LL_INFOS(LOG_INV) << "Inventory saved: " << cat_count << " categories, " << it_count << " items." << LL_ENDL;
+    if (filename.empty())
+    {
+        LL_ERRS(LOG_INV) << "Filename is Null!" << LL_ENDL;
+        return false;
     }
-    catch (...)
+
+    LL_INFOS(LOG_INV) << "saving inventory to: (" << filename << ")" << LL_ENDL;
+
+    std::vector<LLInventoryCacheFile::Category> cache_categories;
+    cache_categories.reserve(categories.size());
+    for (const auto& cat : categories)
     {
-        LOG_UNHANDLED_EXCEPTION("");
-        LL_INFOS(LOG_INV) << "Failed to save inventory to: (" << filename << ")" << LL_ENDL;
+        if (cat->getVersion() == LLViewerInventoryCategory::VERSION_UNKNOWN)
+        {
+            continue;
+        }
+
+        LLInventoryCacheFile::Category cache_cat;
+        cache_cat.mUUID = cat->getUUID();
+        cache_cat.mParentUUID = cat->getParentUUID();
+        cache_cat.mThumbnailUUID = cat->getThumbnailUUID();
+        cache_cat.mOwnerID = cat->getOwnerID();
+        cache_cat.mName = cat->getName();
+        cache_cat.mVersion = cat->getVersion();
+        cache_cat.mPreferredType = cat->getPreferredType();
+        cache_categories.push_back(std::move(cache_cat));
+    }
+
+    std::vector<LLInventoryCacheFile::Item> cache_items(items.size());
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        const LLViewerInventoryItem* item = items[i].get();
+        LLInventoryCacheFile::Item& cache_item = cache_items[i];
+        // What the item holds, as asLLSD() writes it. The viewer item
+        // accessors follow links.
+        cache_item.mUUID = item->getUUID();
+        cache_item.mParentUUID = item->getParentUUID();
+        cache_item.mAssetUUID = item->LLInventoryItem::getAssetUUID();
+        cache_item.mThumbnailUUID = item->LLInventoryItem::getThumbnailUUID();
+        cache_item.mPermissions = item->LLInventoryItem::getPermissions();
+        cache_item.mSaleInfo = item->LLInventoryItem::getSaleInfo();
+        cache_item.mName = item->LLInventoryItem::getName();
+        cache_item.mDescription = item->LLInventoryItem::getDescription();
+        cache_item.mFlags = item->LLInventoryItem::getFlags();
+        cache_item.mCreationDate = item->LLInventoryItem::getCreationDate();
+        cache_item.mType = item->LLInventoryItem::getType();
+        cache_item.mInventoryType = item->LLInventoryItem::getInventoryType();
+    }
+
+    if (!LLInventoryCacheFile::write(filename, sCurrentInvCacheVersion, cache_categories, cache_items))
+    {
+        LL_WARNS(LOG_INV) << "Unable to save inventory to: " << filename << LL_ENDL;
         return false;
     }
 
+    LL_INFOS(LOG_INV) << "Inventory saved: " << cache_categories.size() << " categories, " << cache_items.size() << " items." << LL_ENDL;
     return true;
 }
 
@@ -4866,9 +5110,8 @@ void LLInventoryModel::dumpInventory() const
 {
     LL_INFOS() << "\nBegin Inventory Dump\n**********************:" << LL_ENDL;
     LL_INFOS() << "mCategory[] contains " << mCategoryMap.size() << " items." << LL_ENDL;
-    for(cat_map_t::const_iterator cit = mCategoryMap.begin(); cit != mCategoryMap.end(); ++cit)
+    for (const LLViewerInventoryCategory* cat : mCategoryMap)
     {
-        const LLViewerInventoryCategory* cat = cit->second;
         if(cat)
         {
             LL_INFOS() << "  " <<  cat->getUUID() << " '" << cat->getName() << "' "
@@ -4881,9 +5124,8 @@ void LLInventoryModel::dumpInventory() const
         }
     }
     LL_INFOS() << "mItemMap[] contains " << mItemMap.size() << " items." << LL_ENDL;
-    for(item_map_t::const_iterator iit = mItemMap.begin(); iit != mItemMap.end(); ++iit)
+    for (const LLViewerInventoryItem* item : mItemMap)
     {
-        const LLViewerInventoryItem* item = iit->second;
         if(item)
         {
             LL_INFOS() << "  " << item->getUUID() << " "
@@ -4927,11 +5169,11 @@ LLPointer<LLInventoryValidationInfo> LLInventoryModel::validate() const
         fatal_errs++;
     }
 
-    if (mCategoryMap.size() + 1 != mParentChildCategoryTree.size())
+    if (mCategoryMap.size() + 1 != mParentChildTree.size())
     {
         // ParentChild should be one larger because of the special entry for null uuid.
         LL_INFOS("Inventory") << "unexpected sizes: cat map size " << mCategoryMap.size()
-                              << " parent/child " << mParentChildCategoryTree.size() << LL_ENDL;
+                              << " parent/child " << mParentChildTree.size() << LL_ENDL;
 
         validation_info->mWarnings["category_map_size"]++;
         warning_count++;
@@ -4946,10 +5188,8 @@ LLPointer<LLInventoryValidationInfo> LLInventoryModel::validate() const
     ft_count_map ft_counts_elsewhere;
 
     // Loop over all categories and check.
-    for(cat_map_t::const_iterator cit = mCategoryMap.begin(); cit != mCategoryMap.end(); ++cit)
+    for (const LLViewerInventoryCategory* cat : mCategoryMap)
     {
-        const LLUUID& cat_id = cit->first;
-        const LLViewerInventoryCategory *cat = cit->second;
         if (!cat)
         {
             LL_WARNS("Inventory") << "null cat" << LL_ENDL;
@@ -4957,6 +5197,7 @@ LLPointer<LLInventoryValidationInfo> LLInventoryModel::validate() const
             warning_count++;
             continue;
         }
+        const LLUUID& cat_id = cat->getUUID();
         LLUUID topmost_ancestor_id;
         // Will leave as null uuid on failure
         EAncestorResult res = getObjectTopmostAncestor(cat_id, topmost_ancestor_id);
@@ -4977,9 +5218,10 @@ LLPointer<LLInventoryValidationInfo> LLInventoryModel::validate() const
             break;
         }
 
-        if (cat_id != cat->getUUID())
+        // The id changed after the category was filed
+        if (mCategoryMap.find(cat_id) != cat)
         {
-            LL_WARNS("Inventory") << "cat id/index mismatch " << cat_id << " " << cat->getUUID() << LL_ENDL;
+            LL_WARNS("Inventory") << "cat id/index mismatch " << cat_id << LL_ENDL;
             validation_info->mWarnings["cat_id_index_mismatch"]++;
             warning_count++;
         }
@@ -5072,8 +5314,8 @@ LLPointer<LLInventoryValidationInfo> LLInventoryModel::validate() const
 
 
             // Entries in items and mItemMap should correspond.
-            item_map_t::const_iterator it = mItemMap.find(item_id);
-            if (it == mItemMap.end())
+            LLViewerInventoryItem* top_item = mItemMap.find(item_id);
+            if (!top_item)
             {
                 LL_WARNS("Inventory") << "item " << item_id << " found as child of "
                                       << cat_id << " but not in top level mItemMap" << LL_ENDL;
@@ -5082,7 +5324,6 @@ LLPointer<LLInventoryValidationInfo> LLInventoryModel::validate() const
             }
             else
             {
-                LLViewerInventoryItem *top_item = it->second;
                 if (top_item != item)
                 {
                     LL_WARNS("Inventory") << "item mismatch, item_id " << item_id
@@ -5187,13 +5428,13 @@ LLPointer<LLInventoryValidationInfo> LLInventoryModel::validate() const
     }
 
     // Loop over all items and check
-    for(item_map_t::const_iterator iit = mItemMap.begin(); iit != mItemMap.end(); ++iit)
+    for (LLViewerInventoryItem* item : mItemMap)
     {
-        const LLUUID& item_id = iit->first;
-        LLViewerInventoryItem *item = iit->second;
-        if (item->getUUID() != item_id)
+        const LLUUID& item_id = item->getUUID();
+        // The id changed after the item was filed
+        if (mItemMap.find(item_id) != item)
         {
-            LL_WARNS("Inventory") << "item_id " << item_id << " does not match " << item->getUUID() << LL_ENDL;
+            LL_WARNS("Inventory") << "item_id " << item_id << " does not match its index" << LL_ENDL;
             validation_info->mWarnings["item_id_mismatch"]++;
             warning_count++;
         }
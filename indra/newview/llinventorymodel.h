@@ -30,11 +30,14 @@
 #include <map>
 #include <set>
 #include <string>
+#include <typeindex>
 #include <vector>
+#include <boost/unordered/unordered_flat_map.hpp>
 
 #include "llassettype.h"
 #include "llfoldertype.h"
 #include "llframetimer.h"
+#include "llinventorystore.h"
 #include "lluuid.h"
 #include "llpermissionsflags.h"
 #include "llviewerinventory.h"
@@ -204,6 +207,10 @@ public:
     void createCommonSystemCategories();
 
     static std::string getInvCacheAddres(const LLUUID& owner_id);
+    // The binary cache, read first. The notation cache above is only read
+    // when there is no binary one, and is removed once the binary one is
+    // written.
+    static std::string getInvBinaryCacheAddres(const LLUUID& owner_id);
 
     // Call on logout to save a terse representation.
     void cache(const LLUUID& parent_folder_id, const LLUUID& agent_id);
@@ -212,16 +219,23 @@ private:
     // information in a lot of different ways so we can access
     // the inventory using several different identifiers.
     // mInventory member data is the 'master' list of inventory, and
-    // mCategoryMap and mItemMap store uuid->object mappings.
-    typedef std::map<LLUUID, LLPointer<LLViewerInventoryCategory> > cat_map_t;
-    typedef std::map<LLUUID, LLPointer<LLViewerInventoryItem> > item_map_t;
+    // mCategoryMap and mItemMap store uuid->object mappings. Iterating
+    // them gives the objects, in no particular order.
+    typedef LLInventoryStore<LLViewerInventoryCategory> cat_map_t;
+    typedef LLInventoryStore<LLViewerInventoryItem> item_map_t;
     cat_map_t mCategoryMap;
     item_map_t mItemMap;
-    // This last set of indices is used to map parents to children.
-    typedef std::map<LLUUID, cat_array_t*> parent_cat_map_t;
-    typedef std::map<LLUUID, item_array_t*> parent_item_map_t;
-    parent_cat_map_t mParentChildCategoryTree;
-    parent_item_map_t mParentChildItemTree;
+    // This last index is used to map parents to children. Either array
+    // may be NULL, the one of the null parent has no items.
+    struct LLChildArrays
+    {
+        cat_array_t* mCategories = NULL;
+        item_array_t* mItems = NULL;
+    };
+    typedef boost::unordered_flat_map<LLUUID, LLChildArrays> parent_child_map_t;
+    parent_child_map_t mParentChildTree;
+    cat_array_t* getCatArray(const LLUUID& id) const;
+    item_array_t* getItemArray(const LLUUID& id) const;
 
     // Track links to items and categories. We do not store item or
     // category pointers here, because broken links are also supported.
@@ -381,6 +395,14 @@ public:
     //    updateCategory() method to actually modify values.
     LLViewerInventoryCategory* getCategory(const LLUUID& id) const;
 
+    // Handles keep referring to the same object while others are added
+    // and removed, and are cheaper to resolve than UUIDs. The getters
+    // return NULL once the object is deleted.
+    LLInventoryHandle getItemHandle(const LLUUID& id) const;
+    LLViewerInventoryItem* getItem(const LLInventoryHandle& handle) const;
+    LLInventoryHandle getCategoryHandle(const LLUUID& id) const;
+    LLViewerInventoryCategory* getCategory(const LLInventoryHandle& handle) const;
+
     // Get the inventoryID or item that this item points to, else just return object_id
     const LLUUID& getLinkedItemID(const LLUUID& object_id) const;
     LLViewerInventoryItem* getLinkedItem(const LLUUID& object_id) const;
@@ -628,6 +650,10 @@ public:
 
     const changed_items_t& getChangedIDs() const { return mChangedItemIDs; }
     const changed_items_t& getAddedIDs() const { return mAddedItemIDs; }
+    // The LLInventoryObserver flags of the changes to id being notified,
+    // NONE if it did not change. Lets observers pick the ids they care
+    // about out of getChangedIDs() instead of looking at every one.
+    U32 getChangedMask(const LLUUID& id) const;
 // [SL:KB] - Patch: UI-Notifications | Checked: Catznip-6.5
     const LLUUID& getTransactionId() const { return mTransactionId; }
 // [/SL:KB]
@@ -642,10 +668,13 @@ private:
     U32 mModifyMask;
     changed_items_t mChangedItemIDs;
     changed_items_t mAddedItemIDs;
+    typedef boost::unordered_flat_map<LLUUID, U32> changed_masks_t;
+    changed_masks_t mChangedMasks;
     // Fallback when notifyObservers is in progress
     U32 mModifyMaskBacklog;
     changed_items_t mChangedItemIDsBacklog;
     changed_items_t mAddedItemIDsBacklog;
+    changed_masks_t mChangedMasksBacklog;
     typedef std::map<LLUUID , changed_items_t> broken_links_t;
     broken_links_t mPossiblyBrockenLinks; // there can be multiple links per item
     changed_items_t mLinksRebuildList;
@@ -668,6 +697,16 @@ private:
     typedef std::set<LLInventoryObserver*> observer_list_t;
     observer_list_t mObservers;
 
+    // Time spent in changed() by each class of observer, logged on exit
+    struct ObserverStats
+    {
+        U32 mCalls = 0;
+        U32 mSkipped = 0;
+        F64 mSeconds = 0.0;
+    };
+    std::map<std::type_index, ObserverStats> mObserverStats;
+    void logObserverStats() const;
+
 /**                    Notifications
  **                                                                            **
  *******************************************************************************/
@@ -729,9 +768,14 @@ protected:
                              item_array_t& items,
                              changed_items_t& cats_to_update,
                              bool& is_cache_obsolete);
-    static bool saveToFile(const std::string& filename,
-                           const cat_array_t& categories,
-                           const item_array_t& items);
+    static bool loadFromBinaryFile(const std::string& filename,
+                                   cat_array_t& categories,
+                                   item_array_t& items,
+                                   changed_items_t& cats_to_update,
+                                   bool& is_cache_obsolete);
+    static bool saveToBinaryFile(const std::string& filename,
+                                 const cat_array_t& categories,
+                                 const item_array_t& items);
 
     //--------------------------------------------------------------------
     // Message handling functionality
@@ -182,6 +182,15 @@ private:
 
 const S32 MAX_FETCH_RETRIES = 10; // <FS:ND/> For legacy inventory
 
+// AIS fetches in flight when the background fetch starts
+const F32 INITIAL_AIS_FETCH_LIMIT = 4.f;
+// Responses this many times slower than the usual ones of their kind are
+// queueing up on the server, more requests would only make them slower
+const F64 AIS_QUEUEING_FACTOR = 4.0;
+// How far the usual response time moves toward a slower response, so that
+// one lucky fast response doesn't set it for good
+const F64 AIS_BASELINE_DECAY = 0.05;
+
 const char* const LOG_INV("Inventory");
 
 } // end of namespace anonymous
@@ -197,12 +206,21 @@ LLInventoryModelBackgroundFetch::LLInventoryModelBackgroundFetch():
     mFetchCount(0),
     mLastFetchCount(0),
     mFetchFolderCount(0),
+    mAISFetchLimit(INITIAL_AIS_FETCH_LIMIT),
+    mAISFetchThreshold(F32_MAX),
+    mAISLastBackOffTime(0.0),
+    mAISThrottledCount(0),
     mAllRecursiveFoldersFetched(false),
     mRecursiveInventoryFetchStarted(false),
     mRecursiveLibraryFetchStarted(false),
     mRecursiveMarketplaceFetchStarted(false),
     mMinTimeBetweenFetches(0.3f)
-{}
+{
+    for (S32 kind = 0; kind < AIS_FETCH_KIND_COUNT; ++kind)
+    {
+        mAISBaselineResponse[kind] = 0.0;
+    }
+}
 
 LLInventoryModelBackgroundFetch::~LLInventoryModelBackgroundFetch()
 {
@@ -742,6 +760,58 @@ void ais_simple_item_callback(const LLUUID& inv_id)
     LLInventoryModelBackgroundFetch::instance().incrFetchCount(-1);
 }
 
+void LLInventoryModelBackgroundFetch::onAISFetchDone(F64 start_time, EAISFetchKind kind, bool success)
+{
+    // Only throttling (429, 503) says there are too many fetches. Other
+    // failures, like the 403 of a recursive fetch over the content limit,
+    // get retried differently and leave the window alone.
+    const U32 throttled_count = AISAPI::getThrottledCount();
+    if (throttled_count != mAISThrottledCount)
+    {
+        mAISThrottledCount = throttled_count;
+        // Fetches sent before the last back off were already in flight
+        // with the larger window, they don't count again
+        if (start_time >= mAISLastBackOffTime)
+        {
+            mAISLastBackOffTime = LLTimer::getTotalSeconds();
+            mAISFetchThreshold = llmax(mAISFetchLimit * 0.5f, 1.f);
+            mAISFetchLimit = mAISFetchThreshold;
+            LL_DEBUGS(LOG_INV, "AIS3") << "Fetches throttled, backing off to "
+                                       << (S32)mAISFetchLimit << " fetches" << LL_ENDL;
+        }
+        return;
+    }
+    if (!success)
+    {
+        return;
+    }
+
+    const F64 response_time = LLTimer::getTotalSeconds() - start_time;
+    F64& baseline = mAISBaselineResponse[kind];
+    const bool queueing = baseline > 0.0 && response_time > baseline * AIS_QUEUEING_FACTOR;
+    if (baseline <= 0.0 || response_time < baseline)
+    {
+        baseline = response_time;
+    }
+    else
+    {
+        baseline += (response_time - baseline) * AIS_BASELINE_DECAY;
+    }
+    if (queueing)
+    {
+        return;
+    }
+
+    if (mAISFetchLimit < mAISFetchThreshold)
+    {
+        mAISFetchLimit += 1.f;
+    }
+    else
+    {
+        mAISFetchLimit += 1.f / mAISFetchLimit;
+    }
+}
+
 void LLInventoryModelBackgroundFetch::onAISContentCalback(
     const LLUUID& request_id,
     const uuid_vec_t& content_ids,
@@ -914,7 +984,9 @@ void LLInventoryModelBackgroundFetch::bulkFetchViaAis()
     static LLCachedControl<U32> ais_pool(gSavedSettings, "PoolSizeAIS", 20);
     // Don't have too many requests at once, AIS throttles
     // Reserve one request for actions outside of fetch (like renames)
-    const U32 max_concurrent_fetches = llclamp(ais_pool - 1, 1, 50);
+    const U32 max_pool_fetches = llclamp(ais_pool - 1, 1, 50);
+    mAISFetchLimit = llclamp(mAISFetchLimit, 1.f, (F32)max_pool_fetches);
+    const U32 max_concurrent_fetches = (U32)mAISFetchLimit;
 
     if ((U32)mFetchCount >= max_concurrent_fetches)
     {
@@ -1024,8 +1096,10 @@ void LLInventoryModelBackgroundFetch::bulkFetchViaAis(const FetchQueueInfo& fetc
             mExpectedFolderIds.emplace_back(cat_id);
             // Lost and found
             // Should it actually be recursive?
-            AISAPI::FetchOrphans([](const LLUUID& response_id)
+            const F64 start_time = LLTimer::getTotalSeconds();
+            AISAPI::FetchOrphans([start_time](const LLUUID& response_id)
                                  {
+                                     LLInventoryModelBackgroundFetch::instance().onAISFetchDone(start_time, AIS_FETCH_RECURSIVE, response_id.notNull());
                                      LLInventoryModelBackgroundFetch::instance().onAISFolderCalback(LLUUID::null,
                                          response_id,
                                          FT_DEFAULT);
@@ -1086,8 +1160,10 @@ void LLInventoryModelBackgroundFetch::bulkFetchViaAis(const FetchQueueInfo& fetc
 
                         EFetchType type = fetch_info.mFetchType;
                         LLUUID cat_id = cat->getUUID(); // need a copy for lambda
-                        AISAPI::completion_t cb = [cat_id, children, type](const LLUUID& response_id)
+                        const F64 start_time = LLTimer::getTotalSeconds();
+                        AISAPI::completion_t cb = [cat_id, children, type, start_time](const LLUUID& response_id)
                         {
+                            LLInventoryModelBackgroundFetch::instance().onAISFetchDone(start_time, AIS_FETCH_RECURSIVE, response_id.notNull());
                             LLInventoryModelBackgroundFetch::instance().onAISContentCalback(cat_id, children, response_id, type);
                         };
 
@@ -1140,8 +1216,11 @@ void LLInventoryModelBackgroundFetch::bulkFetchViaAis(const FetchQueueInfo& fetc
 
                         EFetchType type = fetch_info.mFetchType;
                         LLUUID cat_cb_id = cat_id;
-                        AISAPI::completion_t cb = [cat_cb_id, type](const LLUUID& response_id)
+                        const F64 start_time = LLTimer::getTotalSeconds();
+                        const EAISFetchKind kind = type == FT_RECURSIVE ? AIS_FETCH_RECURSIVE : AIS_FETCH_FOLDER;
+                        AISAPI::completion_t cb = [cat_cb_id, type, start_time, kind](const LLUUID& response_id)
                         {
+                            LLInventoryModelBackgroundFetch::instance().onAISFetchDone(start_time, kind, response_id.notNull());
                             LLInventoryModelBackgroundFetch::instance().onAISFolderCalback(cat_cb_id, response_id , type);
                         };
 
@@ -1178,6 +1257,12 @@ void LLInventoryModelBackgroundFetch::bulkFetchViaAis(const FetchQueueInfo& fetc
     else
     {
         LLViewerInventoryItem* itemp(gInventory.getItem(fetch_info.mUUID));
+        const F64 start_time = LLTimer::getTotalSeconds();
+        AISAPI::completion_t cb = [start_time](const LLUUID& response_id)
+        {
+            LLInventoryModelBackgroundFetch::instance().onAISFetchDone(start_time, AIS_FETCH_ITEM, response_id.notNull());
+            ais_simple_item_callback(response_id);
+        };
 
         if (itemp)
         {
@@ -1186,11 +1271,11 @@ void LLInventoryModelBackgroundFetch::bulkFetchViaAis(const FetchQueueInfo& fetc
                 mFetchCount++;
                 if (itemp->getPermissions().getOwner() == gAgent.getID())
                 {
-                    AISAPI::FetchItem(fetch_info.mUUID, AISAPI::INVENTORY, ais_simple_item_callback);
+                    AISAPI::FetchItem(fetch_info.mUUID, AISAPI::INVENTORY, cb);
                 }
                 else
                 {
-                    AISAPI::FetchItem(fetch_info.mUUID, AISAPI::LIBRARY, ais_simple_item_callback);
+                    AISAPI::FetchItem(fetch_info.mUUID, AISAPI::LIBRARY, cb);
                 }
             }
         }
@@ -1198,7 +1283,7 @@ void LLInventoryModelBackgroundFetch::bulkFetchViaAis(const FetchQueueInfo& fetc
         {
             // Assume agent's inventory, library wouldn't have gotten here
             mFetchCount++;
-            AISAPI::FetchItem(fetch_info.mUUID, AISAPI::INVENTORY, ais_simple_item_callback);
+            AISAPI::FetchItem(fetch_info.mUUID, AISAPI::INVENTORY, cb);
         }
     }
 
@@ -110,6 +110,18 @@ protected:
 
     void onAISContentCalback(const LLUUID& request_id, const uuid_vec_t& content_ids, const LLUUID& response_id, EFetchType fetch_type);
     void onAISFolderCalback(const LLUUID& request_id, const LLUUID& response_id, EFetchType fetch_type);
+    // What an AIS fetch asks for: single items come back much faster than
+    // whole folder trees, so their response times are tracked apart
+    enum EAISFetchKind
+    {
+        AIS_FETCH_ITEM,
+        AIS_FETCH_FOLDER,
+        AIS_FETCH_RECURSIVE,
+        AIS_FETCH_KIND_COUNT
+    };
+    // Adapts how many AIS fetches are kept in flight to how a fetch of kind
+    // sent at start_time went
+    void onAISFetchDone(F64 start_time, EAISFetchKind kind, bool success);
     void bulkFetchViaAis();
     void bulkFetchViaAis(const FetchQueueInfo& fetch_info);
     void bulkFetch();
@@ -133,6 +145,16 @@ private:
     S32 mLastFetchCount; // for debug
     S32 mFetchFolderCount;
 
+    // Congestion window for AIS fetches: it grows by one per response until
+    // AIS throttles a request, then halves, at most once per round trip,
+    // and grows by one per round trip from there. It stops growing while
+    // responses take much longer than the usual ones of their kind.
+    F32 mAISFetchLimit;
+    F32 mAISFetchThreshold;
+    F64 mAISLastBackOffTime;
+    F64 mAISBaselineResponse[AIS_FETCH_KIND_COUNT];
+    U32 mAISThrottledCount;
+
     LLFrameTimer mFetchTimer;
     F32 mMinTimeBetweenFetches;
     fetch_queue_t mFetchFolderQueue;
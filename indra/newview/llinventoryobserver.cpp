@@ -884,20 +884,11 @@ LLInventoryCategoriesObserver::LLCategoryData::LLCategoryData(
 
 void LLScrollOnRenameObserver::changed(U32 mask)
 {
-    if (mask & LLInventoryObserver::LABEL)
+    if ((mask & LLInventoryObserver::LABEL) && gInventory.getChangedIDs().count(mUUID))
     {
-        const uuid_set_t& changed_item_ids = gInventory.getChangedIDs();
-        for (uuid_set_t::const_iterator it = changed_item_ids.begin(); it != changed_item_ids.end(); ++it)
-        {
-            const LLUUID& id = *it;
-            if (id == mUUID)
-            {
-                mView->scrollToShowSelection();
+        mView->scrollToShowSelection();
 
-                gInventory.removeObserver(this);
-                delete this;
-                return;
-            }
-        }
+        gInventory.removeObserver(this);
+        delete this;
     }
 }
@@ -65,6 +65,10 @@ public:
     LLInventoryObserver();
     virtual ~LLInventoryObserver();
     virtual void changed(U32 mask) = 0;
+    // The changes this observer cares about. changed() is skipped for
+    // notifications that carry none of them, but still gets the ones
+    // without any flag (NONE), which polling observers rely on.
+    virtual U32 getInterestMask() const { return ALL; }
 };
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -308,6 +312,7 @@ public:
     {
     }
     /* virtual */ void changed(U32 mask);
+    /* virtual */ U32 getInterestMask() const { return LABEL; }
 };
 
 
@@ -0,0 +1,239 @@
+/**
+ * @file llinventorysearchindex.cpp
+ * @brief Trigram indexes over the searchable strings of the inventory.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "llinventorysearchindex.h"
+
+#include "llinventorymodel.h"
+#include "llviewerinventory.h"
+
+LLInventorySearchIndex::LLInventorySearchIndex()
+:   mVersion(1)
+{
+    for (S32 field = 0; field < FIELD_COUNT; ++field)
+    {
+        mBuilt[field] = false;
+    }
+    gInventory.addObserver(this);
+}
+
+LLInventorySearchIndex::~LLInventorySearchIndex()
+{
+    for (auto& pending : mPendingCreators)
+    {
+        pending.second.mConnection.disconnect();
+    }
+    if (gInventory.containsObserver(this))
+    {
+        gInventory.removeObserver(this);
+    }
+}
+
+void LLInventorySearchIndex::changed(U32 mask)
+{
+    if (!(mask & getInterestMask()))
+    {
+        return;
+    }
+
+    bool any_built = false;
+    for (S32 field = 0; field < FIELD_COUNT; ++field)
+    {
+        any_built = any_built || mBuilt[field];
+    }
+    if (!any_built)
+    {
+        return;
+    }
+
+    // Moved objects keep their strings
+    for (const LLUUID& id : gInventory.getChangedIDs())
+    {
+        if (gInventory.getChangedMask(id) & getInterestMask())
+        {
+            indexObject(id);
+        }
+    }
+    ++mVersion;
+}
+
+bool LLInventorySearchIndex::find(EField field, const std::string& substring, LLTrigramIndex::id_set_t& matches)
+{
+    if (substring.size() < LLTrigramIndex::MIN_QUERY_LENGTH || !gInventory.isInventoryUsable())
+    {
+        return false;
+    }
+    if (!mBuilt[field])
+    {
+        build(field);
+    }
+    return mFields[field].find(substring, matches);
+}
+
+void LLInventorySearchIndex::build(EField field)
+{
+    LL_PROFILE_ZONE_SCOPED;
+
+    mFields[field].clear();
+    const LLUUID root_ids[] = { gInventory.getRootFolderID(), gInventory.getLibraryRootFolderID() };
+    for (const LLUUID& root_id : root_ids)
+    {
+        if (root_id.isNull())
+        {
+            continue;
+        }
+        LLInventoryModel::cat_array_t cats;
+        LLInventoryModel::item_array_t items;
+        gInventory.collectDescendents(root_id, cats, items, LLInventoryModel::INCLUDE_TRASH);
+        indexField(field, root_id, gInventory.getCategory(root_id));
+        for (const LLPointer<LLViewerInventoryCategory>& cat : cats)
+        {
+            indexField(field, cat->getUUID(), cat);
+        }
+        for (const LLPointer<LLViewerInventoryItem>& item : items)
+        {
+            indexField(field, item->getUUID(), item);
+        }
+    }
+    mBuilt[field] = true;
+    ++mVersion;
+
+    LL_INFOS("Inventory") << "Indexed search field " << (S32)field << " of "
+                          << mFields[field].size() << " objects" << LL_ENDL;
+}
+
+void LLInventorySearchIndex::indexObject(const LLUUID& id)
+{
+    const LLInventoryObject* obj = gInventory.getObject(id);
+    for (S32 field = 0; field < FIELD_COUNT; ++field)
+    {
+        if (mBuilt[field])
+        {
+            indexField((EField)field, id, obj);
+        }
+    }
+
+    if (obj && !obj->getIsLinkType())
+    {
+        for (const LLPointer<LLViewerInventoryItem>& link : gInventory.collectLinksTo(id))
+        {
+            for (S32 field = 0; field < FIELD_COUNT; ++field)
+            {
+                if (mBuilt[field])
+                {
+                    indexField((EField)field, link->getUUID(), link);
+                }
+            }
+        }
+    }
+}
+
+void LLInventorySearchIndex::indexField(EField field, const LLUUID& id, const LLInventoryObject* obj)
+{
+    // Links show the strings of what they link to, the viewer item
+    // accessors follow them.
+    const LLViewerInventoryItem* item = dynamic_cast<const LLViewerInventoryItem*>(obj);
+    std::string text;
+    switch (field)
+    {
+        case FIELD_NAME:
+            if (obj)
+            {
+                text = obj->getName();
+            }
+            break;
+        case FIELD_DESCRIPTION:
+            if (item)
+            {
+                text = item->getDescription();
+            }
+            break;
+        case FIELD_CREATOR:
+            if (item && item->getCreatorUUID().notNull())
+            {
+                const LLUUID& creator_id = item->getCreatorUUID();
+                LLAvatarName av_name;
+                if (LLAvatarNameCache::get(creator_id, &av_name))
+                {
+                    text = av_name.getUserName();
+                }
+                else
+                {
+                    PendingCreator& pending = mPendingCreators[creator_id];
+                    pending.mItemIDs.push_back(id);
+                    if (!pending.mConnection.connected())
+                    {
+                        pending.mConnection = LLAvatarNameCache::get(creator_id,
+                            boost::bind(&LLInventorySearchIndex::onCreatorName, this, _1, _2));
+                    }
+                }
+            }
+            break;
+        case FIELD_ASSET_ID:
+            if (item)
+            {
+                text = item->getAssetUUID().asString();
+            }
+            break;
+        default:
+            break;
+    }
+
+    if (text.empty())
+    {
+        mFields[field].remove(id);
+    }
+    else
+    {
+        LLStringUtil::toUpper(text);
+        mFields[field].set(id, text);
+    }
+}
+
+void LLInventorySearchIndex::onCreatorName(const LLUUID& creator_id, const LLAvatarName& av_name)
+{
+    auto found = mPendingCreators.find(creator_id);
+    if (found == mPendingCreators.end())
+    {
+        return;
+    }
+    uuid_vec_t item_ids;
+    item_ids.swap(found->second.mItemIDs);
+    mPendingCreators.erase(found);
+
+    std::string username = av_name.getUserName();
+    LLStringUtil::toUpper(username);
+    for (const LLUUID& item_id : item_ids)
+    {
+        const LLViewerInventoryItem* item = gInventory.getItem(item_id);
+        if (item && item->getCreatorUUID() == creator_id)
+        {
+            mFields[FIELD_CREATOR].set(item_id, username);
+        }
+    }
+    ++mVersion;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file llinventorysearchindex.h
+ * @brief Trigram indexes over the searchable strings of the inventory.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLINVENTORYSEARCHINDEX_H
+#define LL_LLINVENTORYSEARCHINDEX_H
+
+#include <map>
+
+#include "llavatarnamecache.h"
+#include "llinventoryobserver.h"
+#include "llsingleton.h"
+#include "lltrigramindex.h"
+
+class LLInventoryObject;
+
+/**
+ * Upper case names, descriptions, creator user names and asset ids of the
+ * agent and library inventories, as get_searchable_description() and its
+ * siblings return them, indexed by trigram. Each field is built from
+ * gInventory the first time it is searched, then kept current from the
+ * inventory observer callbacks.
+ *
+ * Names are the model names. The folder view searches the display name
+ * plus label suffix each bridge caches, which the model can not see, so
+ * name hits only stand for the bridges whose display name is the model
+ * name.
+ */
+class LLInventorySearchIndex : public LLInventoryObserver, public LLSingleton<LLInventorySearchIndex>
+{
+    LLSINGLETON(LLInventorySearchIndex);
+    virtual ~LLInventorySearchIndex();
+
+public:
+    enum EField
+    {
+        FIELD_NAME,
+        FIELD_DESCRIPTION,
+        FIELD_CREATOR,
+        FIELD_ASSET_ID,
+        FIELD_COUNT
+    };
+
+    virtual void changed(U32 mask) override;
+    virtual U32 getInterestMask() const override { return LABEL | INTERNAL | ADD | REMOVE | REBUILD; }
+
+    // Adds the ids of the objects whose field contains substring, which
+    // must already be upper case. Returns false when the index can not
+    // answer: the substring is too short, or the inventory is not usable
+    // yet.
+    bool find(EField field, const std::string& substring, LLTrigramIndex::id_set_t& matches);
+
+    // Changes whenever an indexed string does, so that callers can tell
+    // when matches they kept are out of date.
+    U32 getVersion() const { return mVersion; }
+
+private:
+    void build(EField field);
+    // Indexes an object, and the links to it since they show its strings
+    void indexObject(const LLUUID& id);
+    void indexField(EField field, const LLUUID& id, const LLInventoryObject* obj);
+    void onCreatorName(const LLUUID& creator_id, const LLAvatarName& av_name);
+
+    LLTrigramIndex mFields[FIELD_COUNT];
+    bool mBuilt[FIELD_COUNT];
+    U32 mVersion;
+
+    // Items waiting for the name of their creator
+    struct PendingCreator
+    {
+        uuid_vec_t mItemIDs;
+        LLAvatarNameCache::callback_connection_t mConnection;
+    };
+    std::map<LLUUID, PendingCreator> mPendingCreators;
+};
+
+#endif // LL_LLINVENTORYSEARCHINDEX_H
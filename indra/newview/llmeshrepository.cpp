@@ -911,6 +911,9 @@ LLMeshRepoThread::LLMeshRepoThread()
     // and a need to do expensive cacheOptimize().
     mMeshThreadPool.reset(new LL::ThreadPool("MeshLodProcessing", 2));
     mMeshThreadPool->start();
+    // Faces of big lods are optimized and get tangents in parallel.
+    mMeshFaceThreadPool.reset(new LL::ThreadPool(LLVolume::FACE_OPTIMIZE_QUEUE, 2));
+    mMeshFaceThreadPool->start();
 }
 
 
@@ -4231,6 +4234,7 @@ void LLMeshRepository::shutdown()
 
     mThread->mSignal->broadcast();
     mThread->mMeshThreadPool->close();
+    mThread->mMeshFaceThreadPool->close();
 
     while (!mThread->isStopped())
     {
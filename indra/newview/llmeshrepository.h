@@ -506,6 +506,8 @@ public:
     LL::WorkQueue mWorkQueue;
     // lods have their own thread due to costly cacheOptimize() calls
     std::unique_ptr<LL::ThreadPool> mMeshThreadPool;
+    // cacheOptimize() shares the faces of a lod with this pool
+    std::unique_ptr<LL::ThreadPool> mMeshFaceThreadPool;
 
     // llcorehttp library interface objects.
     LLCore::HttpStatus                  mHttpStatus;
@@ -33,6 +33,7 @@
 #include "llmeshrepository.h"
 #include "llvolume.h"
 #include "llrigginginfo.h"
+#include "llvertextransform.h"
 
 #define DEBUG_SKINNING  LL_DEBUG
 
@@ -275,6 +276,20 @@ void LLSkinningUtil::getPerVertexSkinMatrix(
     (void)valid_weights;
 }
 
+void LLSkinningUtil::skinPositions(
+    const LLMatrix4a* palette,
+    U32 palette_count,
+    const LLMeshSkinInfo* skin,
+    const LLVector4a* positions,
+    const LLVector4a* weights,
+    U32 count,
+    LLVector4a* dst)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
+
+    LLVertexTransform::skinPositions(palette, palette_count, skin->mBindShapeMatrix, positions, weights, count, dst);
+}
+
 void LLSkinningUtil::initJointNums(LLMeshSkinInfo* skin, LLVOAvatar *avatar)
 {
     if (!skin->mJointNumsInitialized)
@@ -48,10 +48,16 @@ namespace LLSkinningUtil
     void scrubSkinWeights(LLVector4a* weights, U32 num_vertices, const LLMeshSkinInfo* skin);
     void getPerVertexSkinMatrix(F32* weights, const LLMatrix4a* mat, bool handle_bad_scale, LLMatrix4a& final_mat, U32 max_joints);
 
+    // Skin count positions with a matrix palette (see LLVOAvatar::updateSkinInfoMatrixPalette())
+    // and the bind shape matrix of skin, writing the results to dst. Joint indices past the end
+    // of the palette are clamped to its last matrix. Uses the AVX2 kernel where available.
+    void skinPositions(const LLMatrix4a* palette, U32 palette_count, const LLMeshSkinInfo* skin,
+                       const LLVector4a* positions, const LLVector4a* weights, U32 count, LLVector4a* dst);
+
     LL_FORCE_INLINE void getPerVertexSkinMatrixWithIndices(
         F32*        weights,
         U8*         idx,
-        LLMatrix4a* mat,
+        const LLMatrix4a* mat,
         LLMatrix4a& final_mat,
         LLMatrix4a* src)
     {
@@ -465,6 +465,8 @@ void LLSpatialGroup::shift(const LLVector4a &offset)
     mObjectExtents[0].add(offset);
     mObjectExtents[1].add(offset);
 
+    getSpatialPartition()->updateLinearOctreeBounds(this);
+
     if (!getSpatialPartition()->mRenderByGroup &&
         getSpatialPartition()->mPartitionType != LLViewerRegion::PARTITION_TREE &&
         getSpatialPartition()->mPartitionType != LLViewerRegion::PARTITION_TERRAIN &&
@@ -588,7 +590,8 @@ LLSpatialGroup::LLSpatialGroup(OctreeNode* node, LLSpatialPartition* part) : LLO
     mDistance(0.f),
     mDepth(0.f),
     mLastUpdateDistance(-1.f),
-    mLastUpdateTime(gFrameTimeSeconds)
+    mLastUpdateTime(gFrameTimeSeconds),
+    mLinearIndex(LLSpatialPartition::linear_octree_t::INVALID_NODE)
 {
     ll_assert_aligned(this,16);
 
@@ -779,10 +782,12 @@ void LLSpatialGroup::handleInsertion(const TreeNode* node, LLViewerOctreeEntry*
     addObject((LLDrawable*)entry->getDrawable());
     unbound();
     setState(OBJECT_DIRTY);
+    getSpatialPartition()->dirtyLinearOctree();
 }
 
 void LLSpatialGroup::handleRemoval(const TreeNode* node, LLViewerOctreeEntry* entry)
 {
+    getSpatialPartition()->dirtyLinearOctree();
     removeObject((LLDrawable*)entry->getDrawable(), true);
     LLViewerOctreeGroup::handleRemoval(node, entry);
 }
@@ -813,6 +818,7 @@ void LLSpatialGroup::handleDestruction(const TreeNode* node)
     mBufferMap.clear();
     sZombieGroups++;
     mOctreeNode = NULL;
+    mLinearIndex = LLSpatialPartition::linear_octree_t::INVALID_NODE;
 }
 
 void LLSpatialGroup::handleChildAddition(const OctreeNode* parent, OctreeNode* child)
@@ -829,10 +835,17 @@ void LLSpatialGroup::handleChildAddition(const OctreeNode* parent, OctreeNode* c
     }
 
     unbound();
+    getSpatialPartition()->dirtyLinearOctree();
 
     assert_states_valid(this);
 }
 
+void LLSpatialGroup::handleChildRemoval(const OctreeNode* parent, const OctreeNode* child)
+{
+    super::handleChildRemoval(parent, child);
+    getSpatialPartition()->dirtyLinearOctree();
+}
+
 //virtual
 void LLSpatialGroup::rebound()
 {
@@ -867,6 +880,8 @@ void LLSpatialGroup::rebound()
             }
         }
     }
+
+    getSpatialPartition()->updateLinearOctreeBounds(this);
 }
 
 void LLSpatialGroup::destroyGLState(bool keep_occlusion)
@@ -931,6 +946,7 @@ LLSpatialPartition::LLSpatialPartition(U32 data_mask, bool render_by_group, LLVi
     mDepthMask = false;
     mSlopRatio = 0.25f;
     mInfiniteFarClip = false;
+    mLinearOctreeDirty = true;
 
     new LLSpatialGroup(mOctree, this);
 }
@@ -938,9 +954,38 @@ LLSpatialPartition::LLSpatialPartition(U32 data_mask, bool render_by_group, LLVi
 
 LLSpatialPartition::~LLSpatialPartition()
 {
+    // drop element references before the octree goes
+    mLinearOctree.clear();
     cleanup();
 }
 
+const LLSpatialPartition::linear_octree_t& LLSpatialPartition::getLinearOctree()
+{
+    if (mLinearOctreeDirty)
+    {
+        LL_PROFILE_ZONE_SCOPED_CATEGORY_SPATIAL;
+        mLinearOctreeDirty = false;
+        mLinearOctree.build(mOctree, [](const OctreeNode* node, U32 index, LLVector4a& center, LLVector4a& size)
+            {
+                LLSpatialGroup* group = (LLSpatialGroup*)node->getListener(0);
+                group->mLinearIndex = index;
+                center = group->getBounds()[0];
+                size = group->getBounds()[1];
+            });
+    }
+    return mLinearOctree;
+}
+
+void LLSpatialPartition::updateLinearOctreeBounds(const LLSpatialGroup* group)
+{
+    // Each group only writes its own slot and the arrays are only resized in
+    // getLinearOctree(), so this is safe for partitions culled on the cull threads.
+    if (!mLinearOctreeDirty)
+    {
+        mLinearOctree.setNodeBounds(group->mLinearIndex, group->getBounds()[0], group->getBounds()[1]);
+    }
+}
+
 LLSpatialGroup *LLSpatialPartition::put(LLDrawable *drawablep, bool was_visible)
 {
     LL_PROFILE_ZONE_SCOPED;
@@ -1077,7 +1122,16 @@ public:
     virtual S32 frustumCheck(const LLViewerOctreeGroup* group)
     {
         LL_PROFILE_ZONE_SCOPED;
-        S32 res = AABBInFrustumNoFarClipGroupBounds(group);
+        return frustumCheckBatched(group, AABBInFrustumNoFarClipGroupBounds(group));
+    }
+
+    virtual eBatchedCheck getBatchedCheck() const
+    {
+        return BATCH_FRUSTUM_NO_FAR_CLIP;
+    }
+
+    virtual S32 frustumCheckBatched(const LLViewerOctreeGroup* group, S32 res)
+    {
         if (res != 0)
         {
             res = llmin(res, AABBSphereIntersectGroupExtents(group));
@@ -1120,6 +1174,11 @@ public:
         return AABBInFrustumNoFarClipGroupBounds(group);
     }
 
+    virtual S32 frustumCheckBatched(const LLViewerOctreeGroup* group, S32 res)
+    {
+        return res;
+    }
+
     virtual S32 frustumCheckObjects(const LLViewerOctreeGroup* group)
     {
         S32 res = AABBInFrustumNoFarClipObjectBounds(group);
@@ -1138,6 +1197,16 @@ public:
         return AABBInFrustumGroupBounds(group);
     }
 
+    virtual eBatchedCheck getBatchedCheck() const
+    {
+        return BATCH_FRUSTUM;
+    }
+
+    virtual S32 frustumCheckBatched(const LLViewerOctreeGroup* group, S32 res)
+    {
+        return res;
+    }
+
     virtual S32 frustumCheckObjects(const LLViewerOctreeGroup* group)
     {
         return AABBInFrustumObjectBounds(group);
@@ -3827,6 +3896,7 @@ public:
     bool mPickRigged;
     bool mPickUnselectable;
     bool mPickReflectionProbe;
+    bool mUseLinearOctree;
 
     LLOctreeIntersect(const LLVector4a& start, const LLVector4a& end, bool pick_transparent, bool pick_rigged, bool pick_unselectable, bool pick_reflection_probe,
                       S32* face_hit, LLVector4a* intersection, LLVector2* tex_coord, LLVector4a* normal, LLVector4a* tangent)
@@ -3843,6 +3913,8 @@ public:
           mPickUnselectable(pick_unselectable),
           mPickReflectionProbe(pick_reflection_probe)
     {
+        static LLCachedControl<bool> linear_raycast(gSavedSettings, "OctreeLinearRaycast", true);
+        mUseLinearOctree = linear_raycast;
     }
 
     virtual void visit(const OctreeNode* branch)
@@ -3950,6 +4022,47 @@ public:
         return mHit;
     }
 
+    // Same as check(part->mOctree), using the packed copy of the tree. Element
+    // references are held by the copy, so changes to the tree made by the
+    // intersection tests below can't invalidate the traversal.
+    LLDrawable* check(LLSpatialPartition* part)
+    {
+        LLMatrix4a local_matrix4a;
+        const bool is_bridge = part->isBridge();
+        if (is_bridge)
+        {
+            LLMatrix4 local_matrix = part->asBridge()->mDrawable->getRenderMatrix();
+            local_matrix.invert();
+            local_matrix4a.loadu(local_matrix);
+        }
+
+        part->getLinearOctree().traverse(
+            [&](U32 index, const LLVector4a& center, const LLVector4a& size) -> S32
+            {
+                if (index == 0)
+                { // root elements are always checked
+                    return LLSpatialPartition::linear_octree_t::NODE_PARTIAL;
+                }
+
+                LLVector4a local_start = mStart;
+                LLVector4a local_end = mEnd;
+                if (is_bridge)
+                {
+                    local_matrix4a.affineTransform(mStart, local_start);
+                    local_matrix4a.affineTransform(mEnd, local_end);
+                }
+
+                return LLLineSegmentBoxIntersect(local_start, local_end, center, size) ?
+                    LLSpatialPartition::linear_octree_t::NODE_PARTIAL : LLSpatialPartition::linear_octree_t::NODE_OUTSIDE;
+            },
+            [&](LLViewerOctreeEntry* entry)
+            {
+                check(entry);
+            });
+
+        return mHit;
+    }
+
     virtual bool check(LLViewerOctreeEntry* entry)
     {
         LLDrawable* drawable = (LLDrawable*)entry->getDrawable();
@@ -3965,7 +4078,14 @@ public:
             LLSpatialBridge* bridge = part->asBridge();
             if (bridge && gPipeline.hasRenderType(bridge->mDrawableType))
             {
-                check(part->mOctree);
+                if (mUseLinearOctree)
+                {
+                    check(part);
+                }
+                else
+                {
+                    check(part->mOctree);
+                }
             }
         }
         else
@@ -4036,7 +4156,7 @@ LLDrawable* LLSpatialPartition::lineSegmentIntersect(const LLVector4a& start, co
 
 {
     LLOctreeIntersect intersect(start, end, pick_transparent, pick_rigged, pick_unselectable, pick_reflection_probe, face_hit, intersection, tex_coord, normal, tangent);
-    LLDrawable* drawable = intersect.check(mOctree);
+    LLDrawable* drawable = intersect.mUseLinearOctree ? intersect.check(this) : intersect.check(mOctree);
 
     return drawable;
 }
@@ -4403,6 +4523,38 @@ void LLCullResult::pushDrawInfo(U32 type, LLDrawInfo* draw_info)
 }
 
 
+void LLCullResult::append(LLCullResult& other)
+{
+    for (sg_iterator iter = other.beginVisibleGroups(); iter != other.endVisibleGroups(); ++iter)
+    {
+        pushVisibleGroup(*iter);
+    }
+    for (sg_iterator iter = other.beginAlphaGroups(); iter != other.endAlphaGroups(); ++iter)
+    {
+        pushAlphaGroup(*iter);
+    }
+    for (sg_iterator iter = other.beginRiggedAlphaGroups(); iter != other.endRiggedAlphaGroups(); ++iter)
+    {
+        pushRiggedAlphaGroup(*iter);
+    }
+    for (sg_iterator iter = other.beginOcclusionGroups(); iter != other.endOcclusionGroups(); ++iter)
+    {
+        pushOcclusionGroup(*iter);
+    }
+    for (sg_iterator iter = other.beginDrawableGroups(); iter != other.endDrawableGroups(); ++iter)
+    {
+        pushDrawableGroup(*iter);
+    }
+    for (drawable_iterator iter = other.beginVisibleList(); iter != other.endVisibleList(); ++iter)
+    {
+        pushDrawable(*iter);
+    }
+    for (bridge_iterator iter = other.beginVisibleBridge(); iter != other.endVisibleBridge(); ++iter)
+    {
+        pushBridge(*iter);
+    }
+}
+
 void LLCullResult::assertDrawMapsEmpty()
 {
     for (U32 i = 0; i < LLRenderPass::NUM_RENDER_TYPES; i++)
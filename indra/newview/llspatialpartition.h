@@ -31,6 +31,7 @@
 
 #include "lldrawable.h"
 #include "lloctree.h"
+#include "lloctreelinear.h"
 #include "llpointer.h"
 #include "llrefcount.h"
 #include "llvertexbuffer.h"
@@ -346,6 +347,7 @@ public:
     virtual void handleRemoval(const TreeNode* node, LLViewerOctreeEntry* face);
     virtual void handleDestruction(const TreeNode* node);
     virtual void handleChildAddition(const OctreeNode* parent, OctreeNode* child);
+    virtual void handleChildRemoval(const OctreeNode* parent, const OctreeNode* child);
 
     // LLViewerOctreeGroup
     virtual void rebound();
@@ -364,6 +366,8 @@ public:
     bridge_list_t mBridgeList;
     buffer_map_t mBufferMap; //used by volume buffers to attempt to reuse vertex buffers
 
+    U32 mLinearIndex; // index of this group's node in LLSpatialPartition::mLinearOctree
+
     F32 mObjectBoxSize; //cached mObjectBounds[1].getLength3()
     U32 mGeometryBytes; //used by volumes to track how many bytes of geometry data are in this node
     F32 mSurfaceArea; //used by volumes to track estimated surface area of geometry in this node
@@ -444,6 +448,14 @@ public:
 
     bool getVisibleExtents(LLCamera& camera, LLVector3& visMin, LLVector3& visMax);
 
+    typedef LLOctreeLinear<LLViewerOctreeEntry, LLPointer<LLViewerOctreeEntry> > linear_octree_t;
+
+    // Packed copy of mOctree for read only traversals, rebuilt here if
+    // nodes or elements were added or removed since the last call.
+    const linear_octree_t& getLinearOctree();
+    void dirtyLinearOctree() { mLinearOctreeDirty = true; }
+    void updateLinearOctreeBounds(const LLSpatialGroup* group);
+
 public:
     LLSpatialBridge* mBridge; // NULL for non-LLSpatialBridge instances, otherwise, mBridge == this
                             // use a pointer instead of making "isBridge" and "asBridge" virtual so it's safe
@@ -454,6 +466,10 @@ public:
     U32 mVertexDataMask;
     F32 mSlopRatio; //percentage distance must change before drawables receive LOD update (default is 0.25);
     bool mDepthMask; //if true, objects in this partition will be written to depth during alpha rendering
+
+protected:
+    linear_octree_t mLinearOctree;
+    bool mLinearOctreeDirty;
 };
 
 // class for creating bridges between spatial partitions
@@ -557,6 +573,10 @@ public:
     void pushBridge(LLSpatialBridge* bridge);
     void pushDrawInfo(U32 type, LLDrawInfo* draw_info);
 
+    // Append the visible groups, drawables and bridges of other, used to
+    // merge the results of partitions culled on different threads.
+    void append(LLCullResult& other);
+
     U32 getVisibleGroupsSize()      { return mVisibleGroupsSize; }
     U32 getAlphaGroupsSize()        { return mAlphaGroupsSize; }
     U32 getRiggedAlphaGroupsSize() { return mRiggedAlphaGroupsSize; }
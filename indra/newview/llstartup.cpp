@@ -878,6 +878,12 @@ bool idle_startup()
                 LLAppViewer::instance()->earlyExit("LoginFailedNoNetwork", LLSD().with("DIAGNOSTIC", diagnostic));
             }
 
+            const std::string capture_file = gSavedSettings.getString("NetCaptureFile");
+            if (!capture_file.empty() && gMessageSystem)
+            {
+                gMessageSystem->startCapture(capture_file);
+            }
+
             #if LL_WINDOWS
                 // On the windows dev builds, unpackaged, the message.xml file will
                 // be located in indra/build-vc**/newview/<config>/app_settings.
@@ -2228,6 +2234,7 @@ bool idle_startup()
             gMessageSystem->setTimeDecodes( true );             // Time the decode of each msg
             gMessageSystem->setTimeDecodesSpamThreshold( 0.05f );  // Spam if a single msg takes over 50ms to decode
         #endif
+        LLMessageSystem::setProfileTemplates(gSavedSettings.getBOOL("MessageTemplateProfiling")); // Per message decode/handler profile
         do_startup_frame();
 
         gXferManager->registerCallbacks(gMessageSystem);
@@ -3274,6 +3281,21 @@ bool idle_startup()
             gAgentPilot.startPlayback();
         }
 
+        // Feed a recorded network capture through the message system if requested.
+        // Only now: the handlers apply the updates to the regions login set up.
+        const std::string playback_file = gSavedSettings.getString("NetPlaybackFile");
+        if (!playback_file.empty())
+        {
+            gMessageSystem->startPlayback(playback_file, gSavedSettings.getF32("NetPlaybackSpeed"),
+                []()
+                {
+                    if (gSavedSettings.getBOOL("NetPlaybackQuit"))
+                    {
+                        LLAppViewer::instance()->forceQuit();
+                    }
+                });
+        }
+
         show_debug_menus(); // Debug menu visiblity and First Use trigger
 
         // If we've got a startup URL, dispatch it
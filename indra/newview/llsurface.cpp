@@ -796,6 +796,8 @@ bool LLSurface::idleUpdate(F32 max_update_time)
         getRegion()->dirtyHeights();
     }
 
+    static LLCachedControl<bool> background_generation(gSavedSettings, "TerrainBackgroundPatchGeneration", true);
+
     // Always call updateNormals() / updateVerticalStats()
     //  every frame to avoid artifacts
     for(std::set<LLSurfacePatch *>::iterator iter = mDirtyPatchList.begin();
@@ -803,8 +805,21 @@ bool LLSurface::idleUpdate(F32 max_update_time)
     {
         std::set<LLSurfacePatch *>::iterator curiter = iter++;
         LLSurfacePatch *patchp = *curiter;
+        if (background_generation)
+        {
+            // Edges and corners read neighboring patches (and regions), so
+            // they stay here. The interior normals and the height stats only
+            // depend on this patch and are generated on the worker.
+            patchp->updateNormals<PBR>(true);
+            patchp->queueGeneration<PBR>();
+        }
         patchp->updateNormals<PBR>();
         patchp->updateVerticalStats();
+        if (patchp->isGenerationPending())
+        {
+            // Don't rebuild the geometry until the worker hands back the patch data
+            continue;
+        }
         if (max_update_time == 0.f || update_timer.getElapsedTimeF32() < max_update_time)
         {
             if (patchp->updateTexture())
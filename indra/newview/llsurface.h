@@ -41,6 +41,7 @@
 #include "llvowater.h"
 #include "llpatchvertexarray.h"
 #include "llviewertexture.h"
+#include "llhandle.h"
 
 class LLTimer;
 class LLUUID;
@@ -63,7 +64,7 @@ class LLSurfacePatch;
 class LLBitPack;
 class LLGroupHeader;
 
-class LLSurface
+class LLSurface : public LLHandleProvider<LLSurface>
 {
 public:
     LLSurface(U32 type, LLViewerRegion *regionp = NULL);
@@ -42,6 +42,7 @@
 #include "llvlcomposition.h"
 #include "lldrawpool.h"
 #include "noise.h"
+#include "workqueue.h"
 
 extern bool gShiftFrame;
 extern U64MicrosecondsImplicit gFrameTime;
@@ -53,6 +54,8 @@ LLSurfacePatch::LLSurfacePatch()
     mDirty(false),
     mDirtyZStats(true),
     mHeightsGenerated(false),
+    mGenSerial(0),
+    mGenAppliedSerial(0),
     mDataOffset(0),
     mDataZ(NULL),
     mDataNorm(NULL),
@@ -618,7 +621,6 @@ void LLSurfacePatch::updateVerticalStats()
 
     U32 grids_per_patch_edge = mSurfacep->getGridsPerPatchEdge();
     U32 grids_per_edge = mSurfacep->getGridsPerEdge();
-    F32 meters_per_grid = mSurfacep->getMetersPerGrid();
 
     U32 i, j, k;
     F32 z, total;
@@ -651,7 +653,18 @@ void LLSurfacePatch::updateVerticalStats()
             k++;
         }
     }
-    mMeanZ = total / (F32) k;
+    setVerticalStats(mMinZ, mMaxZ, total / (F32) k);
+    mDirtyZStats = false;
+}
+
+void LLSurfacePatch::setVerticalStats(F32 min_z, F32 max_z, F32 mean_z)
+{
+    U32 grids_per_patch_edge = mSurfacep->getGridsPerPatchEdge();
+    F32 meters_per_grid = mSurfacep->getMetersPerGrid();
+
+    mMinZ = min_z;
+    mMaxZ = max_z;
+    mMeanZ = mean_z;
     mCenterRegion.mV[VZ] = 0.5f * (mMinZ + mMaxZ);
 
     LLVector3 diam_vec(meters_per_grid*grids_per_patch_edge,
@@ -668,12 +681,11 @@ void LLSurfacePatch::updateVerticalStats()
     {
         mVObjp->dirtyPatch();
     }
-    mDirtyZStats = false;
 }
 
 
 template<bool PBR>
-void LLSurfacePatch::updateNormals()
+void LLSurfacePatch::updateNormals(bool skip_interior)
 {
     if (mSurfacep->mType == 'w')
     {
@@ -868,7 +880,7 @@ void LLSurfacePatch::updateNormals()
     }
 
     // update the middle normals
-    if (mNormalsInvalid[MIDDLE])
+    if (mNormalsInvalid[MIDDLE] && !skip_interior)
     {
         for (j=2; j < grids_per_patch_edge - 2; j++)
         {
@@ -887,12 +899,170 @@ void LLSurfacePatch::updateNormals()
 
     for (i = 0; i < 9; i++)
     {
-        mNormalsInvalid[i] = false;
+        if (i != MIDDLE || !skip_interior)
+        {
+            mNormalsInvalid[i] = false;
+        }
+    }
+}
+
+template void LLSurfacePatch::updateNormals</*PBR=*/false>(bool skip_interior);
+template void LLSurfacePatch::updateNormals</*PBR=*/true>(bool skip_interior);
+
+template<bool PBR>
+void LLSurfacePatchGenData::generate()
+{
+    LL_PROFILE_ZONE_SCOPED;
+    const U32 row = mGridsPerPatchEdge + 1;
+    llassert(mDataZ.size() == row * row);
+
+    // Same as LLSurfacePatch::updateVerticalStats()
+    F32 total = 0.f;
+    mMinZ = mDataZ[0];
+    mMaxZ = mDataZ[0];
+    for (F32 z : mDataZ)
+    {
+        mMinZ = llmin(mMinZ, z);
+        mMaxZ = llmax(mMaxZ, z);
+        total += z;
+    }
+    mMeanZ = total / (F32) mDataZ.size();
+
+    // Same as the MIDDLE block of LLSurfacePatch::updateNormals().  The
+    // interior never reaches past the patch, so no neighbor lookups are
+    // needed.
+    mDataNorm.resize(row * row);
+    if (mGridsPerPatchEdge < 4)
+    {
+        return;
+    }
+
+    constexpr U32 stride = PBR ? 1 : 2;
+    const F32 mpg = mMetersPerGrid * stride;
+    for (U32 j = 2; j < mGridsPerPatchEdge - 2; j++)
+    {
+        for (U32 i = 2; i < mGridsPerPatchEdge - 2; i++)
+        {
+            LLVector3 normal;
+            if (PBR)
+            {
+                // calcNormalFlat(), index 0
+                LLVector3 p00(-mpg, -mpg, mDataZ[i + j * row]);
+                LLVector3 p01(-mpg, +mpg, mDataZ[i + (j + stride) * row]);
+                LLVector3 p10(+mpg, -mpg, mDataZ[i + stride + j * row]);
+
+                normal = p10 - p00;
+                normal %= p01 - p00;
+            }
+            else
+            {
+                LLVector3 p00(-mpg, -mpg, mDataZ[i - stride + (j - stride) * row]);
+                LLVector3 p01(-mpg, +mpg, mDataZ[i - stride + (j + stride) * row]);
+                LLVector3 p10(+mpg, -mpg, mDataZ[i + stride + (j - stride) * row]);
+                LLVector3 p11(+mpg, +mpg, mDataZ[i + stride + (j + stride) * row]);
+
+                normal = p11 - p00;
+                normal %= p01 - p10;
+            }
+            normal.normVec();
+            mDataNorm[i + j * row] = normal;
+        }
+    }
+}
+
+template<bool PBR>
+bool LLSurfacePatch::queueGeneration()
+{
+    if (mSurfacep->mType == 'w' || !(mNormalsInvalid[MIDDLE] || mDirtyZStats))
+    {
+        return false;
+    }
+
+    LL::WorkQueue::ptr_t main_queue = LL::WorkQueue::getInstance("mainloop");
+    LL::WorkQueue::ptr_t general_queue = LL::WorkQueue::getInstance("General");
+    if (!main_queue || !general_queue)
+    {
+        return false;
+    }
+
+    const U32 grids_per_patch_edge = mSurfacep->getGridsPerPatchEdge();
+    const U32 grids_per_edge = mSurfacep->getGridsPerEdge();
+    const U32 row = grids_per_patch_edge + 1;
+
+    LLSurfacePatchGenData data;
+    data.mSerial = mGenSerial + 1;
+    data.mGridsPerPatchEdge = grids_per_patch_edge;
+    data.mMetersPerGrid = mSurfacep->getMetersPerGrid();
+    data.mDataZ.resize(row * row);
+    for (U32 j = 0; j < row; j++)
+    {
+        memcpy(&data.mDataZ[j * row], mDataZ + j * grids_per_edge, row * sizeof(F32));
     }
+
+    // The surface may go away (region disconnect) before the worker is done,
+    // so find the patch again through a handle rather than holding on to it.
+    LLHandle<LLSurface> surface_handle = mSurfacep->getHandle();
+    const S32 patch_index = (S32)(this - mSurfacep->mPatchList);
+
+    bool posted = main_queue->postTo(
+        general_queue,
+        [data = std::move(data)]() mutable // Work done on general queue
+        {
+            data.generate<PBR>();
+            return std::move(data);
+        },
+        [surface_handle, patch_index](LLSurfacePatchGenData data) // Callback to main thread
+        {
+            LLSurface* surfacep = surface_handle.get();
+            if (surfacep && surfacep->mPatchList && patch_index < surfacep->mNumberOfPatches)
+            {
+                surfacep->mPatchList[patch_index].applyGeneratedData(data);
+            }
+        });
+
+    if (!posted)
+    {
+        return false;
+    }
+
+    mGenSerial++;
+    mNormalsInvalid[MIDDLE] = false;
+    mDirtyZStats = false;
+    return true;
 }
 
-template void LLSurfacePatch::updateNormals</*PBR=*/false>();
-template void LLSurfacePatch::updateNormals</*PBR=*/true>();
+template bool LLSurfacePatch::queueGeneration</*PBR=*/false>();
+template bool LLSurfacePatch::queueGeneration</*PBR=*/true>();
+
+void LLSurfacePatch::applyGeneratedData(const LLSurfacePatchGenData& data)
+{
+    if (data.mSerial != mGenSerial)
+    {
+        // Heights changed again since this snapshot, a newer one is in flight
+        return;
+    }
+    mGenAppliedSerial = mGenSerial;
+
+    const U32 grids_per_patch_edge = mSurfacep->getGridsPerPatchEdge();
+    if (grids_per_patch_edge != data.mGridsPerPatchEdge)
+    {
+        return;
+    }
+
+    const U32 grids_per_edge = mSurfacep->getGridsPerEdge();
+    const U32 row = grids_per_patch_edge + 1;
+    if (grids_per_patch_edge >= 4)
+    {
+        for (U32 j = 2; j < grids_per_patch_edge - 2; j++)
+        {
+            memcpy(mDataNorm + 2 + j * grids_per_edge, &data.mDataNorm[2 + j * row],
+                   (grids_per_patch_edge - 4) * sizeof(LLVector3));
+        }
+    }
+
+    setVerticalStats(data.mMinZ, data.mMaxZ, data.mMeanZ);
+    mSurfacep->dirtySurfacePatch(this);
+}
 
 void LLSurfacePatch::updateEastEdge()
 {
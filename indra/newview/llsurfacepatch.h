@@ -37,6 +37,28 @@ class LLVector2;
 class LLColor4U;
 class LLAgent;
 
+// Copy of a patch's height field, handed to a worker thread so that the
+// interior normals and the height stats can be generated off the main
+// thread.  Only the worker touches it until it is returned to the patch
+// through LLSurfacePatch::applyGeneratedData().
+struct LLSurfacePatchGenData
+{
+    U32 mSerial = 0;                // LLSurfacePatch::mGenSerial at snapshot time
+    U32 mGridsPerPatchEdge = 0;
+    F32 mMetersPerGrid = 1.f;
+
+    // (mGridsPerPatchEdge + 1)^2 values, row stride mGridsPerPatchEdge + 1
+    std::vector<F32> mDataZ;
+    std::vector<LLVector3> mDataNorm; // only the interior is generated
+
+    F32 mMinZ = 0.f;
+    F32 mMaxZ = 0.f;
+    F32 mMeanZ = 0.f;
+
+    template<bool PBR>
+    void generate();
+};
+
 // A patch shouldn't know about its visibility since that really depends on the
 // camera that is looking (or not looking) at it.  So, anything about a patch
 // that is specific to a camera should be in the class below.
@@ -77,8 +99,18 @@ public:
 
     void updateVerticalStats();
     void updateCompositionStats();
+    // Recompute invalid normals.  If skip_interior is true, the interior
+    // normals are left invalid for queueGeneration() to pick up.
+    template<bool PBR>
+    void updateNormals(bool skip_interior = false);
+
+    // Snapshot the heights and post interior normal and vertical stats
+    // generation to the "General" thread pool.  Returns false if there
+    // was nothing to generate or the work could not be posted.
     template<bool PBR>
-    void updateNormals();
+    bool queueGeneration();
+    void applyGeneratedData(const LLSurfacePatchGenData& data);
+    bool isGenerationPending() const            { return mGenSerial != mGenAppliedSerial; }
 
     void updateEastEdge();
     void updateNorthEdge();
@@ -154,6 +186,9 @@ public:
     bool mHasReceivedData;  // has the patch EVER received height data?
     bool mSTexUpdate;       // Does the surface texture need to be updated?
 
+protected:
+    void setVerticalStats(F32 min_z, F32 max_z, F32 mean_z);
+
 protected:
     LLSurfacePatch *mNeighborPatches[8]; // Adjacent patches
     bool mNormalsInvalid[9];  // Which normals are invalid
@@ -162,6 +197,9 @@ protected:
     bool mDirtyZStats;
     bool mHeightsGenerated;
 
+    U32 mGenSerial;         // Serial of the last snapshot posted to the worker
+    U32 mGenAppliedSerial;  // Serial of the last worker result applied
+
     U32 mDataOffset;
     F32 *mDataZ;
     LLVector3 *mDataNorm;
@@ -193,8 +231,10 @@ protected:
     LLSurface *mSurfacep; // Pointer to "parent" surface
 };
 
-extern template void LLSurfacePatch::updateNormals</*PBR=*/false>();
-extern template void LLSurfacePatch::updateNormals</*PBR=*/true>();
+extern template void LLSurfacePatch::updateNormals</*PBR=*/false>(bool skip_interior);
+extern template void LLSurfacePatch::updateNormals</*PBR=*/true>(bool skip_interior);
+extern template bool LLSurfacePatch::queueGeneration</*PBR=*/false>();
+extern template bool LLSurfacePatch::queueGeneration</*PBR=*/true>();
 
 
 #endif // LL_LLSURFACEPATCH_H
@@ -42,6 +42,7 @@
 #include "message.h"
 
 #include "llagent.h"
+#include "llinterestmanager.h"
 #include "lltexturecache.h"
 #include "llviewercontrol.h"
 #include "llviewertexturelist.h"
@@ -3436,6 +3437,9 @@ void LLTextureFetch::sendRequestListToSimulators()
         }
     }                                                                   // -Mfnq
 
+    LLInterestManager* interest = LLInterestManager::getInstance();
+    S32 deferred_requests = 0;
+
     for (work_request_map_t::iterator iter1 = requests.begin();
          iter1 != requests.end(); ++iter1)
     {
@@ -3447,11 +3451,19 @@ void LLTextureFetch::sendRequestListToSimulators()
         }
 
         S32 sim_request_count = 0;
+        S32 rank = 0;
 
+        // Requests are sorted by decreasing priority (screen space size)
         for (request_list_t::iterator iter2 = iter1->second.begin();
-             iter2 != iter1->second.end(); ++iter2)
+             iter2 != iter1->second.end(); ++iter2, ++rank)
         {
             LLTextureFetchWorker* req = *iter2;
+            if (interest->shouldDeferImageRequest(req->mImagePriority, rank))
+            {
+                // Left in mNetworkQueue, reconsidered on the next pass
+                deferred_requests++;
+                continue;
+            }
             if (gMessageSystem)
             {
                 if (req->mSentRequest != LLTextureFetchWorker::SENT_SIM)
@@ -3512,6 +3524,10 @@ void LLTextureFetch::sendRequestListToSimulators()
             sim_request_count = 0;
         }
     }
+    if (deferred_requests > 0)
+    {
+        add(LLStatViewer::IMAGE_REQUESTS_DEFERRED, deferred_requests);
+    }
 
     // Send cancelations
     {
@@ -34,12 +34,18 @@
 #include "lluuid.h"
 #include "lltrans.h"
 #include "llviewborder.h"
+#include "llviewercontrol.h"
 #include "llviewertexture.h"
 #include "llviewertexturelist.h"
 #include "llwindow.h"
 
 static LLDefaultChildRegistry::Register<LLThumbnailCtrl> r("thumbnail");
 
+// Thumbnails not drawn for this long stop loading
+const F64 STOP_LOADING_DELAY = 1.0; // seconds
+
+LLThumbnailCtrl::thumbnail_list_t LLThumbnailCtrl::sLoadedThumbnails;
+
 LLThumbnailCtrl::Params::Params()
 : border("border")
 , border_color("border_color")
@@ -59,6 +65,9 @@ LLThumbnailCtrl::LLThumbnailCtrl(const LLThumbnailCtrl::Params& p)
 ,   mShowLoadingPlaceholder(p.show_loading())
 ,   mInited(false)
 ,   mInitImmediately(true)
+,   mIsLoaded(false)
+,   mLastDrawFrame(0)
+,   mLastDrawTime(0.0)
 {
     mLoadingPlaceholderString = LLTrans::getString("texture_loading");
 
@@ -77,6 +86,10 @@ LLThumbnailCtrl::LLThumbnailCtrl(const LLThumbnailCtrl::Params& p)
 
 LLThumbnailCtrl::~LLThumbnailCtrl()
 {
+    if (mIsLoaded)
+    {
+        sLoadedThumbnails.erase(mLoadedIter);
+    }
     mTexturep = nullptr;
     mImagep = nullptr;
     mFallbackImagep = nullptr;
@@ -89,6 +102,13 @@ void LLThumbnailCtrl::draw()
     {
         initImage();
     }
+    if (mIsLoaded)
+    {
+        sLoadedThumbnails.splice(sLoadedThumbnails.begin(), sLoadedThumbnails, mLoadedIter);
+        mLastDrawFrame = LLFrameTimer::getFrameCount();
+        mLastDrawTime = LLFrameTimer::getElapsedSeconds();
+        trimLoadedThumbnails();
+    }
     LLRect draw_rect = getLocalRect();
 
     if (mBorderVisible)
@@ -244,6 +264,9 @@ void LLThumbnailCtrl::initImage()
             S32 desired_draw_width = MAX_IMAGE_SIZE;
             S32 desired_draw_height = MAX_IMAGE_SIZE;
             mTexturep->setKnownDrawSize(desired_draw_width, desired_draw_height);
+
+            mLoadedIter = sLoadedThumbnails.insert(sLoadedThumbnails.begin(), this);
+            mIsLoaded = true;
         }
     }
     else if (tvalue.isString())
@@ -262,10 +285,54 @@ void LLThumbnailCtrl::initImage()
 
 void LLThumbnailCtrl::unloadImage()
 {
+    if (mIsLoaded)
+    {
+        sLoadedThumbnails.erase(mLoadedIter);
+        mIsLoaded = false;
+    }
     mImageAssetID = LLUUID::null;
     mTexturep = nullptr;
     mImagep = nullptr;
     mInited = false;
 }
 
+// static
+void LLThumbnailCtrl::trimLoadedThumbnails()
+{
+    static U32 last_trim_frame = 0;
+    const U32 frame = LLFrameTimer::getFrameCount();
+    if (frame == last_trim_frame)
+    {
+        return;
+    }
+    last_trim_frame = frame;
+
+    static LLCachedControl<U32> texture_budget(gSavedSettings, "ThumbnailTextureBudget", 256);
+    const F64 now = LLFrameTimer::getElapsedSeconds();
 
+    // Walk from the thumbnail drawn longest ago up to the ones on screen,
+    // which were drawn this frame or the last one and are always kept.
+    // Unloaded controls load their thumbnail again when next drawn.
+    thumbnail_list_t::iterator iter = sLoadedThumbnails.end();
+    while (iter != sLoadedThumbnails.begin())
+    {
+        LLThumbnailCtrl* thumbnailp = *(--iter);
+        if (thumbnailp->mLastDrawFrame + 1 >= frame)
+        {
+            break;
+        }
+
+        const bool over_budget = sLoadedThumbnails.size() > texture_budget();
+        const bool scrolled_away = now - thumbnailp->mLastDrawTime > STOP_LOADING_DELAY
+            && thumbnailp->mTexturep.notNull()
+            && !thumbnailp->mTexturep->isFullyLoaded();
+        if (over_budget || scrolled_away)
+        {
+            // Dropping the last reference lets the texture list cancel the
+            // fetch and free the texture
+            iter = sLoadedThumbnails.erase(iter);
+            thumbnailp->mIsLoaded = false;
+            thumbnailp->unloadImage();
+        }
+    }
+}
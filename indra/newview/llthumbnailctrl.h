@@ -27,6 +27,8 @@
 #ifndef LL_LLTHUMBNAILCTRL_H
 #define LL_LLTHUMBNAILCTRL_H
 
+#include <list>
+
 #include "llui.h"
 #include "lluictrl.h"
 #include "llviewborder.h" // for params
@@ -77,6 +79,18 @@ protected:
     void unloadImage();
 
 private:
+    // Releases the thumbnails drawn longest ago past the texture budget,
+    // and those scrolled away before they finished loading
+    static void trimLoadedThumbnails();
+
+    // Controls holding a thumbnail texture, most recently drawn first
+    typedef std::list<LLThumbnailCtrl*> thumbnail_list_t;
+    static thumbnail_list_t sLoadedThumbnails;
+    thumbnail_list_t::iterator mLoadedIter;
+    bool mIsLoaded;
+    U32 mLastDrawFrame;
+    F64 mLastDrawTime;
+
     bool mBorderVisible;
     bool mInteractable;
     bool mShowLoadingPlaceholder;
@@ -59,6 +59,7 @@
 #include "llvoiceclient.h"
 #include "llvotree.h"
 #include "llvovolume.h"
+#include "llvolumebvh.h"
 #include "llworld.h"
 #include "llvlcomposition.h"
 #include "pipeline.h"
@@ -442,6 +443,12 @@ static bool handleFlexLODChanged(const LLSD& newvalue)
     return true;
 }
 
+static bool handleRaycastFaceBVHChanged(const LLSD& newvalue)
+{
+    LLVolumeBVH::sUseBVH = newvalue.asBoolean();
+    return true;
+}
+
 static bool handleGammaChanged(const LLSD& newvalue)
 {
     F32 gamma = (F32) newvalue.asReal();
@@ -1304,6 +1311,7 @@ void settings_setup_listeners()
     setting_setup_signal_listener(gSavedSettings, "RenderTerrainLODFactor", handleTerrainLODChanged);
     setting_setup_signal_listener(gSavedSettings, "RenderTreeLODFactor", handleTreeLODChanged);
     setting_setup_signal_listener(gSavedSettings, "RenderFlexTimeFactor", handleFlexLODChanged);
+    setting_setup_signal_listener(gSavedSettings, "RaycastFaceBVH", handleRaycastFaceBVHChanged);
     setting_setup_signal_listener(gSavedSettings, "RenderGamma", handleGammaChanged);
     setting_setup_signal_listener(gSavedSettings, "RenderFogRatio", handleFogRatioChanged);
     setting_setup_signal_listener(gSavedSettings, "RenderMaxPartCount", handleMaxPartCountChanged);
@@ -2634,7 +2634,14 @@ LLViewerInventoryItem *LLViewerInventoryItem::getLinkedItem() const
 {
     if (mType == LLAssetType::AT_LINK)
     {
-        LLViewerInventoryItem *linked_item = gInventory.getItem(mAssetUUID);
+        // Nearly every accessor of a link comes through here: resolve the
+        // handle, and the UUID only when the target moved or changed.
+        LLViewerInventoryItem *linked_item = gInventory.getItem(mLinkedHandle);
+        if (!linked_item || linked_item->getUUID() != mAssetUUID)
+        {
+            mLinkedHandle = gInventory.getItemHandle(mAssetUUID);
+            linked_item = gInventory.getItem(mLinkedHandle);
+        }
         if (linked_item && linked_item->getIsLinkType())
         {
             LL_WARNS(LOG_INV) << "Warning: Accessing link to link" << LL_ENDL;
@@ -2649,7 +2656,12 @@ LLViewerInventoryCategory *LLViewerInventoryItem::getLinkedCategory() const
 {
     if (mType == LLAssetType::AT_LINK_FOLDER)
     {
-        LLViewerInventoryCategory *linked_category = gInventory.getCategory(mAssetUUID);
+        LLViewerInventoryCategory *linked_category = gInventory.getCategory(mLinkedHandle);
+        if (!linked_category || linked_category->getUUID() != mAssetUUID)
+        {
+            mLinkedHandle = gInventory.getCategoryHandle(mAssetUUID);
+            linked_category = gInventory.getCategory(mLinkedHandle);
+        }
         return linked_category;
     }
     return NULL;
@@ -28,6 +28,7 @@
 #define LL_LLVIEWERINVENTORY_H
 
 #include "llinventory.h"
+#include "llinventorystore.h"
 #include "llframetimer.h"
 #include "llwearable.h"
 #include "llinitdestroyclass.h" //for LLDestroyClass
@@ -166,6 +167,10 @@ public:
 public:
     bool mIsComplete;
     LLTransactionID mTransactionID;
+
+private:
+    // Where the target of a link was last found in gInventory
+    mutable LLInventoryHandle mLinkedHandle;
 };
 
 
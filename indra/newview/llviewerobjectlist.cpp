@@ -48,6 +48,7 @@
 #include "llstring.h"
 #include "llhudicon.h"
 #include "llhudnametag.h"
+#include "llinterestmanager.h"
 #include "lldrawable.h"
 #include "llflexibleobject.h"
 #include "llviewertextureanim.h"
@@ -154,7 +155,8 @@ void LLViewerObjectList::getUUIDFromLocal(LLUUID &id,
 
     U64 indexid = (((U64)index) << 32) | (U64)local_id;
 
-    id = get_if_there(mIndexAndLocalIDToUUID, indexid, LLUUID::null);
+    index_uuid_map_t::const_iterator iter = mIndexAndLocalIDToUUID.find(indexid);
+    id = (iter != mIndexAndLocalIDToUUID.end()) ? iter->second : LLUUID::null;
 }
 
 U64 LLViewerObjectList::getIndex(const U32 local_id,
@@ -182,7 +184,7 @@ bool LLViewerObjectList::removeFromLocalIDTable(LLViewerObject* objectp)
         U32 local_id = objectp->mLocalID;
         U64 indexid = (((U64)objectp->mRegionIndex) << 32) | (U64)local_id;
 
-        std::map<U64, LLUUID>::iterator iter = mIndexAndLocalIDToUUID.find(indexid);
+        index_uuid_map_t::iterator iter = mIndexAndLocalIDToUUID.find(indexid);
         if (iter == mIndexAndLocalIDToUUID.end())
         {
             return false;
@@ -257,6 +259,12 @@ void LLViewerObjectList::processUpdateCore(LLViewerObject* objectp,
     LL_DEBUGS("ObjectUpdate") << "uuid " << objectp->mID << " calling processUpdateMessage "
                               << objectp << " just_created " << just_created << " from_cache " << from_cache << " msg " << msg << LL_ENDL;
 
+    if (msg)
+    {
+        // A newer update supersedes any terse update still waiting in the interest manager
+        LLInterestManager::getInstance()->cancelDeferredUpdate(objectp, msg->getSender(), msg->getCurrentRecvPacketID());
+    }
+
     objectp->processUpdateMessage(msg, user_data, i, update_type, dpp);
 
     if (objectp->isDead())
@@ -719,6 +727,17 @@ void LLViewerObjectList::processObjectUpdate(LLMessageSystem *mesgsys,
             {
                 objectp->mLocalID = local_id;
             }
+            else if (!justCreated
+                     && !mesgsys->getSizeFast(_PREHASH_ObjectData, i, _PREHASH_TextureEntry)
+                     && LLInterestManager::getInstance()->deferTerseUpdate(objectp,
+                                                                           compressed_dpbuffer + compressed_dp.getCurrentSize(),
+                                                                           compressed_dp.getBufferSize() - compressed_dp.getCurrentSize(),
+                                                                           mesgsys->getSender(),
+                                                                           mesgsys->getCurrentRecvPacketID()))
+            {
+                // Low interest object while the viewer is behind, applied later from idle
+                continue;
+            }
             processUpdateCore(objectp, user_data, i, update_type, &compressed_dp, justCreated);
 
 #if 0
@@ -1627,6 +1646,8 @@ void LLViewerObjectList::killAllObjects()
 {
     // Used only on global destruction.
 
+    LLInterestManager::getInstance()->clearDeferredUpdates();
+
     // Mass cleanup to not clear lists one item at a time
     mIndexAndLocalIDToUUID.clear();
     mActiveObjects.clear();
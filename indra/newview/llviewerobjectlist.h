@@ -29,6 +29,7 @@
 
 #include <map>
 #include <set>
+#include <boost/unordered/unordered_flat_map.hpp>
 
 // common includes
 #include "llstring.h"
@@ -223,7 +224,13 @@ protected:
     uuid_multiset_t   mDeadObjects;
     // </FS:Beq>
 
-    std::map<LLUUID, LLPointer<LLViewerObject> > mUUIDObjectMap;
+    // Looked up for every object update block and in render passes: open
+    // addressing maps keep these lookups to one or two cache lines.
+    // Note that inserting may invalidate iterators and references.
+    typedef boost::unordered_flat_map<LLUUID, LLPointer<LLViewerObject> > uuid_object_map_t;
+    typedef boost::unordered_flat_map<U64, LLUUID> index_uuid_map_t;
+
+    uuid_object_map_t mUUIDObjectMap;
 
     //set of objects that need to update their cost
     uuid_set_t   mStaleObjectCost;
@@ -238,9 +245,9 @@ protected:
     S32 mCurLazyUpdateIndex;
 
     static U32 sSimulatorMachineIndex;
-    std::map<U64, U32> mIPAndPortToIndex;
+    boost::unordered_flat_map<U64, U32> mIPAndPortToIndex;
 
-    std::map<U64, LLUUID> mIndexAndLocalIDToUUID;
+    index_uuid_map_t mIndexAndLocalIDToUUID;
 
     friend class LLViewerObject;
 
@@ -1346,6 +1346,9 @@ void LLViewerOctreeCull::traverse(const OctreeNode* n)
     LL_PROFILE_ZONE_SCOPED;
     LLViewerOctreeGroup* group = (LLViewerOctreeGroup*) n->getListener(0);
 
+    S32 batched_res = mBatchedRes;
+    mBatchedRes = -1;
+
     if (earlyFail(group))
     {
         return;
@@ -1360,18 +1363,99 @@ void LLViewerOctreeCull::traverse(const OctreeNode* n)
     else
     {
         LL_PROFILE_ZONE_NAMED_CATEGORY_OCTREE("Check inside?");
-        mRes = frustumCheck(group);
+        mRes = batched_res >= 0 ? frustumCheckBatched(group, batched_res) : frustumCheck(group);
 
-        if (mRes)
-        { //at least partially in, run on down
-            LL_PROFILE_ZONE_NAMED_CATEGORY_OCTREE("PartiallyIn");
+        if (mRes == 2)
+        {
+            LL_PROFILE_ZONE_NAMED_CATEGORY_OCTREE("FullyIn");
             OctreeTraveler::traverse(n);
         }
+        else if (mRes)
+        { //partially in, run on down
+            LL_PROFILE_ZONE_NAMED_CATEGORY_OCTREE("PartiallyIn");
+            traversePartial(n);
+        }
 
         mRes = 0;
     }
 }
 
+//same as OctreeTraveler::traverse(), but the leaf children are frustum checked together up front
+void LLViewerOctreeCull::traversePartial(const OctreeNode* n)
+{
+    n->accept(this);
+
+    S32 child_res[8];
+    batchFrustumCheckLeafChildren(n, child_res);
+
+    for (U32 i = 0; i < n->getChildCount(); i++)
+    {
+        mBatchedRes = child_res[i];
+        traverse(n->getChild(i));
+    }
+    mBatchedRes = -1;
+}
+
+//fill results with the getBatchedCheck() result of each leaf child of n, -1 for other children
+void LLViewerOctreeCull::batchFrustumCheckLeafChildren(const OctreeNode* n, S32* results)
+{
+    const U32 child_count = n->getChildCount();
+    llassert(child_count <= 8);
+
+    for (U32 i = 0; i < child_count; i++)
+    {
+        results[i] = -1;
+    }
+
+    eBatchedCheck check = getBatchedCheck();
+    if (check == BATCH_NONE || child_count < 2)
+    {
+        return;
+    }
+
+    LLVector4a centers[8];
+    LLVector4a radii[8];
+    U32 leaf_index[8];
+    U32 leaf_count = 0;
+    for (U32 i = 0; i < child_count; i++)
+    {
+        const OctreeNode* child = n->getChild(i);
+        if (child->getChildCount() == 0)
+        {
+            const LLViewerOctreeGroup* group = (const LLViewerOctreeGroup*) child->getListener(0);
+            centers[leaf_count] = group->mBounds[0];
+            radii[leaf_count] = group->mBounds[1];
+            leaf_index[leaf_count++] = i;
+        }
+    }
+
+    if (leaf_count < 2)
+    { //nothing to gain
+        return;
+    }
+
+    S32 leaf_res[8];
+    switch (check)
+    {
+    case BATCH_FRUSTUM:
+        mCamera->AABBsInFrustum(centers, radii, leaf_count, leaf_res);
+        break;
+    case BATCH_FRUSTUM_NO_FAR_CLIP:
+        mCamera->AABBsInFrustumNoFarClip(centers, radii, leaf_count, leaf_res);
+        break;
+    case BATCH_REGION_FRUSTUM_NO_FAR_CLIP:
+        mCamera->AABBsInRegionFrustumNoFarClip(centers, radii, leaf_count, leaf_res);
+        break;
+    default:
+        return;
+    }
+
+    for (U32 i = 0; i < leaf_count; i++)
+    {
+        results[leaf_index[i]] = leaf_res[i];
+    }
+}
+
 //------------------------------------------
 //agent space group culling
 S32 LLViewerOctreeCull::AABBInFrustumNoFarClipGroupBounds(const LLViewerOctreeGroup* group)
@@ -370,7 +370,7 @@ class LLViewerOctreeCull : public OctreeTraveler
 {
 public:
     LLViewerOctreeCull(LLCamera* camera)
-        : mCamera(camera), mRes(0) { }
+        : mCamera(camera), mRes(0), mBatchedRes(-1) { }
 
     virtual void traverse(const OctreeNode* n);
 
@@ -400,6 +400,21 @@ protected:
     virtual S32 frustumCheck(const LLViewerOctreeGroup* group) = 0;
     virtual S32 frustumCheckObjects(const LLViewerOctreeGroup* group) = 0;
 
+    //batched frustum check of the leaf children of a partially visible node.
+    //subclasses whose frustumCheck() starts with a camera plane test of the group
+    //bounds return that test here, and finish the check in frustumCheckBatched().
+    enum eBatchedCheck
+    {
+        BATCH_NONE = 0,
+        BATCH_FRUSTUM,
+        BATCH_FRUSTUM_NO_FAR_CLIP,
+        BATCH_REGION_FRUSTUM_NO_FAR_CLIP
+    };
+    virtual eBatchedCheck getBatchedCheck() const { return BATCH_NONE; }
+    virtual S32 frustumCheckBatched(const LLViewerOctreeGroup* group, S32 bounds_res) { return bounds_res; }
+    void batchFrustumCheckLeafChildren(const OctreeNode* n, S32* results);
+    void traversePartial(const OctreeNode* n);
+
     bool checkProjectionArea(const LLVector4a& center, const LLVector4a& size, const LLVector3& shift, F32 pixel_threshold, F32 near_radius);
     virtual bool checkObjects(const OctreeNode* branch, const LLViewerOctreeGroup* group);
     virtual void preprocess(LLViewerOctreeGroup* group);
@@ -409,6 +424,7 @@ protected:
 protected:
     LLCamera *mCamera;
     S32 mRes;
+    S32 mBatchedRes; //result of batchFrustumCheckLeafChildren() for the next traverse(), -1 if none
 };
 
 //scan the octree, output the info of each node for debug use.
@@ -139,7 +139,10 @@ LLTrace::CountStatHandle<>  FPS("FPS", "Frames rendered"),
                             KILLED("killed", "Number of times killed"),
                             TEX_BAKES("texbakes", "Number of times avatar textures have been baked"),
                             TEX_REBAKES("texrebakes", "Number of times avatar textures have been forced to rebake"),
-                            NUM_NEW_OBJECTS("numnewobjectsstat", "Number of objects in scene that were not previously in cache");
+                            NUM_NEW_OBJECTS("numnewobjectsstat", "Number of objects in scene that were not previously in cache"),
+                            TERSE_UPDATES_DEFERRED("terseupdatesdeferred", "Terse object updates deferred for low interest objects while under load"),
+                            TERSE_UPDATES_DROPPED("terseupdatesdropped", "Deferred terse object updates superseded by a newer update"),
+                            IMAGE_REQUESTS_DEFERRED("imagerequestsdeferred", "UDP image requests held back for low priority textures while under load");
 
 LLTrace::CountStatHandle<LLUnit<F64, LLUnits::Kilotriangles> >
                             TRIANGLES_DRAWN("trianglesdrawnstat");
@@ -238,7 +241,8 @@ LLTrace::EventStatHandle<F64Milliseconds >  REGION_CROSSING_TIME("regioncrossing
                                                                 NETWORK_STACKTIME("networkstacktime", "NETWORK_SECS"),
                                                                 IMAGE_STACKTIME("imagestacktime", "IMAGE_SECS"),
                                                                 REBUILD_STACKTIME("rebuildstacktime", "REBUILD_SECS"),
-                                                                RENDER_STACKTIME("renderstacktime", "RENDER_SECS");
+                                                                RENDER_STACKTIME("renderstacktime", "RENDER_SECS"),
+                                                                REBUILD_GROUP_TIME("rebuildgrouptime", "Time to rebuild the geometry of one spatial group");
 
 LLTrace::EventStatHandle<F64Seconds >   AVATAR_EDIT_TIME("avataredittime", "Seconds in Edit Appearance"),
                                                             TOOLBOX_TIME("toolboxtime", "Seconds using Toolbox"),
@@ -4637,6 +4637,7 @@ void LLVOAvatar::slamPosition()
         gPipeline.updateMoveNormalAsync(mDrawable);
     }
     mRoot->updateWorldMatrixChildren();
+    dirtyMatrixPalettes();
 }
 
 bool LLVOAvatar::isVisuallyMuted()
@@ -5746,6 +5747,7 @@ bool LLVOAvatar::updateCharacter(LLAgent &agent)
 
     // Update child joints as needed.
     mRoot->updateWorldMatrixChildren();
+    dirtyMatrixPalettes();
 
     if (visible)
     {
@@ -5854,6 +5856,7 @@ void LLVOAvatar::debugBodySize() const
 void LLVOAvatar::postPelvisSetRecalc()
 {
     mRoot->updateWorldMatrixChildren();
+    dirtyMatrixPalettes();
     computeBodySize();
     dirtyMesh(2);
 }
@@ -8158,6 +8161,7 @@ void LLVOAvatar::updateVisualParams()
         computeBodySize();
         mLastSkeletonSerialNum = mSkeletonSerialNum;
         mRoot->updateWorldMatrixChildren();
+        dirtyMatrixPalettes();
     }
 
     dirtyMesh();
@@ -8968,6 +8972,7 @@ void LLVOAvatar::sitOnObject(LLViewerObject *sit_object)
     // SL-315
     mRoot->setPosition(getPosition());
     mRoot->updateWorldMatrixChildren();
+    dirtyMatrixPalettes();
 
     stopMotion(ANIM_AGENT_BODY_NOISE);
 
@@ -11151,11 +11156,12 @@ const LLVOAvatar::MatrixPaletteCache& LLVOAvatar::updateSkinInfoMatrixPalette(co
     U64 hash = skin->mHash;
     MatrixPaletteCache& entry = mMatrixPaletteCache[hash];
 
-    if (entry.mFrame != gFrameCount)
+    if (entry.mFrame != gFrameCount || entry.mSkeletonGeneration != mSkeletonGeneration)
     {
         LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
 
         entry.mFrame = gFrameCount;
+        entry.mSkeletonGeneration = mSkeletonGeneration;
 
         //build matrix palette
         U32 count = LLSkinningUtil::getMeshJointCount(skin);
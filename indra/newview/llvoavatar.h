@@ -861,6 +861,9 @@ public:
         // Last frame this entry was updated
         U32 mFrame;
 
+        // Skeleton generation (see dirtyMatrixPalettes()) this entry was updated for
+        U32 mSkeletonGeneration;
+
         // List of Matrix4a's for this entry
         LLMeshSkinInfo::matrix_list_t mMatrixPalette;
 
@@ -868,7 +871,8 @@ public:
         std::vector<F32> mGLMp;
 
         MatrixPaletteCache() :
-            mFrame(gFrameCount - 1)
+            mFrame(gFrameCount - 1),
+            mSkeletonGeneration(0)
         {
         }
     };
@@ -882,6 +886,12 @@ public:
     typedef std::unordered_map<U64, MatrixPaletteCache> matrix_palette_cache_t;
     matrix_palette_cache_t mMatrixPaletteCache;
 
+    // Joint world matrices changed, palettes cached this frame are stale.
+    // The CPU side users of the cache (rigged volumes for picking and bounding
+    // boxes) may fill it before the skeleton is updated for the frame.
+    void dirtyMatrixPalettes() { ++mSkeletonGeneration; }
+    U32 mSkeletonGeneration = 0;
+
 protected:
     void            releaseMeshData();
     virtual void restoreMeshData();
@@ -844,13 +844,23 @@ public:
 #if 0
         S32 res = AABBInRegionFrustumGroupBounds(group);
 #else
-        S32 res = AABBInRegionFrustumNoFarClipGroupBounds(group);
+        S32 res = frustumCheckBatched(group, AABBInRegionFrustumNoFarClipGroupBounds(group));
+#endif
+
+        return res;
+    }
+
+    virtual eBatchedCheck getBatchedCheck() const
+    {
+        return BATCH_REGION_FRUSTUM_NO_FAR_CLIP;
+    }
+
+    virtual S32 frustumCheckBatched(const LLViewerOctreeGroup* group, S32 res)
+    {
         if (res != 0)
         {
             res = llmin(res, AABBRegionSphereIntersectGroupExtents(group, mLocalShift));
         }
-#endif
-
         return res;
     }
 
@@ -1981,7 +1981,7 @@ bool LLVOVolume::genBBoxes(bool force_global, bool should_update_octree_bounds)
         // updates needed, set REBUILD_RIGGED accordingly.
 
         // Without the flag, this will remove unused rigged volumes, which we are not currently very aggressive about.
-        updateRiggedVolume(false);
+        updateRiggedVolume(false, LLRiggedVolume::UPDATE_FACE_EXTENTS);
     }
 
     LLVolume* volume = mRiggedVolume;
@@ -2272,7 +2272,7 @@ bool LLVOVolume::updateGeometry(LLDrawable *drawable)
     if (mDrawable->isState(LLDrawable::REBUILD_RIGGED))
     {
         LL_PROFILE_ZONE_NAMED_CATEGORY_VOLUME("rebuild rigged");
-        updateRiggedVolume(false);
+        updateRiggedVolume(false, LLRiggedVolume::UPDATE_FACE_EXTENTS);
         genBBoxes(false);
         mDrawable->clearState(LLDrawable::REBUILD_RIGGED);
     }
@@ -2341,7 +2341,7 @@ bool LLVOVolume::updateGeometry(LLDrawable *drawable)
 
         if(drawable->isState(LLDrawable::REBUILD_RIGGED | LLDrawable::RIGGED))
         {
-            updateRiggedVolume(false);
+            updateRiggedVolume(false, LLRiggedVolume::UPDATE_FACE_EXTENTS);
         }
     }
     // it has its own drawable (it's moved) or it has changed UVs or it has changed xforms from global<->local
@@ -4946,7 +4946,7 @@ bool LLVOVolume::lineSegmentIntersect(const LLVector4a& start, const LLVector4a&
     {
         if ((pick_rigged) || (getAvatar() && (getAvatar()->isSelf()) && (LLFloater::isVisible(gFloaterTools))))
         {
-            updateRiggedVolume(true, LLRiggedVolume::DO_NOT_UPDATE_FACES);
+            updateRiggedVolume(true, LLRiggedVolume::UPDATE_FACE_EXTENTS);
             volume = mRiggedVolume;
             transform = false;
         }
@@ -5026,6 +5026,20 @@ bool LLVOVolume::lineSegmentIntersect(const LLVector4a& start, const LLVector4a&
                 continue;
             }
 
+            if (!transform)
+            { //rigged face extents come from the joint bounds, don't skin faces the segment misses
+                const LLVolumeFace& rigged_face = volume->getVolumeFace(i);
+                LLVector4a box_center;
+                box_center.setAdd(rigged_face.mExtents[0], rigged_face.mExtents[1]);
+                box_center.mul(0.5f);
+                LLVector4a box_size;
+                box_size.setSub(rigged_face.mExtents[1], rigged_face.mExtents[0]);
+                if (!LLLineSegmentBoxIntersect(local_start, local_end, box_center, box_size))
+                {
+                    continue;
+                }
+            }
+
             // This calculates the bounding box of the skinned mesh from scratch. It's actually quite expensive, but not nearly as expensive as building a full octree.
             // rebuild_face_octrees = false because an octree for this face will be built later only if needed for narrow phase picking.
             updateRiggedVolume(true, i, false);
@@ -5234,17 +5248,18 @@ void LLRiggedVolume::update(
     }
 
 
-    //build matrix palette
-    static const size_t kMaxJoints = LL_MAX_JOINTS_PER_MESH_OBJECT;
-
-    LLMatrix4a mat[kMaxJoints];
-    U32 maxJoints = LLSkinningUtil::getMeshJointCount(skin);
-    LLSkinningUtil::initSkinningMatrixPalette(mat, maxJoints, skin, avatar);
-    const LLMatrix4a bind_shape_matrix = skin->mBindShapeMatrix;
+    //matrix palette, shared with rendering and other faces and attachments with the same skin this frame
+    const LLVOAvatar::MatrixPaletteCache& mpc = avatar->updateSkinInfoMatrixPalette(skin);
+    const LLMatrix4a* mat = mpc.mMatrixPalette.data();
+    const U32 palette_count = static_cast<U32>(mpc.mMatrixPalette.size());
 
+    const bool extents_only = face_index == UPDATE_FACE_EXTENTS;
     S32 rigged_vert_count = 0;
+    S32 rigged_box_count = 0;
     S32 rigged_face_count = 0;
     LLVector4a box_min, box_max;
+    box_min.clear();
+    box_max.clear();
     S32 face_begin;
     S32 face_end;
     if (face_index == DO_NOT_UPDATE_FACES)
@@ -5252,7 +5267,7 @@ void LLRiggedVolume::update(
         face_begin = 0;
         face_end = 0;
     }
-    else if (face_index == UPDATE_ALL_FACES)
+    else if (face_index == UPDATE_ALL_FACES || extents_only)
     {
         face_begin = 0;
         face_end = volume->getNumVolumeFaces();
@@ -5276,9 +5291,40 @@ void LLRiggedVolume::update(
 
             LLVector4a* pos = dst_face.mPositions;
 
-            if (pos && dst_face.mExtents)
+            if (pos && dst_face.mExtents && extents_only)
+            {
+                // Transform the box of each joint rather than skinning every
+                // vertex. Picking and the selection outline do a full update
+                // of the faces they need.
+                LLJointVertexBounds& bounds = vol_face.mJointVertexBounds;
+                if (!bounds.isBuilt())
+                {
+                    bounds.build(vol_face.mPositions, weight, vol_face.mNumVertices);
+                }
+
+                if (bounds.getSkinnedExtents(mat, palette_count, skin->mBindShapeMatrix, dst_face.mExtents))
+                {
+                    rigged_box_count += bounds.size();
+                    rigged_face_count++;
+
+                    if (rigged_face_count == 1)
+                    {
+                        box_min = dst_face.mExtents[0];
+                        box_max = dst_face.mExtents[1];
+                    }
+                    box_min.setMin(dst_face.mExtents[0], box_min);
+                    box_max.setMax(dst_face.mExtents[1], box_max);
+
+                    dst_face.mCenter->setAdd(dst_face.mExtents[0], dst_face.mExtents[1]);
+                    dst_face.mCenter->mul(0.5f);
+                }
+
+                // The octree no longer matches the animation, let the next
+                // pick build a new one.
+                dst_face.destroyOctree();
+            }
+            else if (pos && dst_face.mExtents)
             {
-                U32 max_joints = LLSkinningUtil::getMaxJointCount();
                 rigged_vert_count += dst_face.mNumVertices;
                 rigged_face_count++;
 
@@ -5298,7 +5344,7 @@ void LLRiggedVolume::update(
                         LLVector4a& v = vol_face.mPositions[j];
                         LLVector4a t;
                         LLVector4a dst;
-                        bind_shape_matrix.affineTransform(v, t);
+                        skin->mBindShapeMatrix.affineTransform(v, t);
                         final_mat.affineTransform(t, dst);
                         pos[j] = dst;
                     }
@@ -5306,21 +5352,7 @@ void LLRiggedVolume::update(
                 else
             #endif
                 {
-                    for (S32 j = 0; j < dst_face.mNumVertices; ++j)
-                    {
-                        LLMatrix4a final_mat;
-                        // <FS:ND> Use the SSE2 version
-                        // LLSkinningUtil::getPerVertexSkinMatrix(weight[j].getF32ptr(), mat, false, final_mat, max_joints);
-                        FSSkinningUtil::getPerVertexSkinMatrixSSE(weight[j], mat, false, final_mat, max_joints);
-                        // </FS:ND>
-
-                        LLVector4a& v = vol_face.mPositions[j];
-                        LLVector4a t;
-                        LLVector4a dst;
-                        bind_shape_matrix.affineTransform(v, t);
-                        final_mat.affineTransform(t, dst);
-                        pos[j] = dst;
-                    }
+                    LLSkinningUtil::skinPositions(mat, palette_count, skin, vol_face.mPositions, weight, dst_face.mNumVertices, pos);
                 }
 
                 //update bounding box
@@ -5329,8 +5361,8 @@ void LLRiggedVolume::update(
                 LLVector4a& max = dst_face.mExtents[1];
 
                 min = pos[0];
-                max = pos[1];
-                if (i==0)
+                max = pos[0];
+                if (rigged_face_count == 1)
                 {
                     box_min = min;
                     box_max = max;
@@ -5350,7 +5382,7 @@ void LLRiggedVolume::update(
 
             }
 
-            if (rebuild_face_octrees)
+            if (rebuild_face_octrees && !extents_only)
             {
                 dst_face.destroyOctree();
                 // <FS:ND> Create a debug log for octree insertions if requested.
@@ -5369,8 +5401,8 @@ void LLRiggedVolume::update(
             }
         }
     }
-    mExtraDebugText = llformat("rigged %d/%d - box (%f %f %f) (%f %f %f)",
-                               rigged_face_count, rigged_vert_count,
+    mExtraDebugText = llformat("rigged %d/%d/%d - box (%f %f %f) (%f %f %f)",
+                               rigged_face_count, rigged_vert_count, rigged_box_count,
                                box_min[0], box_min[1], box_min[2],
                                box_max[0], box_max[1], box_max[2]);
 }
@@ -5909,6 +5941,8 @@ void LLVolumeGeometryManager::rebuildGeom(LLSpatialGroup* group)
         return;
     }
 
+    LLTimer rebuild_timer;
+
     group->mBuilt = 1.f;
 
     LLSpatialBridge* bridge = group->getSpatialPartition()->asBridge();
@@ -6441,6 +6475,71 @@ void LLVolumeGeometryManager::rebuildGeom(LLSpatialGroup* group)
     group->mLastUpdateTime = gFrameTimeSeconds;
     group->mBuilt = 1.f;
     group->clearState(LLSpatialGroup::GEOM_DIRTY | LLSpatialGroup::ALPHA_DIRTY);
+
+    record(LLStatViewer::REBUILD_GROUP_TIME, F64Seconds(rebuild_timer.getElapsedTimeF64()));
+}
+
+namespace
+{
+    // A deferred LLFace::getGeometryVolume() call. The vertex buffer range of
+    // the face is assigned on the main thread, the job only fills it in.
+    struct GeometryJob
+    {
+        LLFace*             mFace;
+        const LLVolume*     mVolume;
+        const LLMatrix4*    mMatVert;
+        const LLMatrix3*    mMatNorm;
+        U16                 mIndexOffset;
+        bool                mForceRebuild;
+        bool                mNoDebugAssert;
+        bool                mSuccess;
+        // Resolved on the main thread, see LLFace::prepareGeometryJob()
+        LLMaterialPtr       mMaterial;
+    };
+
+    // Batches with fewer vertices than this aren't worth waking up workers for
+    const U32 MIN_PARALLEL_REBUILD_VERTICES = 4096;
+
+    // Run the given jobs, on the geometry rebuild threads if there is enough
+    // work. Returns the number of faces that failed.
+    U32 run_geometry_jobs(std::vector<GeometryJob>& jobs)
+    {
+        LL_PROFILE_ZONE_SCOPED_CATEGORY_VOLUME;
+
+        auto run_job = [&jobs](size_t i)
+        {
+            GeometryJob& job = jobs[i];
+            job.mSuccess = job.mFace->getGeometryVolume(*job.mVolume, job.mFace->getTEOffset(),
+                                                        *job.mMatVert, *job.mMatNorm, job.mIndexOffset,
+                                                        job.mForceRebuild, job.mNoDebugAssert, false, &job.mMaterial);
+        };
+
+        U32 vertex_count = 0;
+        for (const GeometryJob& job : jobs)
+        {
+            vertex_count += job.mFace->getGeomCount();
+        }
+
+        if (jobs.size() > 1 && vertex_count >= MIN_PARALLEL_REBUILD_VERTICES)
+        {
+            gPipeline.runGeometryJobs(jobs.size(), run_job);
+        }
+        else
+        {
+            for (size_t i = 0; i < jobs.size(); ++i)
+            {
+                run_job(i);
+            }
+        }
+
+        U32 failed = 0;
+        for (GeometryJob& job : jobs)
+        {
+            failed += job.mSuccess ? 0 : 1;
+            job.mMaterial = nullptr;
+        }
+        return failed;
+    }
 }
 
 void LLVolumeGeometryManager::rebuildMesh(LLSpatialGroup* group)
@@ -6452,6 +6551,8 @@ void LLVolumeGeometryManager::rebuildMesh(LLSpatialGroup* group)
         {
             LL_PROFILE_ZONE_NAMED_CATEGORY_VOLUME("rebuildMesh - gen draw info");
 
+            LLTimer rebuild_timer;
+
             group->mBuilt = 1.f;
 
             static std::vector<LLVertexBuffer*> locked_buffer;
@@ -6459,6 +6560,16 @@ void LLVolumeGeometryManager::rebuildMesh(LLSpatialGroup* group)
 
             U32 buffer_count = 0;
 
+            // faces of animated children are rebuilt right away, while their
+            // relative transform is forced to identity, the rest is deferred
+            const bool parallel_rebuild = gPipeline.canRebuildGeometryInParallel();
+            static std::vector<GeometryJob> geometry_jobs;
+            static std::vector<LLDrawable*> rebuilt_drawables;
+            geometry_jobs.clear();
+            rebuilt_drawables.clear();
+
+            bool failed = false;
+
             for (LLSpatialGroup::element_iter drawable_iter = group->getDataBegin(); drawable_iter != group->getDataEnd(); ++drawable_iter)
             {
                 LLDrawable* drawablep = (LLDrawable*)(*drawable_iter)->getDrawable();
@@ -6474,7 +6585,8 @@ void LLVolumeGeometryManager::rebuildMesh(LLSpatialGroup* group)
 
                     vobj->preRebuild();
 
-                    if (drawablep->isState(LLDrawable::ANIMATED_CHILD))
+                    const bool animated_child = drawablep->isState(LLDrawable::ANIMATED_CHILD);
+                    if (animated_child)
                     {
                         vobj->updateRelativeXform(true);
                     }
@@ -6489,36 +6601,60 @@ void LLVolumeGeometryManager::rebuildMesh(LLSpatialGroup* group)
                             LLVertexBuffer* buff = face->getVertexBuffer();
                             if (buff)
                             {
-                                if (!face->getGeometryVolume(*volume, // volume
+                                LLMaterialPtr job_material;
+                                if (parallel_rebuild && !animated_child && face->prepareGeometryJob(face->getTEOffset(), job_material))
+                                {
+                                    geometry_jobs.push_back({ face, volume, &vobj->getRelativeXform(), &vobj->getRelativeXformInvTrans(),
+                                                              face->getGeomIndex(), false, true, false, job_material });
+                                }
+                                else if (!face->getGeometryVolume(*volume, // volume
                                     face->getTEOffset(),              // face_index
                                     vobj->getRelativeXform(),         // mat_vert_in
                                     vobj->getRelativeXformInvTrans(), // mat_norm_in
                                     face->getGeomIndex(),             // index_offset
                                     false,                            // force_rebuild
                                     true))                            // no_debug_assert
-                                {   // Something's gone wrong with the vertex buffer accounting,
-                                    // rebuild this group with no debug assert because MESH_DIRTY
-                                    group->dirtyGeom();
-                                    gPipeline.markRebuild(group);
+                                {
+                                    failed = true;
                                 }
                             }
                         }
                     }
 
-                    if (drawablep->isState(LLDrawable::ANIMATED_CHILD))
+                    if (animated_child)
                     {
                         vobj->updateRelativeXform();
                     }
 
-                    drawablep->clearState(LLDrawable::REBUILD_ALL);
+                    rebuilt_drawables.push_back(drawablep);
                 }
             }
 
+            if (run_geometry_jobs(geometry_jobs) > 0)
+            {
+                failed = true;
+            }
+
+            if (failed)
+            {   // Something's gone wrong with the vertex buffer accounting,
+                // rebuild this group with no debug assert because MESH_DIRTY
+                group->dirtyGeom();
+                gPipeline.markRebuild(group);
+            }
+
+            // getGeometryVolume() reads the rebuild flags, clear them once all faces are done
+            for (LLDrawable* drawablep : rebuilt_drawables)
+            {
+                drawablep->clearState(LLDrawable::REBUILD_ALL);
+            }
+
             {
                 LL_PROFILE_ZONE_NAMED_CATEGORY_VOLUME("rebuildMesh - flush");
                 LLVertexBuffer::flushBuffers();
             }
 
+            record(LLStatViewer::REBUILD_GROUP_TIME, F64Seconds(rebuild_timer.getElapsedTimeF64()));
+
             group->clearState(LLSpatialGroup::MESH_DIRTY | LLSpatialGroup::NEW_DRAWINFO);
         }
     }
@@ -6626,6 +6762,9 @@ U32 LLVolumeGeometryManager::genDrawInfo(LLSpatialGroup* group, U32 mask, LLFace
 
     bool flexi = false;
 
+    const bool parallel_rebuild = gPipeline.canRebuildGeometryInParallel();
+    static std::vector<GeometryJob> geometry_jobs;
+
     while (face_iter != end_faces)
     {
         //pull off next face
@@ -6808,6 +6947,9 @@ U32 LLVolumeGeometryManager::genDrawInfo(LLSpatialGroup* group, U32 mask, LLFace
         U32 indices_index = 0;
         U16 index_offset = 0;
 
+        LLFace** batch_begin = face_iter;
+        geometry_jobs.clear();
+
         while (face_iter < i)
         {
             //update face indices for new buffer
@@ -6839,30 +6981,56 @@ U32 LLVolumeGeometryManager::genDrawInfo(LLSpatialGroup* group, U32 mask, LLFace
                     LLVOVolume* vobj = drawablep->getVOVolume();
                     LLVolume* volume = vobj->getVolume();
 
-                    if (drawablep->isState(LLDrawable::ANIMATED_CHILD))
-                    {
-                        vobj->updateRelativeXform(true);
-                    }
-
                     U32 te_idx = facep->getTEOffset();
 
-                    if (!facep->getGeometryVolume(*volume, te_idx,
-                        vobj->getRelativeXform(), vobj->getRelativeXformInvTrans(), index_offset,true))
-                    {
-                        LL_WARNS() << "Failed to get geometry for face!" << LL_ENDL;
+                    LLMaterialPtr job_material;
+                    if (parallel_rebuild && !drawablep->isState(LLDrawable::ANIMATED_CHILD) && facep->prepareGeometryJob(te_idx, job_material))
+                    { //filled in below, possibly on the geometry rebuild threads
+                        geometry_jobs.push_back({ facep, volume, &vobj->getRelativeXform(), &vobj->getRelativeXformInvTrans(),
+                                                  index_offset, true, false, false, job_material });
                     }
-
-                    if (drawablep->isState(LLDrawable::ANIMATED_CHILD))
+                    else
                     {
-                        vobj->updateRelativeXform(false);
+                        if (drawablep->isState(LLDrawable::ANIMATED_CHILD))
+                        {
+                            vobj->updateRelativeXform(true);
+                        }
+
+                        if (!facep->getGeometryVolume(*volume, te_idx,
+                            vobj->getRelativeXform(), vobj->getRelativeXformInvTrans(), index_offset,true))
+                        {
+                            LL_WARNS() << "Failed to get geometry for face!" << LL_ENDL;
+                        }
+
+                        if (drawablep->isState(LLDrawable::ANIMATED_CHILD))
+                        {
+                            vobj->updateRelativeXform(false);
+                        }
                     }
                 }
             }
 
             index_offset += facep->getGeomCount();
             indices_index += facep->getIndicesCount();
+            ++face_iter;
+        }
 
-            //append face to appropriate render batch
+        U32 failed = run_geometry_jobs(geometry_jobs);
+        if (failed > 0)
+        {
+            LL_WARNS() << "Failed to get geometry for " << failed << " face(s)!" << LL_ENDL;
+        }
+
+        //append faces to appropriate render batches, after their geometry is done
+        //since getGeometryVolume() updates face state the passes depend on
+        for (face_iter = batch_begin; face_iter < i; ++face_iter)
+        {
+            facep = *face_iter;
+
+            if (buffer.isNull())
+            {
+                continue;
+            }
 
             bool force_simple = facep->getPixelArea() < FORCE_SIMPLE_RENDER_AREA;
             bool fullbright = facep->isState(LLFace::FULLBRIGHT);
@@ -7207,8 +7375,6 @@ U32 LLVolumeGeometryManager::genDrawInfo(LLSpatialGroup* group, U32 mask, LLFace
                     registerFace(group, facep, LLRenderPass::PASS_GLOW);
                 }
             }
-
-            ++face_iter;
         }
     }
 
@@ -70,6 +70,9 @@ public:
     using FaceIndex = S32;
     static const FaceIndex UPDATE_ALL_FACES = -1;
     static const FaceIndex DO_NOT_UPDATE_FACES = -2;
+    // Update the extents of all faces from the joint bounds of the source
+    // faces, without skinning. Positions and octrees are left stale.
+    static const FaceIndex UPDATE_FACE_EXTENTS = -3;
     void update(
         const LLMeshSkinInfo* skin,
         LLVOAvatar* avatar,
@@ -77,6 +80,9 @@ public:
         FaceIndex face_index = UPDATE_ALL_FACES,
         bool rebuild_face_octrees = true);
 
+    // Every pick skins the faces again first
+    bool usePickBVH() const override { return false; }
+
     std::string mExtraDebugText;
 };
 
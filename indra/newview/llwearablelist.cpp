@@ -51,7 +51,8 @@ struct LLWearableArrivedData
         mUserdata( userdata ),
         mName( wearable_name ),
         mRetries(0),
-        mAvatarp(avatarp)
+        mAvatarp(avatarp),
+        mReportFailure(true)
         {}
 
     LLAssetType::EType mAssetType;
@@ -60,6 +61,7 @@ struct LLWearableArrivedData
     std::string mName;
     S32 mRetries;
     LLAvatarAppearance *mAvatarp;
+    bool mReportFailure;
 };
 
 ////////////////////////////////////////////////////////////////////////////
@@ -95,6 +97,26 @@ void LLWearableList::getAsset(const LLAssetID& assetID, const std::string& weara
     }
 }
 
+void LLWearableList::prefetchAsset(const LLAssetID& assetID, LLAvatarAppearance* avatarp, LLAssetType::EType asset_type, void(*asset_arrived_callback)(LLViewerWearable*, void* userdata), void* userdata)
+{
+    llassert( (asset_type == LLAssetType::AT_CLOTHING) || (asset_type == LLAssetType::AT_BODYPART) );
+    LLViewerWearable* instance = get_if_there(mList, assetID, (LLViewerWearable*)NULL );
+    if( instance )
+    {
+        asset_arrived_callback( instance, userdata );
+    }
+    else
+    {
+        LLWearableArrivedData* data = new LLWearableArrivedData( asset_type, std::string(), avatarp, asset_arrived_callback, userdata );
+        data->mReportFailure = false;
+        gAssetStorage->getAssetData(assetID,
+            asset_type,
+            LLWearableList::processGetAssetReply,
+            (void*)data,
+            true);
+    }
+}
+
 // static
 void LLWearableList::processGetAssetReply( const char* filename, const LLAssetID& uuid, void* userdata, S32 status, LLExtStat ext_status )
 {
@@ -219,7 +241,7 @@ void LLWearableList::processGetAssetReply( const char* filename, const LLAssetID
         LL_DEBUGS("Wearable") << "processGetAssetReply()" << LL_ENDL;
         LL_DEBUGS("Wearable") << wearable << LL_ENDL;
     }
-    else
+    else if (data->mReportFailure)
     {
         LLSD args;
         args["TYPE"] =LLTrans::getString(LLAssetType::lookupHumanReadable(data->mAssetType));
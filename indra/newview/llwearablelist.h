@@ -54,6 +54,14 @@ public:
                                  LLAssetType::EType asset_type,
                                  void(*asset_arrived_callback)(LLViewerWearable*, void* userdata),
                                  void* userdata);
+    // Like getAsset(), for a wearable only needed later: a failure is left
+    // for the getAsset() of that later request to report.
+    void                prefetchAsset(const LLAssetID& assetID,
+                                      LLAvatarAppearance *avatarp,
+                                      LLAssetType::EType asset_type,
+                                      void(*asset_arrived_callback)(LLViewerWearable*, void* userdata),
+                                      void* userdata);
+    bool                isLoaded(const LLAssetID& assetID) const { return mList.find(assetID) != mList.end(); }
 
     LLViewerWearable*           createCopy(const LLViewerWearable* old_wearable, const std::string& new_name = std::string());
     LLViewerWearable*           createNewWearable(LLWearableType::EType type, LLAvatarAppearance *avatarp);
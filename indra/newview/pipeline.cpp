@@ -118,6 +118,9 @@
 #include "llscenemonitor.h"
 #include "llprogressview.h"
 #include "llcleanup.h"
+#include "parallelfor.h"
+#include "threadpool.h"
+#include <latch>
 #include "gltfscenemanager.h"
 // [RLVa:KB] - Checked: RLVa-2.0.0
 #include "llvisualeffect.h"
@@ -368,7 +371,9 @@ bool    LLPipeline::sRenderTextures = true;
 // EventHost API LLPipeline listener.
 static LLPipelineListener sPipelineListener;
 
-static LLCullResult* sCull = NULL;
+// Thread local so that partitions culled on mCullThreadPool each fill their
+// own LLCullResult, see LLPipeline::cullPartitionsParallel().
+static thread_local LLCullResult* sCull = NULL;
 
 void validate_framebuffer_object();
 
@@ -472,6 +477,20 @@ void LLPipeline::init()
     sRenderBeacons = gSavedSettings.getBOOL("renderbeacons");
     sRenderHighlight = gSavedSettings.getBOOL("renderhighlights");
 
+    U32 cull_threads = gSavedSettings.getU32("RenderCullThreads");
+    if (cull_threads > 0 && !mCullThreadPool)
+    {
+        mCullThreadPool.reset(new LL::ThreadPool("Cull", cull_threads));
+        mCullThreadPool->start();
+    }
+
+    U32 geometry_threads = gSavedSettings.getU32("RenderRebuildThreads");
+    if (geometry_threads > 0 && !mGeometryThreadPool)
+    {
+        mGeometryThreadPool.reset(new LL::ThreadPool("GeometryRebuild", geometry_threads));
+        mGeometryThreadPool->start();
+    }
+
     mInitialized = true;
 
     stop_glerror();
@@ -757,6 +776,18 @@ void LLPipeline::cleanup()
 
     mReflectionMapManager.cleanup();
     mHeroProbeManager.cleanup();
+
+    if (mCullThreadPool)
+    {
+        mCullThreadPool->close();
+        mCullThreadPool.reset();
+    }
+    if (mGeometryThreadPool)
+    {
+        mGeometryThreadPool->close();
+        mGeometryThreadPool.reset();
+    }
+    mPartitionCullResults.clear();
 }
 
 //============================================================================
@@ -2625,11 +2656,12 @@ void LLPipeline::updateCull(LLCamera& camera, LLCullResult& result, bool hud_att
 
     sCull->clear();
 
-    for (LLWorld::region_list_t::const_iterator iter = LLWorld::getInstance()->getRegionList().begin();
-            iter != LLWorld::getInstance()->getRegionList().end(); ++iter)
-    {
-        LLViewerRegion* region = *iter;
+    const LLWorld::region_list_t& regions = LLWorld::getInstance()->getRegionList();
 
+    static std::vector<LLSpatialPartition*> partitions;
+    partitions.clear();
+    for (LLViewerRegion* region : regions)
+    {
         for (U32 i = 0; i < LLViewerRegion::NUM_PARTITIONS; i++)
         {
             LLSpatialPartition* part = region->getSpatialPartition(i);
@@ -2637,10 +2669,29 @@ void LLPipeline::updateCull(LLCamera& camera, LLCullResult& result, bool hud_att
             {
                 if (!hud_attachments ? LLViewerRegion::PARTITION_BRIDGE == i || hasRenderType(part->mDrawableType) : hasRenderType(part->mDrawableType))
                 {
-                    part->cull(camera);
+                    partitions.push_back(part);
                 }
             }
         }
+    }
+
+    if (canCullInParallel(partitions.size()))
+    {
+        cullPartitionsParallel(camera, partitions);
+    }
+    else
+    {
+        for (LLSpatialPartition* part : partitions)
+        {
+            part->cull(camera);
+        }
+    }
+
+    // The VO cache culls update per region interest lists and may issue
+    // occlusion queries, they stay on the main thread.
+    for (LLWorld::region_list_t::const_iterator iter = regions.begin(); iter != regions.end(); ++iter)
+    {
+        LLViewerRegion* region = *iter;
 
         //scan the VO Cache tree
         LLVOCachePartition* vo_part = region->getVOCachePartition();
@@ -2672,6 +2723,98 @@ void LLPipeline::updateCull(LLCamera& camera, LLCullResult& result, bool hud_att
     }
 }
 
+bool LLPipeline::canCullInParallel(size_t partition_count) const
+{
+    static LLCachedControl<bool> parallel_cull(gSavedSettings, "RenderParallelCull", true);
+
+    // Occlusion culling reads back GL queries while traversing, which can
+    // only happen on the main thread. The world camera also updates group
+    // distances in markNotCulled(), which queues rebuilds on the pipeline.
+    // Shadow and reflection passes do neither.
+    const bool updates_distance = LLViewerCamera::sCurCameraID == LLViewerCamera::CAMERA_WORLD && !gCubeSnapshot;
+    return parallel_cull
+        && mCullThreadPool
+        && partition_count > 1
+        && !updates_distance
+        && (sUseOcclusion < 2 || sReflectionRender);
+}
+
+void LLPipeline::cullPartitionsParallel(LLCamera& camera, const std::vector<LLSpatialPartition*>& partitions)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_PIPELINE;
+
+    const size_t count = partitions.size();
+    while (mPartitionCullResults.size() < count)
+    {
+        mPartitionCullResults.emplace_back(new LLCullResult());
+    }
+
+    // Outside of the world camera pass, partitions only touch their own
+    // spatial groups while culling, so the only shared state is the
+    // camera, which is read only here. See canCullInParallel().
+    LLCullResult* main_result = sCull;
+    std::atomic<size_t> next_partition(0);
+    auto cull_partitions = [&]()
+    {
+        for (size_t i = next_partition++; i < count; i = next_partition++)
+        {
+            LLCullResult* result = mPartitionCullResults[i].get();
+            result->clear();
+            sCull = result;
+            partitions[i]->cull(camera);
+        }
+        sCull = NULL;
+    };
+
+    const size_t helpers = llmin(mCullThreadPool->getWidth(), count - 1);
+    std::latch done((std::ptrdiff_t)helpers);
+    for (size_t i = 0; i < helpers; ++i)
+    {
+        bool posted = mCullThreadPool->getQueue().post(
+            [&]()
+            {
+                cull_partitions();
+                done.count_down();
+            });
+        if (!posted)
+        {
+            done.count_down();
+        }
+    }
+
+    cull_partitions();
+    done.wait();
+
+    // Merge in partition order so the result is the same as a serial cull.
+    sCull = main_result;
+    for (size_t i = 0; i < count; ++i)
+    {
+        sCull->append(*mPartitionCullResults[i]);
+    }
+}
+
+bool LLPipeline::canRebuildGeometryInParallel() const
+{
+    static LLCachedControl<bool> parallel_rebuild(gSavedSettings, "RenderParallelRebuild", true);
+    return parallel_rebuild && mGeometryThreadPool;
+}
+
+void LLPipeline::runGeometryJobs(size_t count, const std::function<void(size_t)>& func)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_PIPELINE;
+
+    // Without the pool there is no "GeometryRebuild" queue, the calling
+    // thread then runs every job
+    const size_t helpers = mGeometryThreadPool ? mGeometryThreadPool->getWidth() : 0;
+    LL::parallel_for("GeometryRebuild", count,
+                     [&func](size_t i)
+                     {
+                         func(i);
+                         return true;
+                     },
+                     helpers);
+}
+
 void LLPipeline::markNotCulled(LLSpatialGroup* group, LLCamera& camera)
 {
     if (group->isEmpty())
@@ -40,7 +40,10 @@
 #include "llrendertarget.h"
 #include "llreflectionmapmanager.h"
 #include "llheroprobemanager.h"
+#include "threadpool_fwd.h"
 
+#include <atomic>
+#include <functional>
 #include <stack>
 
 class LLViewerTexture;
@@ -275,6 +278,13 @@ public:
     void clearRebuildGroups();
     void clearRebuildDrawables();
 
+    // Geometry rebuild jobs (see LLVolumeGeometryManager). func(i) is called
+    // for every i in [0, count) on mGeometryThreadPool and the calling thread,
+    // see LL::parallel_for(), and runGeometryJobs() returns once all calls
+    // are done.
+    bool canRebuildGeometryInParallel() const;
+    void runGeometryJobs(size_t count, const std::function<void(size_t)>& func);
+
     //calculate pixel area of given box from vantage point of given camera
     static F32 calcPixelArea(LLVector3 center, LLVector3 size, LLCamera& camera);
     static F32 calcPixelArea(const LLVector4a& center, const LLVector4a& size, LLCamera &camera);
@@ -488,6 +498,11 @@ private:
     void unhideDrawable( LLDrawable *pDrawable );
     void skipRenderingShadows();
 
+    // Frustum cull the given partitions on mCullThreadPool and the calling
+    // thread, then append the results to sCull in partition order.
+    void cullPartitionsParallel(LLCamera& camera, const std::vector<LLSpatialPartition*>& partitions);
+    bool canCullInParallel(size_t partition_count) const;
+
     // <FS:Ansariel> Reset VB during TP
     void initDeferredVB();
 
@@ -654,7 +669,7 @@ public:
     bool                     mBackfaceCull;
     S32                      mMatrixOpCount;
     S32                      mTextureMatrixOps;
-    S32                      mNumVisibleNodes;
+    std::atomic<S32>         mNumVisibleNodes;
 
     S32                      mDebugTextureUploadCost;
     S32                      mDebugSculptUploadCost;
@@ -853,6 +868,14 @@ protected:
     LLDrawable::drawable_vector_t mMovedBridge;
     LLDrawable::drawable_vector_t   mShiftList;
 
+    // Workers for updateCull(), plus one cull result per partition so that
+    // each worker fills its own lists. Results are reused frame to frame.
+    std::unique_ptr<LL::ThreadPool>             mCullThreadPool;
+    std::vector<std::unique_ptr<LLCullResult> > mPartitionCullResults;
+
+    // Workers for runGeometryJobs()
+    std::unique_ptr<LL::ThreadPool>             mGeometryThreadPool;
+
     /////////////////////////////////////////////
     //
     //